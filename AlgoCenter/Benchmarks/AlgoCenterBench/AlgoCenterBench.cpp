@@ -0,0 +1,434 @@
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include "glog/logging.h"
+#include "Common/Function.h"
+#include "Protobuf/proxy/AlgoCenter.pb.h"
+
+#include "RedisProtoData/include/RedisProtoData.h"
+#include "Recall/AnnoyRecall/AnnoyIndexCache.h"
+#include "Filter/DownloadSetCache.h"
+#include "Filter/ExposureStore.h"
+#include "Filter/CatalogBitmap.h"
+#include "Replay/ReplayFile.h"
+#include "Replay/RequestRandom.h"
+
+#include "AlgoCenter/Define.h"
+#include "AlgoCenter/Config.h"
+#include "AlgoCenter/AlgoCenter.h"
+#include "AlgoCenter/Application.h"
+#include "AlgoCenter/ItemRank.h"
+#include "AlgoCenter/RequestData.h"
+#include "AlgoCenter/ResponseData.h"
+#include "AlgoCenter/RequestArena.h"
+#include "AlgoCenter/StatisAggregator.h"
+
+#include "FakeRedis.h"
+
+// 离线回放压测: 录制的请求语料 + Redis 快照 + Annoy 样例索引, 进程内多线程驱动 AlgoCenter::GetRecommendItem
+// 1. Redis: 快照加载到进程内 FakeRedis(RESP 协议), 全部 Redis 连接池指向它, 走真实的 TDRedis 读取路径
+// 2. Annoy: 从样例目录加载, 目录结构与 AppConf Annoy.BasicPath 一致
+// 3. 排序: 模型替换为确定性本地打分, 去掉远程排序服务的耗时与波动
+// 4. 输出 QPS、各阶段耗时分位与每请求内存分配次数
+// 用法(在 Bin 目录下运行, 读取 ./config 配置):
+//   AlgoCenterBench <corpus_file> <snapshot_file> <annoy_dir> [threads=8] [requests=20000] [warmup=1000]
+// corpus_file 与 snapshot_file 为回放文件(Replay/ReplayFile.h), 可以是同一个文件, 如线上 Record 录制文件
+// 以回放模式运行, 随机数按请求 uuid 设定种子(Replay/RequestRandom.h), 相同输入多次运行的结果校验和一致
+// 内存分配次数通过 tcmalloc 分配钩子统计, 包含动态库内的分配
+
+// tcmalloc 分配钩子, 声明见 gperftools/malloc_hook_c.h, 服务统一链接 tcmalloc_minimal
+extern "C"
+{
+    typedef void (*MallocHook_NewHook)(const void *ptr, size_t size);
+    int MallocHook_AddNewHook(MallocHook_NewHook hook);
+}
+
+namespace
+{
+    thread_local long t_AllocNum = 0;
+
+    void CountAllocHook(const void *ptr, size_t size)
+    {
+        t_AllocNum++;
+    }
+
+    const std::vector<std::string> StageNameList = {
+        "context", "recall", "feature", "filter", "prerank", "rank", "display", "all"};
+
+    struct CorpusRequest
+    {
+        int cmd = 0;
+        COMM_AlgoCenter::AlgoCenterRequest request;
+    };
+
+    struct WorkerStat
+    {
+        long ok_num = 0;
+        long err_num = 0;
+        std::map<std::string, std::vector<double>> stageCostMs;
+        std::vector<long> vecAllocNum;
+        uint64_t checksum = 0; // 各请求结果哈希之和, 与执行顺序无关
+    };
+
+    uint64_t ResponseHash(const ResponseData &responseData)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (const auto &item_info : responseData.items_list)
+        {
+            hash = (hash ^ static_cast<uint64_t>(item_info.item_id)) * 1099511628211ULL;
+            hash = (hash ^ static_cast<uint64_t>(item_info.res_type)) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // 确定性本地打分: 同一用户与物料分数固定
+    float LocalScore(const RequestData &requestData, const ItemInfo &item_info)
+    {
+        uint64_t x = static_cast<uint64_t>(requestData.user_id) * 0x9E3779B97F4A7C15ULL;
+        x ^= (static_cast<uint64_t>(item_info.item_id) << 8) | static_cast<uint8_t>(item_info.res_type);
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+        return static_cast<float>(x >> 40) / static_cast<float>(1 << 24);
+    }
+
+    bool LoadCorpus(const std::string &corpus_path, std::vector<CorpusRequest> &vecCorpus)
+    {
+        Replay::ReplayReader reader;
+        if (!reader.Open(corpus_path))
+        {
+            return false;
+        }
+
+        Replay::ReplayRecord record;
+        while (reader.Next(record))
+        {
+            if (record.type != Replay::Record_Request)
+            {
+                continue;
+            }
+
+            auto &corpus = vecCorpus.emplace_back();
+            corpus.cmd = record.cmd;
+            if (!corpus.request.ParseFromString(record.value))
+            {
+                std::cerr << "parse request failed, index = " << vecCorpus.size() - 1 << std::endl;
+                vecCorpus.pop_back();
+            }
+        }
+        return !reader.IsError();
+    }
+
+    // 与 Application::Init 一致的请求链路依赖, 不含 gRPC、注册中心、Kafka 与监控
+    bool InitService(int redis_port, const std::string &annoy_dir)
+    {
+        auto conf = Config::GetInstance();
+        if (Config::Error::OK != conf->LoadJson(Common::ConfigPath_App, Common::ConfigPath_AlgoCenter))
+        {
+            std::cerr << "LoadJson error" << std::endl;
+            return false;
+        }
+
+        for (const auto &redis : conf->GetRedisConfig())
+        {
+            for (const auto &redisName : redis.NameList)
+            {
+                if (!RedisProtoData::AddConnectPool(
+                        redisName, "127.0.0.1", redis_port,
+                        false, "", 0, redis.MaxPoolSize))
+                {
+                    std::cerr << "Init Redis Conn Pool Error, redisName = " << redisName << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        if (Common::Error::OK != RedisProtoData::InitCache(Common::ConfigPath_Cache))
+        {
+            std::cerr << "Init RedisProtoData Cache Error" << std::endl;
+            return false;
+        }
+
+        if (conf->GetDownloadFilterCacheSwitch() &&
+            !DownloadSetCache::GetInstance()->Init(
+                conf->GetDownloadFilterCacheCapacity(),
+                conf->GetDownloadFilterCacheTTLMs()))
+        {
+            std::cerr << "Init DownloadSetCache Error" << std::endl;
+            return false;
+        }
+
+        if (conf->GetExposureSwitch() &&
+            !ExposureStore::GetInstance()->Init(
+                conf->GetExposureRingSize(),
+                conf->GetExposureTTLSec(),
+                conf->GetExposureMemoryBudgetMB()))
+        {
+            std::cerr << "Init ExposureStore Error" << std::endl;
+            return false;
+        }
+
+        if (conf->GetCatalogBitmapSwitch() &&
+            !CatalogBitmap::GetInstance()->Init(
+                conf->GetCatalogBitmapRedisName(),
+                conf->GetCatalogBitmapRedisKey(),
+                conf->GetCatalogBitmapSnapshotPath(),
+                conf->GetCatalogBitmapRefreshSec()))
+        {
+            std::cerr << "Init CatalogBitmap Error" << std::endl;
+            return false;
+        }
+
+        if (conf->GetStatisAggregate() &&
+            !StatisAggregator::GetInstance()->Init(
+                conf->GetStatisWindowSec(),
+                conf->GetStatisDiversityPos(),
+                conf->GetStatisDiversityTopItem(),
+                conf->GetStatisLegacyLog()))
+        {
+            std::cerr << "Init StatisAggregator Error" << std::endl;
+            return false;
+        }
+
+        if (!AnnoyIndexCache::GetInstance()->Init(
+                annoy_dir,
+                conf->GetAnnoyEmbDimension(),
+                conf->GetAnnoySearchNodeNum(),
+                conf->GetAnnoyIndexVectorSwitch()))
+        {
+            std::cerr << "Init AnnoyIndexCache Error, annoy_dir = " << annoy_dir << std::endl;
+            return false;
+        }
+
+        // 召回、过滤、展控、阶段预算与粗排配置
+        auto app = Application::GetInstance();
+        app->conf = conf;
+        if (!app->ConfigUpdate())
+        {
+            std::cerr << "ConfigUpdate Error" << std::endl;
+            return false;
+        }
+
+        ItemRank::SetLocalScorer(LocalScore);
+        return true;
+    }
+
+    void Worker(
+        const std::vector<CorpusRequest> &vecCorpus,
+        std::atomic<long> &nextSeq,
+        long warmup,
+        long total,
+        WorkerStat &stat)
+    {
+        auto conf = Config::GetInstance();
+        while (true)
+        {
+            long seq = nextSeq.fetch_add(1, std::memory_order_relaxed);
+            if (seq >= total)
+            {
+                break;
+            }
+            const auto &corpus = vecCorpus[seq % vecCorpus.size()];
+
+            long alloc_start = t_AllocNum;
+            bool ok = false;
+            ResponseData responseData;
+            {
+                RequestData requestData;
+                if (conf->GetRequestArenaSwitch())
+                {
+                    requestData.spArena = RequestArena::Create(conf->GetRequestArenaInitialBlockKB() * 1024);
+                }
+                ok = AlgoCenter::InitRequestData(corpus.cmd, corpus.request, requestData) &&
+                     AlgoCenter::GetRecommendItem(requestData, responseData);
+            }
+            long alloc_num = t_AllocNum - alloc_start;
+
+            if (seq < warmup)
+            {
+                continue;
+            }
+            if (!ok)
+            {
+                stat.err_num++;
+                continue;
+            }
+
+            stat.ok_num++;
+            stat.checksum += ResponseHash(responseData);
+            stat.vecAllocNum.push_back(alloc_num);
+            for (const auto &stage_cost : responseData.vecStageCost)
+            {
+                stat.stageCostMs[stage_cost.first].push_back(stage_cost.second);
+            }
+        }
+    }
+
+    template <typename T>
+    T Percentile(std::vector<T> &vecValue, double p)
+    {
+        if (vecValue.empty())
+        {
+            return T();
+        }
+        std::size_t idx = std::min(vecValue.size() - 1, static_cast<std::size_t>(p * vecValue.size()));
+        std::nth_element(vecValue.begin(), vecValue.begin() + idx, vecValue.end());
+        return vecValue[idx];
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        std::cerr << "usage: " << argv[0]
+                  << " <corpus_file> <snapshot_file> <annoy_dir> [threads=8] [requests=20000] [warmup=1000]" << std::endl;
+        return 1;
+    }
+
+    std::string corpus_path = argv[1];
+    std::string snapshot_path = argv[2];
+    std::string annoy_dir = argv[3];
+    int thread_num = argc > 4 ? std::max(1, atoi(argv[4])) : 8;
+    long request_num = argc > 5 ? std::max(1L, atol(argv[5])) : 20000;
+    long warmup_num = argc > 6 ? std::max(0L, atol(argv[6])) : 1000;
+
+    const std::string log_dir = "../LogAlgoCenterBench";
+    std::string failed_info;
+    if (!Common::MkdirPath(log_dir, 0755, failed_info))
+    {
+        std::cerr << "MkdirPath Failed, info = " << failed_info << std::endl;
+        return 1;
+    }
+    FLAGS_log_dir = log_dir;
+    google::InitGoogleLogging(argv[0]);
+
+    std::vector<CorpusRequest> vecCorpus;
+    if (!LoadCorpus(corpus_path, vecCorpus) || vecCorpus.empty())
+    {
+        std::cerr << "load corpus failed or empty: " << corpus_path << std::endl;
+        return 1;
+    }
+
+    if (!MallocHook_AddNewHook(CountAllocHook))
+    {
+        std::cerr << "add malloc hook failed" << std::endl;
+        return 1;
+    }
+
+    FakeRedis fakeRedis;
+    if (!fakeRedis.Load(snapshot_path) || !fakeRedis.Start())
+    {
+        std::cerr << "start fake redis failed, snapshot: " << snapshot_path << std::endl;
+        return 1;
+    }
+
+    if (!InitService(fakeRedis.GetPort(), annoy_dir))
+    {
+        return 1;
+    }
+    RequestRandom::SetReplayMode(true);
+
+    long init_command = fakeRedis.GetCommandCount();
+    long init_miss = fakeRedis.GetMissCount();
+
+    std::atomic<long> nextSeq = 0;
+    std::vector<WorkerStat> vecStat(thread_num);
+    std::vector<std::thread> vecThread;
+
+    // 预热请求不计入统计, 以全部线程完成预热后的时间点作为计时起点近似
+    auto start = std::chrono::steady_clock::now();
+    for (int idx = 0; idx < thread_num; idx++)
+    {
+        vecThread.emplace_back(Worker, std::cref(vecCorpus), std::ref(nextSeq),
+                               warmup_num, warmup_num + request_num, std::ref(vecStat[idx]));
+    }
+    while (nextSeq.load(std::memory_order_relaxed) < warmup_num)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    auto measure_start = std::chrono::steady_clock::now();
+    for (auto &thread : vecThread)
+    {
+        thread.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    long ok_num = 0;
+    long err_num = 0;
+    uint64_t checksum = 0;
+    std::map<std::string, std::vector<double>> stageCostMs;
+    std::vector<long> vecAllocNum;
+    for (auto &stat : vecStat)
+    {
+        ok_num += stat.ok_num;
+        err_num += stat.err_num;
+        checksum += stat.checksum;
+        for (auto &kv : stat.stageCostMs)
+        {
+            auto &vecCost = stageCostMs[kv.first];
+            vecCost.insert(vecCost.end(), kv.second.begin(), kv.second.end());
+        }
+        vecAllocNum.insert(vecAllocNum.end(), stat.vecAllocNum.begin(), stat.vecAllocNum.end());
+    }
+
+    double elapsed_sec = std::chrono::duration<double>(end - measure_start).count();
+    double alloc_avg = 0.0;
+    for (long alloc_num : vecAllocNum)
+    {
+        alloc_avg += alloc_num;
+    }
+    alloc_avg = vecAllocNum.empty() ? 0.0 : alloc_avg / vecAllocNum.size();
+
+    std::cout << "AlgoCenterBench threads = " << thread_num
+              << ", requests = " << request_num
+              << ", warmup = " << warmup_num
+              << ", corpus = " << vecCorpus.size()
+              << ", redis keys = " << fakeRedis.GetKeyNum()
+              << ", setup = " << std::chrono::duration<double>(measure_start - start).count() << "s" << std::endl;
+    std::cout << "  qps = " << (elapsed_sec > 0 ? (ok_num + err_num) / elapsed_sec : 0.0)
+              << ", ok = " << ok_num
+              << ", err = " << err_num
+              << ", elapsed = " << elapsed_sec << "s" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  stage(ms)       p50       p90       p99      p999       max" << std::endl;
+    for (const auto &stage_name : StageNameList)
+    {
+        auto iter = stageCostMs.find(stage_name);
+        if (iter == stageCostMs.end())
+        {
+            continue;
+        }
+        auto &vecCost = iter->second;
+        std::cout << "  " << std::left << std::setw(10) << stage_name << std::right
+                  << std::setw(10) << Percentile(vecCost, 0.50)
+                  << std::setw(10) << Percentile(vecCost, 0.90)
+                  << std::setw(10) << Percentile(vecCost, 0.99)
+                  << std::setw(10) << Percentile(vecCost, 0.999)
+                  << std::setw(10) << *std::max_element(vecCost.begin(), vecCost.end()) << std::endl;
+    }
+    std::cout << std::setprecision(1);
+    std::cout << "  allocs/request avg = " << alloc_avg
+              << ", p50 = " << Percentile(vecAllocNum, 0.50)
+              << ", p99 = " << Percentile(vecAllocNum, 0.99) << std::endl;
+    std::cout << "  fake redis command = " << fakeRedis.GetCommandCount() - init_command
+              << ", miss = " << fakeRedis.GetMissCount() - init_miss << std::endl;
+    std::cout << "  response checksum = " << std::hex << checksum << std::dec << std::endl;
+
+    // 先停止缓存刷新与连接池, 再关闭 FakeRedis
+    Application::GetInstance()->Shutdown();
+    fakeRedis.Stop();
+    google::ShutdownGoogleLogging();
+    return 0;
+}
@@ -0,0 +1,640 @@
+#include "FakeRedis.h"
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fnmatch.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "glog/logging.h"
+#include "Replay/ReplayFile.h"
+
+// 单条命令参数上限, 超出视为协议错误
+static const long s_MaxArgNum = 1024 * 1024;
+static const long s_MaxBulkBytes = 512L * 1024 * 1024;
+
+static void AppendStatus(const char *status, std::string &reply)
+{
+    reply.push_back('+');
+    reply.append(status);
+    reply.append("\r\n");
+}
+
+static void AppendError(const std::string &error, std::string &reply)
+{
+    reply.push_back('-');
+    reply.append(error);
+    reply.append("\r\n");
+}
+
+static void AppendInteger(long value, std::string &reply)
+{
+    reply.push_back(':');
+    reply.append(std::to_string(value));
+    reply.append("\r\n");
+}
+
+static void AppendArrayHeader(std::size_t num, std::string &reply)
+{
+    reply.push_back('*');
+    reply.append(std::to_string(num));
+    reply.append("\r\n");
+}
+
+static void AppendNil(std::string &reply)
+{
+    reply.append("$-1\r\n");
+}
+
+static void AppendBulk(const std::string &value, std::string &reply)
+{
+    reply.push_back('$');
+    reply.append(std::to_string(value.size()));
+    reply.append("\r\n");
+    reply.append(value);
+    reply.append("\r\n");
+}
+
+static bool MatchPattern(const std::string &pattern, const std::string &value)
+{
+    return pattern.empty() || fnmatch(pattern.c_str(), value.c_str(), 0) == 0;
+}
+
+// 解析一条命令: 1 成功, 0 数据不完整, -1 协议错误
+static int ParseCommand(const std::string &buf, std::size_t &pos, std::vector<std::string> &argv)
+{
+    argv.clear();
+    if (pos >= buf.size())
+    {
+        return 0;
+    }
+
+    std::size_t line_end = buf.find("\r\n", pos);
+    if (line_end == std::string::npos)
+    {
+        return 0;
+    }
+
+    // inline 命令, 如 redis-cli 手工调试
+    if (buf[pos] != '*')
+    {
+        std::size_t cur = pos;
+        while (cur < line_end)
+        {
+            std::size_t space = buf.find(' ', cur);
+            if (space == std::string::npos || space > line_end)
+            {
+                space = line_end;
+            }
+            if (space > cur)
+            {
+                argv.emplace_back(buf, cur, space - cur);
+            }
+            cur = space + 1;
+        }
+        pos = line_end + 2;
+        return 1;
+    }
+
+    long arg_num = strtol(buf.c_str() + pos + 1, nullptr, 10);
+    if (arg_num <= 0 || arg_num > s_MaxArgNum)
+    {
+        return -1;
+    }
+
+    std::size_t cur = line_end + 2;
+    for (long idx = 0; idx < arg_num; idx++)
+    {
+        if (cur >= buf.size())
+        {
+            return 0;
+        }
+        if (buf[cur] != '$')
+        {
+            return -1;
+        }
+
+        line_end = buf.find("\r\n", cur);
+        if (line_end == std::string::npos)
+        {
+            return 0;
+        }
+
+        long len = strtol(buf.c_str() + cur + 1, nullptr, 10);
+        if (len < 0 || len > s_MaxBulkBytes)
+        {
+            return -1;
+        }
+
+        cur = line_end + 2;
+        if (buf.size() < cur + len + 2)
+        {
+            return 0;
+        }
+        argv.emplace_back(buf, cur, len);
+        cur += len + 2;
+    }
+
+    pos = cur;
+    return 1;
+}
+
+bool FakeRedis::Load(const std::string &snapshot_path)
+{
+    Replay::ReplayReader reader;
+    if (!reader.Open(snapshot_path))
+    {
+        return false;
+    }
+
+    long string_num = 0;
+    long hash_field_num = 0;
+    Replay::ReplayRecord record;
+    while (reader.Next(record))
+    {
+        switch (record.type)
+        {
+        case Replay::Record_RedisString:
+        {
+            m_String[record.key] = std::move(record.value);
+            string_num++;
+            break;
+        }
+        case Replay::Record_RedisHash:
+        {
+            auto &hashData = m_Hash[record.key];
+            auto iter = hashData.fieldIndex.find(record.field);
+            if (iter != hashData.fieldIndex.end())
+            {
+                hashData.vecFieldValue[iter->second].second = std::move(record.value);
+            }
+            else
+            {
+                hashData.fieldIndex.emplace(record.field, hashData.vecFieldValue.size());
+                hashData.vecFieldValue.emplace_back(std::move(record.field), std::move(record.value));
+            }
+            hash_field_num++;
+            break;
+        }
+        default:
+        {
+            break;
+        }
+        }
+    }
+
+    if (reader.IsError())
+    {
+        LOG(ERROR) << "FakeRedis::Load() snapshot format error, snapshot_path = " << snapshot_path;
+        return false;
+    }
+
+    m_vecKeys.clear();
+    m_vecKeys.reserve(m_String.size() + m_Hash.size());
+    for (const auto &kv : m_String)
+    {
+        m_vecKeys.push_back(kv.first);
+    }
+    for (const auto &kv : m_Hash)
+    {
+        m_vecKeys.push_back(kv.first);
+    }
+    std::sort(m_vecKeys.begin(), m_vecKeys.end());
+    m_vecKeys.erase(std::unique(m_vecKeys.begin(), m_vecKeys.end()), m_vecKeys.end());
+
+    LOG(INFO) << "FakeRedis::Load() succ"
+              << ", snapshot_path = " << snapshot_path
+              << ", string_num = " << string_num
+              << ", hash_field_num = " << hash_field_num
+              << ", key_num = " << m_vecKeys.size();
+    return true;
+}
+
+bool FakeRedis::Start()
+{
+    if (m_Running)
+    {
+        return true;
+    }
+
+    m_ListenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_ListenFd < 0)
+    {
+        LOG(ERROR) << "FakeRedis::Start() socket failed";
+        return false;
+    }
+
+    int on = 1;
+    setsockopt(m_ListenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t addr_len = sizeof(addr);
+    if (bind(m_ListenFd, (sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(m_ListenFd, 128) != 0 ||
+        getsockname(m_ListenFd, (sockaddr *)&addr, &addr_len) != 0)
+    {
+        LOG(ERROR) << "FakeRedis::Start() bind or listen failed";
+        close(m_ListenFd);
+        m_ListenFd = -1;
+        return false;
+    }
+    m_Port = ntohs(addr.sin_port);
+
+    m_Running = true;
+    m_AcceptThread = std::thread(&FakeRedis::AcceptThread, this);
+
+    LOG(INFO) << "FakeRedis::Start() succ, port = " << m_Port;
+    return true;
+}
+
+void FakeRedis::Stop()
+{
+    if (!m_Running)
+    {
+        return;
+    }
+    m_Running = false;
+
+    // 唤醒阻塞中的 accept 与 recv
+    shutdown(m_ListenFd, SHUT_RDWR);
+    {
+        std::lock_guard<std::mutex> lg(m_SessionMutex);
+        for (int fd : m_vecSessionFd)
+        {
+            shutdown(fd, SHUT_RDWR);
+        }
+    }
+
+    if (m_AcceptThread.joinable())
+    {
+        m_AcceptThread.join();
+    }
+    close(m_ListenFd);
+    m_ListenFd = -1;
+
+    // accept 线程已退出, 会话线程列表不再变化
+    for (auto &thread : m_vecSessionThread)
+    {
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    m_vecSessionThread.clear();
+
+    LOG(INFO) << "FakeRedis::Stop()"
+              << ", command = " << GetCommandCount()
+              << ", miss = " << GetMissCount();
+}
+
+void FakeRedis::AcceptThread()
+{
+    while (m_Running)
+    {
+        int fd = accept(m_ListenFd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            if (m_Running && errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+        std::lock_guard<std::mutex> lg(m_SessionMutex);
+        if (!m_Running)
+        {
+            close(fd);
+            break;
+        }
+        m_vecSessionFd.push_back(fd);
+        m_vecSessionThread.emplace_back(&FakeRedis::SessionThread, this, fd);
+    }
+}
+
+void FakeRedis::SessionThread(int fd)
+{
+    std::string inBuf;
+    std::string outBuf;
+    std::vector<std::string> argv;
+    char buf[16384];
+
+    bool keep = true;
+    while (keep)
+    {
+        ssize_t recv_len = recv(fd, buf, sizeof(buf), 0);
+        if (recv_len <= 0)
+        {
+            break;
+        }
+        inBuf.append(buf, recv_len);
+
+        // 流水线请求逐条执行, 应答按顺序合并发送
+        std::size_t pos = 0;
+        while (keep)
+        {
+            int ret = ParseCommand(inBuf, pos, argv);
+            if (ret == 0)
+            {
+                break;
+            }
+            if (ret < 0)
+            {
+                AppendError("ERR Protocol error", outBuf);
+                keep = false;
+                break;
+            }
+            if (!argv.empty())
+            {
+                keep = Execute(argv, outBuf);
+            }
+        }
+        inBuf.erase(0, pos);
+
+        std::size_t sent = 0;
+        while (sent < outBuf.size())
+        {
+            ssize_t send_len = send(fd, outBuf.data() + sent, outBuf.size() - sent, MSG_NOSIGNAL);
+            if (send_len <= 0)
+            {
+                keep = false;
+                break;
+            }
+            sent += send_len;
+        }
+        outBuf.clear();
+    }
+
+    std::lock_guard<std::mutex> lg(m_SessionMutex);
+    m_vecSessionFd.erase(std::remove(m_vecSessionFd.begin(), m_vecSessionFd.end(), fd), m_vecSessionFd.end());
+    close(fd);
+}
+
+const std::string *FakeRedis::FindString(const std::string &key) const
+{
+    auto iter = m_String.find(key);
+    if (iter == m_String.end())
+    {
+        m_MissCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return &iter->second;
+}
+
+const std::string *FakeRedis::FindHashField(const std::string &key, const std::string &field) const
+{
+    auto iter = m_Hash.find(key);
+    if (iter != m_Hash.end())
+    {
+        auto fieldIter = iter->second.fieldIndex.find(field);
+        if (fieldIter != iter->second.fieldIndex.end())
+        {
+            return &iter->second.vecFieldValue[fieldIter->second].second;
+        }
+    }
+    m_MissCount.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+bool FakeRedis::ParseScanOption(
+    const std::vector<std::string> &argv,
+    std::size_t start,
+    std::string &pattern,
+    long &count)
+{
+    pattern.clear();
+    count = 10;
+    for (std::size_t idx = start; idx < argv.size(); idx += 2)
+    {
+        if (idx + 1 >= argv.size())
+        {
+            return false;
+        }
+
+        std::string option = argv[idx];
+        std::transform(option.begin(), option.end(), option.begin(), ::toupper);
+        if (option == "MATCH")
+        {
+            pattern = (argv[idx + 1] == "*") ? "" : argv[idx + 1];
+        }
+        else if (option == "COUNT")
+        {
+            count = std::max(1L, strtol(argv[idx + 1].c_str(), nullptr, 10));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FakeRedis::Execute(const std::vector<std::string> &argv, std::string &reply)
+{
+    m_CommandCount.fetch_add(1, std::memory_order_relaxed);
+
+    std::string cmd = argv[0];
+    std::transform(cmd.begin(), cmd.end(), cmd.begin(), ::toupper);
+    const std::size_t argc = argv.size();
+
+    auto lambda_arg_error = [&cmd, &reply]() -> bool
+    {
+        AppendError("ERR wrong number of arguments for '" + cmd + "' command", reply);
+        return true;
+    };
+
+    if (cmd == "PING")
+    {
+        if (argc > 1)
+        {
+            AppendBulk(argv[1], reply);
+        }
+        else
+        {
+            AppendStatus("PONG", reply);
+        }
+    }
+    else if (cmd == "AUTH" || cmd == "SELECT" || cmd == "CLIENT" || cmd == "READONLY")
+    {
+        AppendStatus("OK", reply);
+    }
+    else if (cmd == "QUIT")
+    {
+        AppendStatus("OK", reply);
+        return false;
+    }
+    else if (cmd == "ECHO")
+    {
+        if (argc != 2)
+        {
+            return lambda_arg_error();
+        }
+        AppendBulk(argv[1], reply);
+    }
+    else if (cmd == "DBSIZE")
+    {
+        AppendInteger((long)m_vecKeys.size(), reply);
+    }
+    else if (cmd == "GET")
+    {
+        if (argc != 2)
+        {
+            return lambda_arg_error();
+        }
+        const std::string *pValue = FindString(argv[1]);
+        pValue != nullptr ? AppendBulk(*pValue, reply) : AppendNil(reply);
+    }
+    else if (cmd == "MGET")
+    {
+        if (argc < 2)
+        {
+            return lambda_arg_error();
+        }
+        AppendArrayHeader(argc - 1, reply);
+        for (std::size_t idx = 1; idx < argc; idx++)
+        {
+            const std::string *pValue = FindString(argv[idx]);
+            pValue != nullptr ? AppendBulk(*pValue, reply) : AppendNil(reply);
+        }
+    }
+    else if (cmd == "HGET")
+    {
+        if (argc != 3)
+        {
+            return lambda_arg_error();
+        }
+        const std::string *pValue = FindHashField(argv[1], argv[2]);
+        pValue != nullptr ? AppendBulk(*pValue, reply) : AppendNil(reply);
+    }
+    else if (cmd == "HMGET")
+    {
+        if (argc < 3)
+        {
+            return lambda_arg_error();
+        }
+        AppendArrayHeader(argc - 2, reply);
+        for (std::size_t idx = 2; idx < argc; idx++)
+        {
+            const std::string *pValue = FindHashField(argv[1], argv[idx]);
+            pValue != nullptr ? AppendBulk(*pValue, reply) : AppendNil(reply);
+        }
+    }
+    else if (cmd == "HGETALL")
+    {
+        if (argc != 2)
+        {
+            return lambda_arg_error();
+        }
+        auto iter = m_Hash.find(argv[1]);
+        if (iter == m_Hash.end())
+        {
+            AppendArrayHeader(0, reply);
+        }
+        else
+        {
+            AppendArrayHeader(iter->second.vecFieldValue.size() * 2, reply);
+            for (const auto &fieldValue : iter->second.vecFieldValue)
+            {
+                AppendBulk(fieldValue.first, reply);
+                AppendBulk(fieldValue.second, reply);
+            }
+        }
+    }
+    else if (cmd == "EXISTS")
+    {
+        if (argc < 2)
+        {
+            return lambda_arg_error();
+        }
+        long num = 0;
+        for (std::size_t idx = 1; idx < argc; idx++)
+        {
+            num += (m_String.count(argv[idx]) + m_Hash.count(argv[idx])) > 0 ? 1 : 0;
+        }
+        AppendInteger(num, reply);
+    }
+    else if (cmd == "TYPE")
+    {
+        if (argc != 2)
+        {
+            return lambda_arg_error();
+        }
+        AppendStatus(m_String.count(argv[1]) ? "string" : (m_Hash.count(argv[1]) ? "hash" : "none"), reply);
+    }
+    else if (cmd == "SCAN")
+    {
+        std::string pattern;
+        long count = 0;
+        if (argc < 2 || !ParseScanOption(argv, 2, pattern, count))
+        {
+            AppendError("ERR syntax error", reply);
+            return true;
+        }
+
+        std::size_t idx = std::max(0L, strtol(argv[1].c_str(), nullptr, 10));
+        std::vector<const std::string *> vecMatch;
+        for (long scanned = 0; idx < m_vecKeys.size() && scanned < count; idx++, scanned++)
+        {
+            if (MatchPattern(pattern, m_vecKeys[idx]))
+            {
+                vecMatch.push_back(&m_vecKeys[idx]);
+            }
+        }
+
+        AppendArrayHeader(2, reply);
+        AppendBulk(idx < m_vecKeys.size() ? std::to_string(idx) : "0", reply);
+        AppendArrayHeader(vecMatch.size(), reply);
+        for (const auto *pKey : vecMatch)
+        {
+            AppendBulk(*pKey, reply);
+        }
+    }
+    else if (cmd == "HSCAN")
+    {
+        std::string pattern;
+        long count = 0;
+        if (argc < 3 || !ParseScanOption(argv, 3, pattern, count))
+        {
+            AppendError("ERR syntax error", reply);
+            return true;
+        }
+
+        static const std::vector<std::pair<std::string, std::string>> s_Empty;
+        auto iter = m_Hash.find(argv[1]);
+        const auto &vecFieldValue = (iter != m_Hash.end()) ? iter->second.vecFieldValue : s_Empty;
+
+        std::size_t idx = std::max(0L, strtol(argv[2].c_str(), nullptr, 10));
+        std::vector<const std::pair<std::string, std::string> *> vecMatch;
+        for (long scanned = 0; idx < vecFieldValue.size() && scanned < count; idx++, scanned++)
+        {
+            if (MatchPattern(pattern, vecFieldValue[idx].first))
+            {
+                vecMatch.push_back(&vecFieldValue[idx]);
+            }
+        }
+
+        AppendArrayHeader(2, reply);
+        AppendBulk(idx < vecFieldValue.size() ? std::to_string(idx) : "0", reply);
+        AppendArrayHeader(vecMatch.size() * 2, reply);
+        for (const auto *pFieldValue : vecMatch)
+        {
+            AppendBulk(pFieldValue->first, reply);
+            AppendBulk(pFieldValue->second, reply);
+        }
+    }
+    else
+    {
+        AppendError("ERR unknown command '" + argv[0] + "'", reply);
+    }
+
+    return true;
+}
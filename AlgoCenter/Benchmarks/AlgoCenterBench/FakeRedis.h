@@ -0,0 +1,71 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+// 进程内只读 Redis, 数据来自回放文件中的 Redis 记录
+// 监听本地端口并实现 RESP 协议, 服务中的 TDRedis 连接池直接连接, 不修改线上读取代码
+// 支持: PING AUTH SELECT CLIENT ECHO QUIT GET MGET HGET HMGET HGETALL EXISTS TYPE DBSIZE SCAN HSCAN
+class FakeRedis
+{
+public:
+    FakeRedis() = default;
+    ~FakeRedis() { Stop(); }
+    FakeRedis(const FakeRedis &) = delete;
+    FakeRedis &operator=(const FakeRedis &) = delete;
+
+    // 加载快照, 需在 Start() 之前调用
+    bool Load(const std::string &snapshot_path);
+
+    // 监听 127.0.0.1 随机端口
+    bool Start();
+    void Stop();
+
+    inline int GetPort() const noexcept { return m_Port; }
+    inline long GetKeyNum() const noexcept { return (long)m_vecKeys.size(); }
+    inline long GetCommandCount() const noexcept { return m_CommandCount.load(std::memory_order_relaxed); }
+    inline long GetMissCount() const noexcept { return m_MissCount.load(std::memory_order_relaxed); }
+
+private:
+    struct HashData
+    {
+        std::unordered_map<std::string, std::size_t> fieldIndex;
+        std::vector<std::pair<std::string, std::string>> vecFieldValue; // 插入顺序, 供 HSCAN 游标遍历
+    };
+
+    void AcceptThread();
+    void SessionThread(int fd);
+
+    // 执行一条命令, 返回 false 表示关闭连接
+    bool Execute(const std::vector<std::string> &argv, std::string &reply);
+
+    // 解析 SCAN/HSCAN 的 MATCH 与 COUNT 参数
+    static bool ParseScanOption(
+        const std::vector<std::string> &argv,
+        std::size_t start,
+        std::string &pattern,
+        long &count);
+
+    const std::string *FindString(const std::string &key) const;
+    const std::string *FindHashField(const std::string &key, const std::string &field) const;
+
+private:
+    std::unordered_map<std::string, std::string> m_String;
+    std::unordered_map<std::string, HashData> m_Hash;
+    std::vector<std::string> m_vecKeys; // 全部键, 排序后供 SCAN 游标遍历
+
+    int m_ListenFd = -1;
+    int m_Port = 0;
+    std::atomic<bool> m_Running = false;
+    std::thread m_AcceptThread;
+
+    std::mutex m_SessionMutex;
+    std::vector<int> m_vecSessionFd;
+    std::vector<std::thread> m_vecSessionThread;
+
+    std::atomic<long> m_CommandCount = 0;
+    mutable std::atomic<long> m_MissCount = 0;
+};
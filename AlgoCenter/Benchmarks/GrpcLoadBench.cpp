@@ -0,0 +1,174 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+#include "grpcpp/grpcpp.h"
+#include "grpcpp/generic/generic_stub.h"
+
+// gRPC 压测: 固定并发下持续发送同一请求, 统计 QPS 与延迟分位
+// 请求体为已序列化的服务请求(二进制文件), 通过 GenericStub 发送, 不依赖具体服务定义
+// 用法: GrpcLoadBench <addr> <method> <request_file> [concurrency=64] [duration_sec=30]
+// 例如: GrpcLoadBench 127.0.0.1:9090 /GrpcProtos.Service/Call ./request.bin 256 60
+// 对比同步模式不同线程配置时, 依次修改 AppConf GrpcServer 后重启服务再运行
+
+namespace
+{
+    struct WorkerStat
+    {
+        long ok_num = 0;
+        long err_num = 0;
+        std::vector<double> vecLatencyMs;
+    };
+
+    void Worker(
+        std::shared_ptr<grpc::Channel> channel,
+        const std::string &method,
+        const grpc::ByteBuffer &request,
+        int inflight,
+        std::chrono::steady_clock::time_point deadline,
+        WorkerStat &stat)
+    {
+        struct Call
+        {
+            grpc::ClientContext context;
+            grpc::ByteBuffer response;
+            grpc::Status status;
+            std::chrono::steady_clock::time_point start;
+            std::unique_ptr<grpc::GenericClientAsyncResponseReader> reader;
+        };
+
+        grpc::GenericStub stub(channel);
+        grpc::CompletionQueue cq;
+
+        auto lambda_start = [&](Call *call) -> void
+        {
+            call->start = std::chrono::steady_clock::now();
+            call->reader = stub.PrepareUnaryCall(&call->context, method, request, &cq);
+            call->reader->StartCall();
+            call->reader->Finish(&call->response, &call->status, call);
+        };
+
+        for (int idx = 0; idx < inflight; idx++)
+        {
+            lambda_start(new Call());
+        }
+
+        int pending = inflight;
+        void *tag = nullptr;
+        bool ok = false;
+        while (pending > 0 && cq.Next(&tag, &ok))
+        {
+            Call *call = static_cast<Call *>(tag);
+            auto now = std::chrono::steady_clock::now();
+            if (ok && call->status.ok())
+            {
+                stat.ok_num++;
+                stat.vecLatencyMs.push_back(std::chrono::duration<double, std::milli>(now - call->start).count());
+            }
+            else
+            {
+                stat.err_num++;
+            }
+            delete call;
+            pending--;
+
+            if (now < deadline)
+            {
+                lambda_start(new Call());
+                pending++;
+            }
+        }
+        cq.Shutdown();
+        while (cq.Next(&tag, &ok))
+        {
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        std::cerr << "usage: " << argv[0] << " <addr> <method> <request_file> [concurrency=64] [duration_sec=30]" << std::endl;
+        return 1;
+    }
+
+    std::string addr = argv[1];
+    std::string method = argv[2];
+    int concurrency = argc > 4 ? std::max(1, atoi(argv[4])) : 64;
+    int duration_sec = argc > 5 ? std::max(1, atoi(argv[5])) : 30;
+
+    std::ifstream ifs(argv[3], std::ios::binary);
+    if (!ifs.is_open())
+    {
+        std::cerr << "open request file failed: " << argv[3] << std::endl;
+        return 1;
+    }
+    std::stringstream buffer;
+    buffer << ifs.rdbuf();
+    std::string request_data = buffer.str();
+
+    grpc::Slice slice(request_data);
+    grpc::ByteBuffer request(&slice, 1);
+
+    // 每个线程一个连接与完成队列, 线程内多路在途请求
+    int thread_num = std::min<int>(concurrency, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<WorkerStat> vecStat(thread_num);
+    std::vector<std::thread> vecThread;
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + std::chrono::seconds(duration_sec);
+    for (int idx = 0; idx < thread_num; idx++)
+    {
+        int inflight = concurrency / thread_num + (idx < concurrency % thread_num ? 1 : 0);
+        grpc::ChannelArguments args;
+        args.SetInt("grpc.channel_id", idx); // 避免共享子通道
+        auto channel = grpc::CreateCustomChannel(addr, grpc::InsecureChannelCredentials(), args);
+        vecThread.emplace_back(Worker, channel, method, std::cref(request), inflight, deadline, std::ref(vecStat[idx]));
+    }
+    for (auto &t : vecThread)
+    {
+        t.join();
+    }
+    double elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long ok_num = 0;
+    long err_num = 0;
+    std::vector<double> vecLatencyMs;
+    for (auto &stat : vecStat)
+    {
+        ok_num += stat.ok_num;
+        err_num += stat.err_num;
+        vecLatencyMs.insert(vecLatencyMs.end(), stat.vecLatencyMs.begin(), stat.vecLatencyMs.end());
+    }
+    std::sort(vecLatencyMs.begin(), vecLatencyMs.end());
+
+    auto lambda_percentile = [&vecLatencyMs](double p) -> double
+    {
+        if (vecLatencyMs.empty())
+        {
+            return 0.0;
+        }
+        size_t idx = std::min(vecLatencyMs.size() - 1, static_cast<size_t>(p * vecLatencyMs.size()));
+        return vecLatencyMs[idx];
+    };
+
+    std::cout << "GrpcLoadBench addr = " << addr
+              << ", method = " << method
+              << ", concurrency = " << concurrency
+              << ", threads = " << thread_num
+              << ", duration = " << elapsed_sec << "s" << std::endl;
+    std::cout << "  ok = " << ok_num << ", err = " << err_num
+              << ", qps = " << ok_num / elapsed_sec << std::endl;
+    std::cout << "  p50 = " << lambda_percentile(0.50) << "ms"
+              << ", p90 = " << lambda_percentile(0.90) << "ms"
+              << ", p99 = " << lambda_percentile(0.99) << "ms"
+              << ", p999 = " << lambda_percentile(0.999) << "ms" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Recall/Recall.h"
+#include "Recall/ItemIdSet.h"
+#include "AlgoCenter/ResponseData.h"
+
+// 召回融合微基准: 10 渠道 x 500 物料, 对比旧实现(unordered_set + 拷贝)与当前实现
+
+namespace
+{
+    const int ChannelNum = 10;
+    const int ChannelItemNum = 500;
+    const int AllMergeNum = 1500;
+    const int LoopNum = 2000;
+
+    using RecallTypeItemList = std::unordered_map<std::string, std::vector<ItemInfo>>;
+
+    // 旧实现, 作为对照
+    void LegacyItemMerge(
+        const int allMergeNum,
+        const std::vector<RecallParam> &vecRecallParams,
+        const RecallTypeItemList &recallTypeItemList,
+        std::unordered_set<long> &recallMergeSet,
+        std::vector<ItemInfo> &resultItemList)
+    {
+        std::size_t useAllMergeNum = static_cast<std::size_t>(allMergeNum);
+        std::unordered_map<std::string, std::size_t> recallTypeMergeNum;
+        for (int round = 0; round < 2; round++)
+        {
+            for (const auto &mergeParams : vecRecallParams)
+            {
+                auto recallType = mergeParams.GetRecallType();
+                auto iter = recallTypeItemList.find(recallType);
+                if (iter == recallTypeItemList.end())
+                {
+                    continue;
+                }
+
+                std::size_t mergeLimitNum = (round == 0) ? mergeParams.GetMergeMinNum() : mergeParams.GetMergeMaxNum();
+                for (auto &item_info : iter->second)
+                {
+                    if (recallMergeSet.size() >= useAllMergeNum)
+                    {
+                        return;
+                    }
+                    if (recallTypeMergeNum[recallType] >= mergeLimitNum)
+                    {
+                        break;
+                    }
+                    if (recallMergeSet.find(item_info.item_id) == recallMergeSet.end())
+                    {
+                        recallMergeSet.insert(item_info.item_id);
+                        resultItemList.emplace_back(item_info);
+                        ++recallTypeMergeNum[recallType];
+                    }
+                }
+            }
+        }
+    }
+
+    void BuildInput(std::vector<RecallParam> &vecRecallParams, RecallTypeItemList &recallTypeItemList)
+    {
+        std::mt19937 rng(20230622);
+        std::uniform_int_distribution<long> dist(1, ChannelNum * ChannelItemNum / 2);
+        for (int channel = 0; channel < ChannelNum; channel++)
+        {
+            std::string recallType = "Channel_" + std::to_string(channel);
+
+            RecallParam param;
+            param.Set("recallType", recallType);
+            param.Set("mergeMinNum", 50L);
+            param.Set("mergeMaxNum", 300L);
+            vecRecallParams.push_back(param);
+
+            auto &vecItemList = recallTypeItemList[recallType];
+            for (int idx = 0; idx < ChannelItemNum; idx++)
+            {
+                vecItemList.emplace_back(dist(rng), 1, channel, 0.0f, 0.0f);
+            }
+        }
+    }
+}
+
+int main()
+{
+    std::vector<RecallParam> vecRecallParams;
+    RecallTypeItemList recallTypeItemList;
+    BuildInput(vecRecallParams, recallTypeItemList);
+
+    // 结果一致性校验
+    {
+        std::unordered_set<long> legacySet;
+        std::vector<ItemInfo> legacyResult;
+        LegacyItemMerge(AllMergeNum, vecRecallParams, recallTypeItemList, legacySet, legacyResult);
+
+        auto input = recallTypeItemList;
+        ItemIdSet mergeSet(AllMergeNum);
+        std::vector<ItemInfo> result;
+        Recall::ItemMerge(AllMergeNum, vecRecallParams, input, mergeSet, result);
+
+        bool same = legacyResult.size() == result.size();
+        for (std::size_t idx = 0; same && idx < result.size(); idx++)
+        {
+            same = legacyResult[idx].item_id == result[idx].item_id &&
+                   legacyResult[idx].recall_type_id == result[idx].recall_type_id;
+        }
+        if (!same)
+        {
+            std::cerr << "ItemMergeBench result mismatch"
+                      << ", legacy size = " << legacyResult.size()
+                      << ", size = " << result.size() << std::endl;
+            return 1;
+        }
+    }
+
+    // 输入拷贝不计入耗时
+    std::vector<RecallTypeItemList> vecInput(LoopNum, recallTypeItemList);
+    auto start = std::chrono::steady_clock::now();
+    std::size_t checksum = 0;
+    for (int loop = 0; loop < LoopNum; loop++)
+    {
+        std::unordered_set<long> legacySet;
+        std::vector<ItemInfo> legacyResult;
+        LegacyItemMerge(AllMergeNum, vecRecallParams, vecInput[loop], legacySet, legacyResult);
+        checksum += legacyResult.size();
+    }
+    auto legacy_end = std::chrono::steady_clock::now();
+    for (int loop = 0; loop < LoopNum; loop++)
+    {
+        ItemIdSet mergeSet(AllMergeNum);
+        std::vector<ItemInfo> result;
+        Recall::ItemMerge(AllMergeNum, vecRecallParams, vecInput[loop], mergeSet, result);
+        checksum += result.size();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto legacy_us = std::chrono::duration_cast<std::chrono::microseconds>(legacy_end - start).count();
+    auto merge_us = std::chrono::duration_cast<std::chrono::microseconds>(end - legacy_end).count();
+    std::cout << "ItemMergeBench channels = " << ChannelNum
+              << ", items per channel = " << ChannelItemNum
+              << ", loops = " << LoopNum
+              << ", checksum = " << checksum << std::endl;
+    std::cout << "  legacy : " << static_cast<double>(legacy_us) / LoopNum << " us/op" << std::endl;
+    std::cout << "  current: " << static_cast<double>(merge_us) / LoopNum << " us/op" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <unistd.h>
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+
+#include "Common/Function.h"
+#include "Recall/AnnoyRecall/AnnoyIndexCache.h"
+
+#include "MicroBench.h"
+
+// 向量召回算子: AnnoyRetrieval
+// 启动时在临时目录生成索引, 目录结构与线上一致: <basic>/<version>/res_type_<x>/{annoy_index, item_vector, keyname_vector}
+
+namespace
+{
+    const int ItemNum = 20000;
+    const int KeynameNum = 500;
+    const size_t EmbDimension = 64; // 与 AppConf.json 默认配置一致
+    const int SearchNodeNum = 256;
+    const int TreeNum = 10;
+    const int ResType = 1;
+
+    std::string s_BasicPath;
+    bool s_Init = false;
+
+    bool WriteFile(const std::string &file_path, const std::string &data)
+    {
+        std::ofstream ofs(file_path, std::ios::binary | std::ios::trunc);
+        ofs.write(data.data(), data.size());
+        return ofs.good();
+    }
+
+    std::vector<float> RandomVector(std::mt19937 &rng)
+    {
+        std::normal_distribution<float> dist(0.0f, 1.0f);
+        std::vector<float> vec(EmbDimension);
+        for (auto &value : vec)
+        {
+            value = dist(rng);
+        }
+        return vec;
+    }
+
+    bool BuildFixture(const std::string &slice_path)
+    {
+        std::mt19937 rng(MicroBench::RandomSeed);
+
+        AnnoyIndex<int, float, Angular, Kiss32Random, AnnoyIndexMultiThreadedBuildPolicy> annoy_index(EmbDimension);
+        RSP_LocalFileData::FileData item_file;
+        for (int item_pos = 0; item_pos < ItemNum; item_pos++)
+        {
+            auto vec = RandomVector(rng);
+            annoy_index.add_item(item_pos, vec.data());
+
+            RSP_AnnoyFileData::AnnoyItemVector aiv;
+            aiv.set_item_id(100000 + item_pos);
+            aiv.set_res_type(ResType);
+            aiv.set_item_pos(item_pos);
+            for (float value : vec)
+            {
+                aiv.add_vector_data(value);
+            }
+            item_file.add_protos(aiv.SerializeAsString());
+        }
+        annoy_index.build(TreeNum);
+        if (!annoy_index.save((slice_path + "/annoy_index").c_str()))
+        {
+            return false;
+        }
+
+        RSP_LocalFileData::FileData keyname_file;
+        for (int keyname = 0; keyname < KeynameNum; keyname++)
+        {
+            RSP_AnnoyFileData::AnnoyKeynameVector akv;
+            akv.set_keyname(std::to_string(keyname));
+            for (float value : RandomVector(rng))
+            {
+                akv.add_vector_data(value);
+            }
+            keyname_file.add_protos(akv.SerializeAsString());
+        }
+
+        return WriteFile(slice_path + "/item_vector", item_file.SerializeAsString()) &&
+               WriteFile(slice_path + "/keyname_vector", keyname_file.SerializeAsString());
+    }
+
+    // 参数: top_k, 查询方式(0 物料自身向量, 1 关键词均值向量)
+    void BM_AnnoyRetrieval(benchmark::State &state)
+    {
+        std::string slice;
+        std::string item_key;
+        if (!MicroBench::InitAnnoyFixture(slice, item_key))
+        {
+            state.SkipWithError("init annoy fixture failed");
+            return;
+        }
+
+        const int top_k = state.range(0);
+        std::vector<std::string> vec_keynames;
+        if (state.range(1) == 1)
+        {
+            item_key = "0_" + std::to_string(ResType); // 不存在的物料, 走关键词均值向量
+            for (int keyname = 0; keyname < 8; keyname++)
+            {
+                vec_keynames.push_back(std::to_string(keyname * 7));
+            }
+        }
+
+        auto cache = AnnoyIndexCache::GetInstance();
+        for (auto _ : state)
+        {
+            std::vector<std::string> vec_near_items;
+            std::vector<float> vec_distances;
+            int err = cache->AnnoyRetrieval(slice, item_key, vec_keynames, top_k, vec_near_items, vec_distances);
+            benchmark::DoNotOptimize(err);
+            benchmark::DoNotOptimize(vec_near_items.data());
+        }
+    }
+    BENCHMARK(BM_AnnoyRetrieval)
+        ->ArgsProduct({{50, 200}, {0, 1}})
+        ->Unit(benchmark::kMicrosecond);
+}
+
+namespace MicroBench
+{
+    bool InitAnnoyFixture(std::string &slice, std::string &item_key)
+    {
+        slice = "res_type_" + std::to_string(ResType);
+        item_key = std::to_string(100000 + ItemNum / 2) + "_" + std::to_string(ResType);
+
+        static const bool s_Succ = []() -> bool
+        {
+            // 版本号需早于当前时间 600s 才会被加载
+            s_BasicPath = (std::filesystem::temp_directory_path() / ("MicroBench_annoy_" + std::to_string(getpid()))).string();
+            std::string version = std::to_string(Common::get_timestamp() - 3600);
+            std::string slice_path = s_BasicPath + "/" + version + "/res_type_" + std::to_string(ResType);
+
+            std::error_code ec;
+            std::filesystem::create_directories(slice_path, ec);
+            if (ec || !BuildFixture(slice_path))
+            {
+                LOG(ERROR) << "InitAnnoyFixture() build fixture failed, slice_path = " << slice_path;
+                return false;
+            }
+
+            s_Init = AnnoyIndexCache::GetInstance()->Init(s_BasicPath, EmbDimension, SearchNodeNum, false);
+            return s_Init;
+        }();
+        return s_Succ;
+    }
+
+    void ShutdownAnnoyFixture()
+    {
+        if (s_Init)
+        {
+            AnnoyIndexCache::GetInstance()->ShutDown();
+            s_Init = false;
+        }
+        if (!s_BasicPath.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(s_BasicPath, ec);
+        }
+    }
+}
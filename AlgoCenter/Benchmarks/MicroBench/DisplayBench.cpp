@@ -0,0 +1,77 @@
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+#include "Display/DisplayType.h"
+#include "Display/DisplayConfig.h"
+#include "Display/ScattersStrategy.h"
+#include "Recall/RecallType.hpp"
+#include "AlgoCenter/RequestData.h"
+#include "AlgoCenter/ResponseData.h"
+
+#include "MicroBench.h"
+
+// 展控算子: 打散
+
+namespace
+{
+    const long PageSize = 20;
+
+    SecondaryParam MakeScattersParam(const std::string &elementList, const std::string &controlMethod, long controlCount)
+    {
+        SecondaryParam secondaryParam;
+        secondaryParam.Set("ElementList", elementList);
+        secondaryParam.Set("ControlMethod", controlMethod);
+        secondaryParam.Set("ControlCount", controlCount);
+        return secondaryParam;
+    }
+
+    // 参数: 展示物料数量, 全部页参与打散
+    void BM_ScattersStrategy(benchmark::State &state)
+    {
+        static const std::vector<std::string> vecRecallType = {
+            "ResType_Hot", "ResType_Quality", "ResType_Surge", "ResType_CTCVR", "ResType_DLR",
+            "ResType_User_CF", "Item_CF", "Item_Annoy", "ClickOccur", "DownloadOccur"};
+        const int itemNum = state.range(0);
+
+        DisplayParam displayParam;
+        displayParam.Set("PageSize", PageSize);
+        displayParam.Set("TopNPage", static_cast<long>((itemNum + PageSize - 1) / PageSize));
+        auto &scattersParam = displayParam.GetSecondaryParamData("Scatters");
+        scattersParam.vecSecondaryParam.push_back(MakeScattersParam("ResType_Hot,ResType_Surge", Common::ControlMethod_NotMoreThan, 4L));
+        scattersParam.vecSecondaryParam.push_back(MakeScattersParam("Item_CF,Item_Annoy", Common::ControlMethod_NotMoreThan, 6L));
+        scattersParam.vecSecondaryParam.push_back(MakeScattersParam("ResType_User_CF", Common::ControlMethod_NotLessThan, 2L));
+
+        // 召回类型分布倾斜, 使打散需要跨页调整
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::discrete_distribution<int> recallTypeDist({30, 5, 10, 5, 5, 2, 20, 15, 4, 4});
+        std::vector<ItemInfo> vecItem;
+        vecItem.reserve(itemNum);
+        for (int idx = 0; idx < itemNum; idx++)
+        {
+            int recallTypeId = Common::GetRecallTypeID(vecRecallType[recallTypeDist(rng)]);
+            vecItem.emplace_back(100000 + idx, 1, recallTypeId, static_cast<float>(itemNum - idx), 0.0f);
+        }
+
+        RequestData requestData;
+        auto scatters = ScattersStrategy::GetInstance();
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            ResponseData responseData;
+            responseData.items_list = vecItem;
+            state.ResumeTiming();
+
+            int err = scatters->CallStrategy(requestData, displayParam, responseData);
+            benchmark::DoNotOptimize(err);
+            benchmark::DoNotOptimize(responseData.items_list.data());
+        }
+        state.SetItemsProcessed(state.iterations() * itemNum);
+    }
+    BENCHMARK(BM_ScattersStrategy)
+        ->Arg(100)
+        ->Arg(1000)
+        ->Arg(10000)
+        ->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,200 @@
+#include <memory>
+#include <random>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+#include "Common/Function.h"
+#include "Protobuf/redis/user_feature_data.pb.h"
+#include "Protobuf/redis/user_live_feature_data.pb.h"
+#include "Protobuf/redis/item_feature_data.pb.h"
+#include "Feature/AnalyseFeature.hpp"
+
+#include "MicroBench.h"
+
+// 特征解析算子: 用户特征, 实时行为序列, 物料特征
+
+namespace
+{
+    const int DisplayItemNum = 1000;
+    const int ContextResType = 1;
+
+    // 行为序列填充到 ContextResType 下, 时间戳分布在最近 2 天, 约一半在 86400s 有效期内
+    template <typename ItemMap>
+    void FillIDTime(ItemMap *item_map, int num)
+    {
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::uniform_int_distribution<long> offset(0, 2 * 86400);
+        long now_time = Common::get_timestamp();
+
+        auto &id_time_list = (*item_map)[ContextResType];
+        for (int idx = 0; idx < num; idx++)
+        {
+            auto id_time = id_time_list.add_id_list();
+            id_time->set_id(100000 + idx);
+            id_time->set_timestamp(now_time - offset(rng));
+        }
+    }
+
+    std::vector<std::shared_ptr<RSP_ItemFeatureData::ItemFeatureBasic>> BuildItemFeatureBasic()
+    {
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::vector<std::shared_ptr<RSP_ItemFeatureData::ItemFeatureBasic>> vecItem;
+        vecItem.reserve(DisplayItemNum);
+        for (int idx = 0; idx < DisplayItemNum; idx++)
+        {
+            auto ifb = std::make_shared<RSP_ItemFeatureData::ItemFeatureBasic>();
+            ifb->set_ll_id(100000 + idx);
+            ifb->set_res_type(ContextResType);
+            ifb->set_class_id(rng() % 200);
+            ifb->set_res_price(rng() % 300);
+            ifb->set_up_time(rng() % 1500);
+            ifb->set_user_id(rng() % 1000000);
+            for (int keyname = 0; keyname < 8; keyname++)
+            {
+                ifb->add_keyname_list(rng() % 5000);
+            }
+            vecItem.push_back(ifb);
+        }
+        return vecItem;
+    }
+
+    std::vector<std::shared_ptr<RSP_ItemFeatureData::ItemFeatureStatis>> BuildItemFeatureStatis()
+    {
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::uniform_real_distribution<float> ctr(0.0f, 0.06f);
+        std::vector<std::shared_ptr<RSP_ItemFeatureData::ItemFeatureStatis>> vecItem;
+        vecItem.reserve(DisplayItemNum);
+        for (int idx = 0; idx < DisplayItemNum; idx++)
+        {
+            auto ifs = std::make_shared<RSP_ItemFeatureData::ItemFeatureStatis>();
+            ifs->set_click_14_days(rng() % 30);
+            ifs->set_click_30_days(rng() % 60);
+            ifs->set_ctr_14_days(ctr(rng));
+            ifs->set_ctr_30_days(ctr(rng));
+            ifs->set_download_14_days(rng() % 12);
+            ifs->set_download_30_days(rng() % 24);
+            vecItem.push_back(ifs);
+        }
+        return vecItem;
+    }
+
+    void BM_AnalyseUserFeatureBasic(benchmark::State &state)
+    {
+        auto ufb = std::make_shared<RSP_UserFeatureData::UserFeatureBasic>();
+        ufb->set_user_id(123456789);
+        ufb->set_user_sex(1);
+        ufb->set_user_province_code(44);
+        ufb->set_user_city_code(4403);
+        ufb->set_user_lb(200);
+        ufb->set_growth_value(5000);
+        ufb->set_is_vip(1);
+
+        for (auto _ : state)
+        {
+            TDPredict::FeatureItem feature_item;
+            AnalyseFeature::AnalyseUserFeatureBasic(ufb, feature_item);
+            benchmark::DoNotOptimize(feature_item);
+        }
+    }
+    BENCHMARK(BM_AnalyseUserFeatureBasic);
+
+    // 参数: 行为序列长度
+    void BM_AnalyseUserLiveFeatureClick(benchmark::State &state)
+    {
+        auto ulfc = std::make_shared<RSP_UserLiveFeatureData::UserLiveFeatureClick>();
+        FillIDTime(ulfc->mutable_click_item(), state.range(0));
+        for (auto _ : state)
+        {
+            TDPredict::FeatureItem feature_item;
+            AnalyseFeature::AnalyseUserLiveFeatureClick(ContextResType, ulfc, feature_item);
+            benchmark::DoNotOptimize(feature_item);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_AnalyseUserLiveFeatureClick)
+        ->RangeMultiplier(10)
+        ->Range(100, 100000)
+        ->Unit(benchmark::kMicrosecond);
+
+    void BM_AnalyseUserLiveFeatureSearch(benchmark::State &state)
+    {
+        auto ulfs = std::make_shared<RSP_UserLiveFeatureData::UserLiveFeatureSearch>();
+        FillIDTime(ulfs->mutable_search_words(), state.range(0));
+        for (auto _ : state)
+        {
+            TDPredict::FeatureItem feature_item;
+            AnalyseFeature::AnalyseUserLiveFeatureSearch(ContextResType, ulfs, feature_item);
+            benchmark::DoNotOptimize(feature_item);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_AnalyseUserLiveFeatureSearch)
+        ->RangeMultiplier(10)
+        ->Range(100, 100000)
+        ->Unit(benchmark::kMicrosecond);
+
+    void BM_AnalyseUserLiveFeatureDownload(benchmark::State &state)
+    {
+        auto ulfd = std::make_shared<RSP_UserLiveFeatureData::UserLiveFeatureDownload>();
+        FillIDTime(ulfd->mutable_download_item(), state.range(0));
+        for (auto _ : state)
+        {
+            TDPredict::FeatureItem feature_item;
+            AnalyseFeature::AnalyseUserLiveFeatureDownload(ContextResType, ulfd, feature_item);
+            benchmark::DoNotOptimize(feature_item);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_AnalyseUserLiveFeatureDownload)
+        ->RangeMultiplier(10)
+        ->Range(100, 100000)
+        ->Unit(benchmark::kMicrosecond);
+
+    // 1000 个展示物料逐个解析
+    void BM_AnalyseItemFeatureBasic(benchmark::State &state)
+    {
+        const auto vecItem = BuildItemFeatureBasic();
+        for (auto _ : state)
+        {
+            for (const auto &ifb : vecItem)
+            {
+                TDPredict::FeatureItem feature_item;
+                AnalyseFeature::AnalyseItemFeatureBasic(ifb, feature_item);
+                benchmark::DoNotOptimize(feature_item);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * DisplayItemNum);
+    }
+    BENCHMARK(BM_AnalyseItemFeatureBasic)->Unit(benchmark::kMicrosecond);
+
+    void BM_AnalyseItemFeatureStatis(benchmark::State &state)
+    {
+        const auto vecItem = BuildItemFeatureStatis();
+        for (auto _ : state)
+        {
+            for (const auto &ifs : vecItem)
+            {
+                TDPredict::FeatureItem feature_item;
+                AnalyseFeature::AnalyseItemFeatureStatis(ifs, feature_item);
+                benchmark::DoNotOptimize(feature_item);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * DisplayItemNum);
+    }
+    BENCHMARK(BM_AnalyseItemFeatureStatis)->Unit(benchmark::kMicrosecond);
+
+    // 上下文物料特征, 每次请求解析一次
+    void BM_AnalyseContextFeatureItem(benchmark::State &state)
+    {
+        const auto ifb = BuildItemFeatureBasic().front();
+        const auto ifs = BuildItemFeatureStatis().front();
+        for (auto _ : state)
+        {
+            TDPredict::FeatureItem feature_item;
+            AnalyseFeature::AnalyseContextFeatureItemBasic(ifb, feature_item);
+            AnalyseFeature::AnalyseContextFeatureItemStatis(ifs, feature_item);
+            benchmark::DoNotOptimize(feature_item);
+        }
+    }
+    BENCHMARK(BM_AnalyseContextFeatureItem);
+}
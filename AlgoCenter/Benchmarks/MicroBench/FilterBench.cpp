@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+#include "Common/Error.h"
+#include "Filter/DownloadSetCache.h"
+#include "Filter/DownloadFilter.h"
+#include "Filter/FilterConfig.h"
+#include "AlgoCenter/RequestData.h"
+#include "AlgoCenter/ResponseData.h"
+
+#include "MicroBench.h"
+
+// 过滤算子: 已下载过滤
+// DownloadFilter::InitPredicate 的下载集合来自 Redis 用户特征, 这里由下载历史构建 UserDownloadSet 后预先写入
+// DownloadSetCache, 再调用线上 DownloadFilter 取得谓词(缓存命中分支), 过滤 1000 个展示物料
+
+namespace
+{
+    const int DisplayItemNum = 1000;
+    const int ResType = 1;
+    const long ValidityTime = 604800;
+
+    std::vector<uint64_t> BuildDownloadKeys(int history_num)
+    {
+        std::vector<uint64_t> keys;
+        keys.reserve(history_num);
+        for (int idx = 0; idx < history_num; idx++)
+        {
+            // 历史下载 ID 稀疏分布在展示物料 ID 范围两倍的区间内
+            keys.push_back(UserDownloadSet::MakeKey(100000 + idx * 2, ResType));
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(MicroBench::RandomSeed));
+        return keys;
+    }
+
+    // 参数: 下载历史数量
+    void BM_DownloadSetBuild(benchmark::State &state)
+    {
+        const auto keys = BuildDownloadKeys(state.range(0));
+        for (auto _ : state)
+        {
+            auto input = keys;
+            auto spDownloadSet = std::make_shared<UserDownloadSet>();
+            spDownloadSet->Build(std::move(input));
+            benchmark::DoNotOptimize(spDownloadSet->Size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_DownloadSetBuild)
+        ->RangeMultiplier(10)
+        ->Range(100, 100000)
+        ->Unit(benchmark::kMicrosecond);
+
+    // 参数: 下载历史数量; 过滤 1000 个展示物料
+    void BM_DownloadFilterPredicate(benchmark::State &state)
+    {
+        auto cache = DownloadSetCache::GetInstance();
+        if (!cache->IsInit() && !cache->Init(1024, 3600 * 1000))
+        {
+            state.SkipWithError("DownloadSetCache Init failed");
+            return;
+        }
+
+        // 每个参数使用不同的用户, 缓存互不覆盖
+        RequestData requestData;
+        requestData.user_id = 10000 + state.range(0);
+        requestData.context_res_type = ResType;
+
+        FilterParam filterParam;
+        filterParam.Set("FilterType", std::string("Download"));
+        filterParam.Set("ValidityTime", ValidityTime);
+
+        auto spDownloadSet = std::make_shared<UserDownloadSet>();
+        spDownloadSet->Build(BuildDownloadKeys(state.range(0)));
+
+        // 与 DownloadFilter::InitPredicate 的缓存键一致
+        DownloadSetCache::CacheKey cache_key;
+        cache_key.user_id = requestData.user_id;
+        cache_key.res_type = requestData.context_res_type;
+        cache_key.validity_time = filterParam.GetValidityTime();
+        cache->Put(cache_key, spDownloadSet);
+
+        FilterPredicate predicate;
+        int err = DownloadFilter::GetInstance()->InitPredicate(requestData, filterParam, predicate);
+        if (err != Common::Error::OK || !predicate)
+        {
+            state.SkipWithError("DownloadFilter InitPredicate failed");
+            return;
+        }
+
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::uniform_int_distribution<long> dist(100000, 100000 + 2L * state.range(0));
+        std::vector<ItemInfo> vecItem;
+        vecItem.reserve(DisplayItemNum);
+        for (int idx = 0; idx < DisplayItemNum; idx++)
+        {
+            vecItem.emplace_back(dist(rng), ResType, 0, 0.0f, 0.0f);
+        }
+
+        for (auto _ : state)
+        {
+            int filterNum = 0;
+            for (const auto &item_info : vecItem)
+            {
+                filterNum += predicate(item_info) ? 1 : 0;
+            }
+            benchmark::DoNotOptimize(filterNum);
+        }
+        state.SetItemsProcessed(state.iterations() * DisplayItemNum);
+    }
+    BENCHMARK(BM_DownloadFilterPredicate)
+        ->RangeMultiplier(10)
+        ->Range(100, 100000);
+}
@@ -0,0 +1,21 @@
+# 构建时读取当前提交, 写入 MicroBenchGitCommit.h
+# 参数: SOURCE_DIR 仓库目录, OUTPUT_FILE 生成的头文件
+# 内容不变时不重写, 避免每次构建都重新编译 main.cpp
+execute_process(
+  COMMAND git rev-parse --short HEAD
+  WORKING_DIRECTORY ${SOURCE_DIR}
+  OUTPUT_VARIABLE MICROBENCH_GIT_COMMIT
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET)
+
+if(NOT MICROBENCH_GIT_COMMIT)
+  set(MICROBENCH_GIT_COMMIT "unknown")
+endif()
+
+set(CONTENT "#pragma once\n#define MICROBENCH_GIT_COMMIT \"${MICROBENCH_GIT_COMMIT}\"\n")
+if(EXISTS ${OUTPUT_FILE})
+  file(READ ${OUTPUT_FILE} OLD_CONTENT)
+endif()
+if(NOT "${OLD_CONTENT}" STREQUAL "${CONTENT}")
+  file(WRITE ${OUTPUT_FILE} "${CONTENT}")
+endif()
@@ -0,0 +1,14 @@
+#pragma once
+#include <string>
+
+namespace MicroBench
+{
+    // 固定种子, 保证各次运行输入一致
+    const unsigned int RandomSeed = 20230622;
+
+    // 生成 Annoy 测试索引并初始化 AnnoyIndexCache, 首次调用时执行
+    bool InitAnnoyFixture(std::string &slice, std::string &item_key);
+
+    // 停止 AnnoyIndexCache 刷新线程并删除测试索引
+    void ShutdownAnnoyFixture();
+}
@@ -0,0 +1,153 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "benchmark/benchmark.h"
+
+#include "Recall/Recall.h"
+#include "Recall/ItemIdSet.h"
+#include "Recall/RecallCalc.hpp"
+#include "Recall/RecallType.hpp"
+#include "AlgoCenter/ResponseData.h"
+
+#include "MicroBench.h"
+
+// 召回算子: 抽样, 抽样数分配, 多渠道融合
+
+namespace
+{
+    const int SampleFold = 3;
+    const int SamplingNum = 200;
+    const long WeightPrecision = 1000;
+
+    std::vector<RecallCalc::SampleInfo> BuildSample(int sample_num)
+    {
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+
+        std::vector<RecallCalc::SampleInfo> vecSample(sample_num);
+        for (int idx = 0; idx < sample_num; idx++)
+        {
+            vecSample[idx].id = 100000 + idx;
+            vecSample[idx].res_type = 1;
+            vecSample[idx].weight = weight(rng);
+        }
+        return vecSample;
+    }
+
+    // 参数: 样品数量, 权重精度(0 为随机抽样)
+    void BM_SingleIndexSampling(benchmark::State &state)
+    {
+        const auto vecSample = BuildSample(state.range(0));
+        const long weightPrecision = state.range(1);
+        for (auto _ : state)
+        {
+            std::vector<std::string> result;
+            RecallCalc::SingleIndexSampling(vecSample, SampleFold, SamplingNum, weightPrecision, result);
+            benchmark::DoNotOptimize(result.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_SingleIndexSampling)
+        ->ArgsProduct({benchmark::CreateRange(100, 100000, 10), {0, WeightPrecision}})
+        ->Unit(benchmark::kMicrosecond);
+
+    // 参数: 样品数量
+    void BM_WeightSampling(benchmark::State &state)
+    {
+        const auto vecSample = BuildSample(state.range(0));
+        for (auto _ : state)
+        {
+            std::unordered_map<std::string, int> resultData;
+            std::unordered_map<std::string, int> resultCalcWeight;
+            RecallCalc::WeightSampling(vecSample, SampleFold, SamplingNum, WeightPrecision, resultData, resultCalcWeight);
+            benchmark::DoNotOptimize(resultData.size());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_WeightSampling)
+        ->RangeMultiplier(10)
+        ->Range(100, 100000)
+        ->Unit(benchmark::kMicrosecond);
+
+    // 参数: 候选ID数量, 全部参与分配
+    void BM_AllocateSamplingNum(benchmark::State &state)
+    {
+        const int id_num = state.range(0);
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::uniform_real_distribution<float> weight(0.0f, 1.0f);
+
+        std::vector<RecallCalc::IDWeight> vecIDWeight(id_num);
+        for (int idx = 0; idx < id_num; idx++)
+        {
+            vecIDWeight[idx].id = 100000 + idx;
+            vecIDWeight[idx].weight = weight(rng);
+        }
+
+        for (auto _ : state)
+        {
+            int actualAllocateNum = 0;
+            std::vector<long> vecResultID;
+            std::vector<int> vecSamplingNum;
+            RecallCalc::AllocateSamplingNum(
+                vecIDWeight, id_num, 1000, 50, true,
+                actualAllocateNum, vecResultID, vecSamplingNum);
+            benchmark::DoNotOptimize(actualAllocateNum);
+        }
+        state.SetItemsProcessed(state.iterations() * id_num);
+    }
+    BENCHMARK(BM_AllocateSamplingNum)
+        ->RangeMultiplier(10)
+        ->Range(100, 100000)
+        ->Unit(benchmark::kMicrosecond);
+
+    // 参数: 每渠道物料数量; 10 渠道, 融合 1000 个
+    void BM_ItemMerge(benchmark::State &state)
+    {
+        static const std::vector<std::string> vecRecallType = {
+            "ResType_Hot", "ResType_Quality", "ResType_Surge", "ResType_CTCVR", "ResType_DLR",
+            "ResType_User_CF", "Item_CF", "Item_Annoy", "ClickOccur", "DownloadOccur"};
+        const int channelItemNum = state.range(0);
+        const int allMergeNum = 1000;
+
+        // 渠道间物料有重复, 重复率随每渠道数量变化
+        std::mt19937 rng(MicroBench::RandomSeed);
+        std::uniform_int_distribution<long> dist(1, static_cast<long>(vecRecallType.size()) * channelItemNum / 2);
+
+        std::vector<RecallParam> vecRecallParams;
+        std::unordered_map<std::string, std::vector<ItemInfo>> recallTypeItemList;
+        for (const auto &recallType : vecRecallType)
+        {
+            RecallParam param;
+            param.Set("recallType", recallType);
+            param.Set("mergeMinNum", 50L);
+            param.Set("mergeMaxNum", 300L);
+            vecRecallParams.push_back(param);
+
+            int recallTypeId = Common::GetRecallTypeID(recallType);
+            auto &vecItemList = recallTypeItemList[recallType];
+            vecItemList.reserve(channelItemNum);
+            for (int idx = 0; idx < channelItemNum; idx++)
+            {
+                vecItemList.emplace_back(dist(rng), 1, recallTypeId, 0.0f, 0.0f);
+            }
+        }
+
+        for (auto _ : state)
+        {
+            // ItemMerge 会移出已融合物料, 每轮重新拷贝输入, 拷贝不计入耗时
+            state.PauseTiming();
+            auto input = recallTypeItemList;
+            state.ResumeTiming();
+
+            ItemIdSet mergeSet(allMergeNum);
+            std::vector<ItemInfo> result;
+            Recall::ItemMerge(allMergeNum, vecRecallParams, input, mergeSet, result);
+            benchmark::DoNotOptimize(result.data());
+        }
+    }
+    BENCHMARK(BM_ItemMerge)
+        ->RangeMultiplier(10)
+        ->Range(100, 10000)
+        ->Unit(benchmark::kMicrosecond);
+}
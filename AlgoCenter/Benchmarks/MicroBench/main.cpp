@@ -0,0 +1,33 @@
+#include <string>
+#include "benchmark/benchmark.h"
+#include "glog/logging.h"
+
+#include "MicroBench.h"
+#include "MicroBenchGitCommit.h" // 构建时生成, 见 MicroBench/GitCommit.cmake
+
+// 热点算子微基准, 不依赖 Redis/Kafka 等外部服务
+// 运行: cd Bin && ./MicroBench --benchmark_out=micro_<commit>.json --benchmark_out_format=json
+// 对比: compare.py benchmarks micro_<old>.json micro_<new>.json (google benchmark 自带 tools/compare.py)
+// 过滤: --benchmark_filter=Sampling 只运行名称匹配的用例
+
+int main(int argc, char **argv)
+{
+    google::InitGoogleLogging(argv[0]);
+    FLAGS_minloglevel = google::GLOG_WARNING;
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    // 写入 JSON 的 context 段, 便于跨提交对比时核对版本
+    benchmark::AddCustomContext("git_commit", MICROBENCH_GIT_COMMIT);
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    MicroBench::ShutdownAnnoyFixture();
+    google::ShutdownGoogleLogging();
+    return 0;
+}
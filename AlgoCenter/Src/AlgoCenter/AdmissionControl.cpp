@@ -0,0 +1,241 @@
+#include "AdmissionControl.h"
+#include <algorithm>
+#include "glog/logging.h"
+
+bool AdmissionControl::Init(int max_inflight, int max_queue_ms, int codel_target_ms, int codel_interval_ms, int estimate_ratio)
+{
+    if (max_inflight <= 0 || max_queue_ms < 0 || codel_target_ms <= 0 ||
+        codel_interval_ms <= 0 || estimate_ratio <= 0)
+    {
+        LOG(ERROR) << "AdmissionControl::Init() params error"
+                   << ", max_inflight = " << max_inflight
+                   << ", max_queue_ms = " << max_queue_ms
+                   << ", codel_target_ms = " << codel_target_ms
+                   << ", codel_interval_ms = " << codel_interval_ms
+                   << ", estimate_ratio = " << estimate_ratio;
+        return false;
+    }
+
+    m_MaxInflight = max_inflight;
+    m_MaxQueueUs = max_queue_ms * 1000L;
+    m_CoDelTargetUs = codel_target_ms * 1000L;
+    m_CoDelIntervalUs = codel_interval_ms * 1000L;
+    m_EstimateRatio = estimate_ratio;
+    g_Init = true;
+
+    LOG(INFO) << "AdmissionControl::Init() succ"
+              << ", max_inflight = " << max_inflight
+              << ", max_queue_ms = " << max_queue_ms
+              << ", codel_target_ms = " << codel_target_ms
+              << ", codel_interval_ms = " << codel_interval_ms
+              << ", estimate_ratio = " << estimate_ratio;
+    return true;
+}
+
+AdmissionControl::Decision AdmissionControl::Acquire(long budget_ms)
+{
+    auto start = Clock::now();
+    LogStatis(start);
+
+    long budget_us = budget_ms * 1000L;
+    if (budget_ms > 0 && budget_us < EstimateDegradeUs())
+    {
+        // 调用方剩余时间连降级链路都不够
+        m_ShedCount.fetch_add(1, std::memory_order_relaxed);
+        return Decision::Shed;
+    }
+
+    // 1. 排队获取在途名额, 最长等待不超过预算
+    long wait_us = m_MaxQueueUs;
+    if (budget_ms > 0)
+    {
+        wait_us = std::min(wait_us, budget_us);
+    }
+
+    long sojourn_us = 0;
+    if (m_Waiting.load() == 0 && TryAcquireSlot())
+    {
+        // 快速路径: 无人排队且有空闲名额, 不加锁; 排队时长为 0, 仅在 CoDel 需要复位时加锁
+        if (m_FirstAboveSet.load(std::memory_order_relaxed) || m_Dropping.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lg(m_Mutex);
+            UpdateCoDel(start, 0);
+        }
+    }
+    else
+    {
+        std::unique_lock<std::mutex> ul(m_Mutex);
+        long ticket = m_NextTicket++;
+        m_Waiting++;
+        bool acquired = m_Cond.wait_until(
+            ul, start + std::chrono::microseconds(wait_us),
+            [this, ticket]()
+            { return ticket == m_ServeTicket && TryAcquireSlot(); });
+        m_Waiting--;
+
+        auto now = Clock::now();
+        sojourn_us = std::chrono::duration_cast<std::chrono::microseconds>(now - start).count();
+        UpdateCoDel(now, acquired ? sojourn_us : m_MaxQueueUs + m_CoDelTargetUs);
+        if (ticket == m_ServeTicket)
+        {
+            m_ServeTicket++;
+            AdvanceTicket();
+        }
+        else
+        {
+            m_AbandonTicket.insert(ticket);
+        }
+
+        // 轮到下一个排队者, 仅在仍有人排队时唤醒
+        bool has_waiting = m_Waiting.load() > 0;
+        ul.unlock();
+        if (has_waiting)
+        {
+            m_Cond.notify_all();
+        }
+
+        if (!acquired)
+        {
+            m_ShedCount.fetch_add(1, std::memory_order_relaxed);
+            return Decision::Shed;
+        }
+    }
+
+    // 2. 按剩余预算与拥塞状态决定完整链路或降级
+    long remain_us = budget_us - sojourn_us;
+    bool budget_short = budget_ms > 0 && remain_us < EstimateFullUs();
+    if (budget_ms > 0 && remain_us < EstimateDegradeUs())
+    {
+        Release();
+        m_ShedCount.fetch_add(1, std::memory_order_relaxed);
+        return Decision::Shed;
+    }
+
+    if (budget_short || m_Dropping.load(std::memory_order_relaxed))
+    {
+        m_DegradeCount.fetch_add(1, std::memory_order_relaxed);
+        return Decision::Degrade;
+    }
+
+    m_AdmitCount.fetch_add(1, std::memory_order_relaxed);
+    return Decision::Admit;
+}
+
+void AdmissionControl::Release()
+{
+    m_Inflight.fetch_sub(1);
+
+    // 无人排队时不加锁也不唤醒; 有人排队时先取锁, 保证排队者已进入等待, 避免丢失唤醒
+    if (m_Waiting.load() > 0)
+    {
+        {
+            std::lock_guard<std::mutex> lg(m_Mutex);
+        }
+        m_Cond.notify_all();
+    }
+}
+
+bool AdmissionControl::TryAcquireSlot()
+{
+    int inflight = m_Inflight.load(std::memory_order_relaxed);
+    while (inflight < m_MaxInflight)
+    {
+        if (m_Inflight.compare_exchange_weak(inflight, inflight + 1))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AdmissionControl::AdvanceTicket()
+{
+    while (!m_AbandonTicket.empty())
+    {
+        auto iter = m_AbandonTicket.find(m_ServeTicket);
+        if (iter == m_AbandonTicket.end())
+        {
+            break;
+        }
+        m_AbandonTicket.erase(iter);
+        m_ServeTicket++;
+    }
+}
+
+void AdmissionControl::RecordStage(Stage stage, double cost_ms)
+{
+    if (stage < 0 || stage >= Stage_Num)
+    {
+        return;
+    }
+
+    // EWMA, alpha = 1/8, 并发更新丢失个别样本可接受
+    long cost_us = static_cast<long>(cost_ms * 1000);
+    long old_us = m_StageCostUs[stage].load(std::memory_order_relaxed);
+    long new_us = (old_us == 0) ? cost_us : old_us + (cost_us - old_us) / 8;
+    m_StageCostUs[stage].store(new_us, std::memory_order_relaxed);
+}
+
+void AdmissionControl::UpdateCoDel(Clock::time_point now, long sojourn_us)
+{
+    if (sojourn_us < m_CoDelTargetUs)
+    {
+        m_FirstAboveSet.store(false, std::memory_order_relaxed);
+        m_Dropping.store(false, std::memory_order_relaxed);
+        return;
+    }
+
+    if (!m_FirstAboveSet.load(std::memory_order_relaxed))
+    {
+        m_FirstAboveSet.store(true, std::memory_order_relaxed);
+        m_FirstAboveTime = now + std::chrono::microseconds(m_CoDelIntervalUs);
+        return;
+    }
+
+    if (now >= m_FirstAboveTime && !m_Dropping.load(std::memory_order_relaxed))
+    {
+        m_Dropping.store(true, std::memory_order_relaxed);
+        LOG(WARNING) << "AdmissionControl::UpdateCoDel() enter dropping state"
+                     << ", sojourn_us = " << sojourn_us
+                     << ", inflight = " << m_Inflight.load();
+    }
+}
+
+long AdmissionControl::EstimateFullUs() const
+{
+    long total_us = 0;
+    for (int stage = 0; stage < Stage_Num; stage++)
+    {
+        total_us += m_StageCostUs[stage].load(std::memory_order_relaxed);
+    }
+    return total_us * m_EstimateRatio / 100;
+}
+
+long AdmissionControl::EstimateDegradeUs() const
+{
+    long total_us = m_StageCostUs[Stage_Context].load(std::memory_order_relaxed) +
+                    m_StageCostUs[Stage_Recall].load(std::memory_order_relaxed) +
+                    m_StageCostUs[Stage_Display].load(std::memory_order_relaxed);
+    return total_us * m_EstimateRatio / 100;
+}
+
+void AdmissionControl::LogStatis(Clock::time_point now)
+{
+    static const long log_interval_sec = 10;
+
+    long now_sec = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+    long last_sec = m_LastLogTime.load(std::memory_order_relaxed);
+    if (now_sec - last_sec < log_interval_sec ||
+        !m_LastLogTime.compare_exchange_strong(last_sec, now_sec))
+    {
+        return;
+    }
+
+    LOG(INFO) << "AdmissionControl Statis"
+              << ", admit = " << GetAdmitCount()
+              << ", degrade = " << GetDegradeCount()
+              << ", shed = " << GetShedCount()
+              << ", dropping = " << m_Dropping.load(std::memory_order_relaxed)
+              << ", estimate_full_us = " << EstimateFullUs()
+              << ", estimate_degrade_us = " << EstimateDegradeUs();
+}
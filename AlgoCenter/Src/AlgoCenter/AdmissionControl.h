@@ -0,0 +1,138 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_set>
+
+#include "Common/Singleton.h"
+
+// 准入控制与降载
+// 1. 在途请求数上限, 超出时排队等待, 以排队时长作为 CoDel 拥塞信号
+//    无人排队且有空闲名额时走无锁快速路径, 只有存在排队者时才加锁与唤醒
+// 2. 按各阶段耗时的滑动估计判断剩余时间是否足够走完整链路
+// 3. 不足时降级(仅召回 + 备用列表), 连降级也来不及时直接拒绝
+class AdmissionControl : public Singleton<AdmissionControl>
+{
+public:
+    // 准入结果
+    enum class Decision
+    {
+        Admit = 0,   // 完整链路
+        Degrade = 1, // 降级链路
+        Shed = 2,    // 拒绝
+    };
+
+    // 请求处理阶段, 用于耗时估计
+    enum Stage
+    {
+        Stage_Context = 0, // 上下文初始化
+        Stage_Recall,      // 召回
+        Stage_Feature,     // 物料特征
+        Stage_Filter,      // 过滤与粗排
+        Stage_Rank,        // 排序
+        Stage_Display,     // 展控
+        Stage_Num,
+    };
+
+public:
+    // 初始化
+    // [in] max_inflight 最大在途请求数
+    // [in] max_queue_ms 最长排队时间(毫秒)
+    // [in] codel_target_ms CoDel 目标排队时间(毫秒)
+    // [in] codel_interval_ms CoDel 观察窗口(毫秒)
+    // [in] estimate_ratio 耗时估计放大比例(百分比)
+    bool Init(int max_inflight, int max_queue_ms, int codel_target_ms, int codel_interval_ms, int estimate_ratio);
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 申请准入, 可能阻塞排队; 返回 Admit/Degrade 时必须调用 Release
+    // [in] budget_ms 剩余时间预算(毫秒), <= 0 表示不限制
+    Decision Acquire(long budget_ms);
+
+    // 释放在途名额
+    void Release();
+
+    // 记录完整链路各阶段耗时
+    void RecordStage(Stage stage, double cost_ms);
+
+    inline long GetAdmitCount() const noexcept { return m_AdmitCount.load(std::memory_order_relaxed); }
+    inline long GetDegradeCount() const noexcept { return m_DegradeCount.load(std::memory_order_relaxed); }
+    inline long GetShedCount() const noexcept { return m_ShedCount.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // 在途数未达上限时占用一个名额
+    bool TryAcquireSlot();
+
+    // 跳过已放弃的票号, 需持有 m_Mutex
+    void AdvanceTicket();
+
+    // CoDel 状态更新, 需持有 m_Mutex
+    void UpdateCoDel(Clock::time_point now, long sojourn_us);
+
+    // 完整链路与降级链路耗时估计(微秒)
+    long EstimateFullUs() const;
+    long EstimateDegradeUs() const;
+
+    void LogStatis(Clock::time_point now);
+
+private:
+    std::atomic<bool> g_Init = false;
+    int m_MaxInflight = 0;
+    long m_MaxQueueUs = 0;
+    long m_CoDelTargetUs = 0;
+    long m_CoDelIntervalUs = 0;
+    int m_EstimateRatio = 100;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+    std::atomic<int> m_Inflight = 0;
+    std::atomic<int> m_Waiting = 0; // 排队中的请求数, 修改需持有 m_Mutex
+
+    // 排队按票号先进先出, 避免新到请求越过排队请求使排队时长失真
+    long m_NextTicket = 0;
+    long m_ServeTicket = 0;
+    std::unordered_set<long> m_AbandonTicket; // 超时放弃的票号
+
+    // CoDel: 排队时长持续高于目标超过一个窗口即进入拥塞状态
+    Clock::time_point m_FirstAboveTime;
+    std::atomic<bool> m_FirstAboveSet = false;
+    std::atomic<bool> m_Dropping = false;
+
+    // 各阶段耗时 EWMA(微秒)
+    std::atomic<long> m_StageCostUs[Stage_Num] = {};
+
+    std::atomic<long> m_AdmitCount = 0;
+    std::atomic<long> m_DegradeCount = 0;
+    std::atomic<long> m_ShedCount = 0;
+    std::atomic<long> m_LastLogTime = 0;
+
+public:
+    AdmissionControl(token) {}
+    ~AdmissionControl() {}
+    AdmissionControl(AdmissionControl &) = delete;
+    AdmissionControl &operator=(const AdmissionControl &) = delete;
+};
+
+// 准入名额守卫, 析构时释放
+class AdmissionGuard
+{
+public:
+    AdmissionGuard() = default;
+    ~AdmissionGuard()
+    {
+        if (m_Hold)
+        {
+            AdmissionControl::GetInstance()->Release();
+        }
+    }
+    AdmissionGuard(const AdmissionGuard &) = delete;
+    AdmissionGuard &operator=(const AdmissionGuard &) = delete;
+
+    inline void Hold() noexcept { m_Hold = true; }
+
+private:
+    bool m_Hold = false;
+};
@@ -3,6 +3,7 @@
 #include <future>
 #include <thread>
 #include <unordered_set>
+#include <memory_resource>
 
 #include <algorithm>
 #include <random>
@@ -28,11 +29,15 @@
 #include "Recall/RecallConfig.h"
 
 #include "Filter/Filter.h"
+#include "Filter/ExposureStore.h"
+#include "Filter/CatalogBitmap.h"
+#include "Filter/DownloadSetCache.h"
 #include "Filter/FilterConfig.h"
 
 #include "Display/Display.h"
 #include "Display/DisplayConfig.h"
 
+#include "PreRank.h"
 #include "ItemRank.h"
 
 #include "RedisProtoData/include/RedisProtoData.h"
@@ -40,6 +45,17 @@
 #include "Protobuf/proxy/AlgoCenter.pb.h"
 
 #include "StatisLogData.h"
+#include "AdmissionControl.h"
+#include "StageBudgetConfig.h"
+#include "ConfigSnapshot.h"
+#include "SessionCache.h"
+#include "RequestCoalescer.h"
+#include "DegradeStatis.h"
+#include "RequestArena.h"
+#include "Monitor/Monitor.h"
+#include "Trace/Tracer.h"
+#include "Replay/Recorder.h"
+#include "Replay/RequestRandom.h"
 
 bool AlgoCenter::Init()
 {
@@ -60,7 +76,17 @@ bool AlgoCenter::OnDownloadRecommen(
     RequestData requestData;
     ResponseData responseData;
 
-    COMM_AlgoCenter::AlgoCenterRequest requestProto;
+    // 请求级内存池, 请求、应答与用户特征 Proto 在请求结束时一次性释放
+    auto conf = Config::GetInstance();
+    if (conf->GetRequestArenaSwitch())
+    {
+        requestData.spArena = RequestArena::Create(conf->GetRequestArenaInitialBlockKB() * 1024);
+    }
+    google::protobuf::Arena *pArena = (requestData.spArena != nullptr) ? requestData.spArena->GetProtoArena() : nullptr;
+
+    auto pRequestProto = google::protobuf::Arena::CreateMessage<COMM_AlgoCenter::AlgoCenterRequest>(pArena);
+    std::unique_ptr<COMM_AlgoCenter::AlgoCenterRequest> upRequestProto(pArena == nullptr ? pRequestProto : nullptr);
+    auto &requestProto = *pRequestProto;
 
     result = GrpcProtos::ResultType::OK;
     if (!requestProto.ParseFromString(request))
@@ -70,29 +96,8 @@ bool AlgoCenter::OnDownloadRecommen(
         return false;
     }
 
-    requestData.uuid = requestProto.request_id();
-    requestData.user_id = requestProto.user_id();
-    requestData.ret_count = requestProto.ret_count();
-
-    for (int idx = 0; idx < requestProto.exp_list_size(); ++idx)
+    if (!InitRequestData(cmd, requestProto, requestData))
     {
-        requestData.vecExpID.push_back(requestProto.exp_list(idx));
-    }
-
-    requestData.context_item_id = requestProto.ll_id();
-    requestData.context_res_type = requestProto.res_type();
-    for (int idx = 0; idx < requestProto.keyname_list_size(); ++idx)
-    {
-        requestData.vecKeynames.push_back(requestProto.keyname_list(idx));
-    }
-
-    // 确定请求类型
-    switch (cmd)
-    {
-    case GrpcProtos::CMD_GET_DOWNLOAD_RECOMMEND:
-        requestData.apiType = Common::APIType::Get_Download_Recommend;
-        break;
-    default:
         result = GrpcProtos::ResultType::ERR_Service_CMD;
         response = "CMD Type Error.";
         return false;
@@ -108,17 +113,113 @@ bool AlgoCenter::OnDownloadRecommen(
     requestData.is_statis_log = true;
 #endif
 
-    if (GetRecommendItem(requestData, responseData) == false)
+    // 链路追踪跟随统计日志采样
+    TraceScope traceScope(requestData.is_statis_log, requestData.uuid);
+
+    // 流量录制按 uuid 独立采样
+    RecordScope recordScope(requestData.uuid, cmd, request);
+
+    // 录制与回放的请求随机数按 uuid 设定种子, 回放时结果可复现
+    if (Recorder::IsActive() || RequestRandom::IsReplayMode())
     {
-        result = GrpcProtos::ResultType::ERR_Service_Cal;
-        response = "Get Recommend Item Error.";
-        return false;
+        RequestRandom::Seed(requestData.uuid);
+    }
+
+    TraceSpan requestSpan("OnDownloadRecommen");
+
+    // 在途请求合并: 相同请求正在计算时等待并复用其应答, 等待超时则自行计算
+    // 需在翻页会话缓存之前, 重复请求不能取走下一页
+    CoalesceGuard coalesceGuard(result, response);
+    auto coalescer = RequestCoalescer::GetInstance();
+    if (coalescer->IsInit())
+    {
+        std::string coalesceKey = RequestCoalescer::MakeKey(
+            cmd, requestData.user_id, requestData.context_item_id, requestData.context_res_type,
+            requestData.vecExpID, requestData.vecKeynames, requestData.ret_count);
+        RequestCoalescer::FlightFuture flightFuture;
+        if (coalescer->Join(coalesceKey, flightFuture))
+        {
+            coalesceGuard.Hold(std::move(coalesceKey));
+        }
+        else
+        {
+            TraceSpan coalesceSpan("CoalesceWait");
+            auto spFlightResult = coalescer->Wait(flightFuture, coalescer->GetMaxWaitMs());
+            if (spFlightResult != nullptr)
+            {
+                result = spFlightResult->result;
+                response = spFlightResult->response;
+                return result == GrpcProtos::ResultType::OK;
+            }
+            LOG(WARNING) << "OnDownloadRecommen() coalesce wait timeout"
+                         << ", uuid = " << requestData.uuid
+                         << ", user_id = " << requestData.user_id;
+        }
+    }
+
+    // 翻页会话缓存: 同一用户同一上下文的后续翻页直接取下一页, 跳过完整计算; 同一 uuid 重试返回同一页
+    auto sessionCache = SessionCache::GetInstance();
+    bool use_session = sessionCache->IsInit() && requestData.user_id > 0;
+    SessionCache::SessionKey sessionKey;
+    if (use_session)
+    {
+        sessionKey.user_id = requestData.user_id;
+        sessionKey.context_item_id = requestData.context_item_id;
+        sessionKey.context_res_type = requestData.context_res_type;
+        sessionKey.exp_hash = SessionCache::HashExpList(requestData.vecExpID);
+        sessionKey.keyname_hash = SessionCache::HashKeynames(requestData.vecKeynames);
+    }
+    bool session_hit = use_session && sessionCache->Fetch(sessionKey, requestData.uuid, requestData.ret_count, responseData.items_list);
+
+    // AdmissionGuard 需持有到请求结束
+    AdmissionGuard admissionGuard;
+    if (!session_hit)
+    {
+        // 准入控制: deadline_ms 大于 1e12 视为绝对时间戳(毫秒), 否则视为剩余时间
+        auto admission = AdmissionControl::GetInstance();
+        if (admission->IsInit())
+        {
+            long budget_ms = deadline_ms;
+            if (deadline_ms > 1000000000000L)
+            {
+                long now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::system_clock::now().time_since_epoch())
+                                  .count();
+                budget_ms = std::max(1L, deadline_ms - now_ms);
+            }
+
+            TraceSpan admissionSpan("AdmissionAcquire");
+            auto decision = admission->Acquire(budget_ms);
+            admissionSpan.End();
+            if (decision == AdmissionControl::Decision::Shed)
+            {
+                result = GrpcProtos::ResultType::ERR_Service_Cal;
+                response = "Service Overload.";
+                LOG(WARNING) << "OnDownloadRecommen() request shed"
+                             << ", uuid = " << requestData.uuid
+                             << ", user_id = " << requestData.user_id
+                             << ", budget_ms = " << budget_ms;
+                return false;
+            }
+            admissionGuard.Hold();
+            requestData.is_degrade = (decision == AdmissionControl::Decision::Degrade);
+        }
+
+        if (GetRecommendItem(requestData, responseData) == false)
+        {
+            result = GrpcProtos::ResultType::ERR_Service_Cal;
+            response = "Get Recommend Item Error.";
+            return false;
+        }
+        DegradeStatis::GetInstance()->Record(responseData.degrade_flags);
     }
 
     int items_list_size = responseData.items_list.size();
     int use_ret_count = std::min(requestData.ret_count, items_list_size);
 
-    COMM_AlgoCenter::AlgoCenterResponse protoReply;
+    auto pProtoReply = google::protobuf::Arena::CreateMessage<COMM_AlgoCenter::AlgoCenterResponse>(pArena);
+    std::unique_ptr<COMM_AlgoCenter::AlgoCenterResponse> upProtoReply(pArena == nullptr ? pProtoReply : nullptr);
+    auto &protoReply = *pProtoReply;
     protoReply.set_user_id(requestData.user_id);
     for (int idx = 0; idx < use_ret_count; idx++)
     {
@@ -138,6 +239,74 @@ bool AlgoCenter::OnDownloadRecommen(
         return false;
     }
 
+    // 记录本次曝光, 供后续翻页请求去重
+    auto exposureStore = ExposureStore::GetInstance();
+    if (exposureStore->IsInit() && requestData.user_id > 0 && use_ret_count > 0)
+    {
+        ExposureStore::ExposureKey exposureKey;
+        exposureKey.user_id = requestData.user_id;
+        exposureKey.context_item_id = requestData.context_item_id;
+        exposureKey.context_res_type = requestData.context_res_type;
+
+        std::vector<uint64_t> vecItemKey;
+        vecItemKey.reserve(use_ret_count);
+        for (int idx = 0; idx < use_ret_count; idx++)
+        {
+            const auto &item_info = responseData.items_list[idx];
+            vecItemKey.push_back(UserDownloadSet::MakeKey(item_info.item_id, item_info.res_type));
+        }
+        exposureStore->Record(exposureKey, vecItemKey);
+    }
+
+    // 缓存完整列表, 后续翻页从本次返回之后开始; 降级结果不缓存
+    if (use_session && !session_hit && responseData.degrade_flags == Degrade_None &&
+        items_list_size > use_ret_count)
+    {
+        sessionCache->Store(sessionKey, requestData.uuid, std::move(responseData.items_list), use_ret_count);
+    }
+
+    if (requestData.is_statis_log && requestData.spArena != nullptr)
+    {
+        LOG(INFO) << "OnDownloadRecommen() RequestArena"
+                  << ", uuid = " << requestData.uuid
+                  << ", used_bytes = " << requestData.spArena->GetUsedBytes();
+    }
+
+    return true;
+}
+
+bool AlgoCenter::InitRequestData(
+    const int cmd,
+    const COMM_AlgoCenter::AlgoCenterRequest &requestProto,
+    RequestData &requestData)
+{
+    requestData.uuid = requestProto.request_id();
+    requestData.user_id = requestProto.user_id();
+
+    requestData.ret_count = requestProto.ret_count();
+
+    for (int idx = 0; idx < requestProto.exp_list_size(); ++idx)
+    {
+        requestData.vecExpID.push_back(requestProto.exp_list(idx));
+    }
+
+    requestData.context_item_id = requestProto.ll_id();
+    requestData.context_res_type = requestProto.res_type();
+    for (int idx = 0; idx < requestProto.keyname_list_size(); ++idx)
+    {
+        requestData.vecKeynames.push_back(requestProto.keyname_list(idx));
+    }
+
+    // 确定请求类型
+    switch (cmd)
+    {
+    case GrpcProtos::CMD_GET_DOWNLOAD_RECOMMEND:
+        requestData.apiType = Common::APIType::Get_Download_Recommend;
+        break;
+    default:
+        return false;
+    }
+
     return true;
 }
 
@@ -158,6 +327,8 @@ bool AlgoCenter::GetRecommendItem(
               << ", ret_count = " << requestData.ret_count;
 
     // 1. 上下文初始化
+    TraceSpan contextSpan("ContextInit");
+
     // 1.1 初始化用户特征
     int32_t initContextUserErr = requestData.InitUserFeature();
     if (Common::Error::OK != initContextUserErr)
@@ -196,15 +367,27 @@ bool AlgoCenter::GetRecommendItem(
     }
     }
 
+    contextSpan.End();
     double context_init_end_time = Common::get_ms_time();
 
-    // 2. 获取统一匹配实验id和用户组实验配置
-    requestData.recallExpID = RecallConfig::GetInstance()->MatchRecallExpID(requestData.apiType, requestData.vecExpID);
-    requestData.filterExpID = FilterConfig::GetInstance()->MatchFilterExpID(requestData.apiType, requestData.vecExpID);
-    requestData.displayExpID = DisplayConfig::GetInstance()->MatchDisplayExpID(requestData.apiType, requestData.vecExpID);
-
-    const RecallParamData *pRecallParamData =
-        Recall::GetInstance()->GetRecallParamData(requestData, responseData);
+    // 2. 按实验与用户组路由各层级配置, 本次请求只读取同一份配置快照
+    requestData.spConfigSnapshot = ConfigSnapshot::Current();
+    if (requestData.spConfigSnapshot == nullptr)
+    {
+        LOG(ERROR) << "GetRecommendItem() Config Snapshot is nullptr"
+                   << ", apiType" << requestData.apiType
+                   << ", uuid = " << requestData.uuid;
+        return false;
+    }
+    RoutePlan routePlan;
+    requestData.spConfigSnapshot->routeTable.Route(
+        requestData.apiType, requestData.vecExpID,
+        requestData.spConfigSnapshot->routeTable.GetUserGroupMask(requestData.userGroupList), routePlan);
+    requestData.recallExpID = routePlan.recallExpID;
+    requestData.filterExpID = routePlan.filterExpID;
+    requestData.displayExpID = routePlan.displayExpID;
+
+    const RecallParamData *pRecallParamData = routePlan.pRecallParamData;
     if (pRecallParamData == nullptr)
     {
         LOG(ERROR) << "GetRecommendItem() Get Recall Config is nullptr"
@@ -215,8 +398,7 @@ bool AlgoCenter::GetRecommendItem(
     }
     requestData.recallUserGroup = pRecallParamData->user_group;
 
-    const FilterParamData *pFilterParamData =
-        Filter::GetInstance()->GetFilterParamData(requestData, responseData);
+    const FilterParamData *pFilterParamData = routePlan.pFilterParamData;
     if (pFilterParamData == nullptr)
     {
         LOG(ERROR) << "GetRecommendItem() Get Filter Config is nullptr"
@@ -227,8 +409,7 @@ bool AlgoCenter::GetRecommendItem(
     }
     requestData.filterUserGroup = pFilterParamData->user_group;
 
-    const DisplayParamData *pDisplayParamData =
-        Display::GetInstance()->GetDisplayParamData(requestData, responseData);
+    const DisplayParamData *pDisplayParamData = routePlan.pDisplayParamData;
     if (pDisplayParamData == nullptr)
     {
         LOG(ERROR) << "GetRecommendItem() Get Display Config is nullptr"
@@ -239,6 +420,17 @@ bool AlgoCenter::GetRecommendItem(
     }
     requestData.displayUserGroup = pDisplayParamData->user_group;
 
+    // 阶段预算: 自上下文初始化结束起累计, 前序阶段超出时后续阶段降级
+    const StageBudgetParam *pStageBudget = routePlan.pStageBudget;
+    auto lambda_over_budget = [context_init_end_time](int budget_ms) -> bool
+    {
+        return budget_ms > 0 && Common::get_ms_time() - context_init_end_time > budget_ms;
+    };
+    if (pStageBudget != nullptr && pStageBudget->recall_ms > 0)
+    {
+        requestData.recall_deadline_ms = Common::get_ms_time() + pStageBudget->recall_ms;
+    }
+
     // 3. 召回
     int recallErr = Recall::GetInstance()->CallRecall(pRecallParamData, requestData, responseData);
     if (recallErr != Common::Error::OK)
@@ -250,10 +442,66 @@ bool AlgoCenter::GetRecommendItem(
         return false;
     }
 
+    // 剔除已下架物料, 减少特征获取与排序的数据量
+    int catalog_prune_num = 0;
+    auto catalogBitmap = CatalogBitmap::GetInstance();
+    if (catalogBitmap->IsInit())
+    {
+        catalog_prune_num = catalogBitmap->PruneItems(requestData, responseData);
+    }
+
     double call_recall_end_time = Common::get_ms_time();
 
+    // 降级: 跳过特征与排序, 执行不依赖物料特征的过滤(已下架物料在上方剔除)后返回备用召回列表
+    if (requestData.is_degrade)
+    {
+        responseData.degrade_flags |= Degrade_Admission;
+        int degradeFilterErr = Filter::GetInstance()->CallDegradeFilter(pFilterParamData, requestData, responseData);
+        if (degradeFilterErr != Common::Error::OK)
+        {
+            LOG(ERROR) << "GetRecommendItem Degrade Call Filter Failed"
+                       << ", apiType" << requestData.apiType
+                       << ", filter exp_id = " << requestData.filterExpID
+                       << ", err = " << degradeFilterErr;
+            return false;
+        }
+
+        if (!responseData.spare_items_list.empty())
+        {
+            responseData.items_list = std::move(responseData.spare_items_list);
+            responseData.spare_items_list.clear();
+        }
+
+        int scError = Display::GetInstance()->CallDisplay(pDisplayParamData, requestData, responseData);
+        if (scError != Common::Error::OK)
+        {
+            LOG(ERROR) << "GetRecommendItem Degrade Call Display Failed"
+                       << ", apiType" << requestData.apiType
+                       << ", Show Control exp_id = " << requestData.displayExpID
+                       << ", err = " << scError;
+            return false;
+        }
+
+        double degrade_end_time = Common::get_ms_time();
+        LOG(INFO) << "GetRecommendItem() Degrade Request"
+                  << ", uuid = " << requestData.uuid
+                  << ", user_id = " << requestData.user_id
+                  << ", apiType" << requestData.apiType
+                  << ", item size = " << responseData.items_list.size()
+                  << ", All Request Time = " << degrade_end_time - start_time << "ms.";
+
+        responseData.vecStageCost = {{"context", context_init_end_time - start_time},
+                                     {"recall", call_recall_end_time - context_init_end_time},
+                                     {"display", degrade_end_time - call_recall_end_time},
+                                     {"all", degrade_end_time - start_time}};
+        ObserveStageMonitor(requestData, responseData.vecStageCost);
+        return true;
+    }
+
     // 4. 初始化Item特征，并过滤
-    std::unordered_set<std::string> total_keys_set;
+    TraceSpan featureSpan("InitItemFeature");
+    std::pmr::unordered_set<std::string> total_keys_set(
+        requestData.spArena != nullptr ? requestData.spArena->GetResource() : std::pmr::get_default_resource());
     for (const auto &item_info : responseData.items_list)
     {
         total_keys_set.insert(std::to_string(item_info.item_id) + "_" + std::to_string(item_info.res_type));
@@ -287,8 +535,10 @@ bool AlgoCenter::GetRecommendItem(
         return false;
     }
 
+    featureSpan.End();
     double feature_init_end_time = Common::get_ms_time();
 
+    TraceSpan filterSpan("CallFilter");
     int filterErr = Filter::GetInstance()->CallFilter(pFilterParamData, requestData, responseData);
     if (filterErr != Common::Error::OK)
     {
@@ -299,21 +549,59 @@ bool AlgoCenter::GetRecommendItem(
         return false;
     }
 
-    unsigned random_seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::shuffle(responseData.items_list.begin(), responseData.items_list.end(),
-                 std::default_random_engine(random_seed));
+    // 前序阶段超出预算, 只保留召回融合顺序前 N 个物料进入排序
+    if (pStageBudget != nullptr && pStageBudget->rank_degrade_num > 0 &&
+        (int)responseData.items_list.size() > pStageBudget->rank_degrade_num &&
+        lambda_over_budget(pStageBudget->BeforeRankMs()))
+    {
+        responseData.items_list.resize(pStageBudget->rank_degrade_num);
+        responseData.degrade_flags |= Degrade_RankTrunc;
+    }
 
+    std::shuffle(responseData.items_list.begin(), responseData.items_list.end(), RequestRandom::Engine());
+
+    filterSpan.End();
     double filter_end_time = Common::get_ms_time();
 
-    // 5. 调用排序
+    // 5. 粗排, 截断后再调用远程排序
+    if (Config::GetInstance()->GetPreRankSwitch())
+    {
+        TraceSpan preRankSpan("PreRankCalc");
+        PreRank::GetInstance()->PreRankCalc(requestData, responseData);
+    }
+
+    double pre_rank_end_time = Common::get_ms_time();
+
+    // 6. 调用排序
     int rank_calc_num = responseData.items_list.size();
     ItemRank::RankCalc(requestData, responseData);
 
+    double rank_calc_end_time = Common::get_ms_time();
+
+    // 粗排效果统计: 按本次精排单物料耗时估算节省时间, 并计算粗排与精排的一致性
+    if (responseData.pre_rank_input_num > 0 && requestData.is_statis_log && rank_calc_num > 0)
+    {
+        double rank_time = rank_calc_end_time - pre_rank_end_time;
+        double saved_time = rank_time / rank_calc_num * (responseData.pre_rank_input_num - rank_calc_num);
+        LOG(INFO) << "GetRecommendItem() PreRank Report"
+                  << ", uuid = " << requestData.uuid
+                  << ", pre_rank_input_num = " << responseData.pre_rank_input_num
+                  << ", rank_calc_num = " << rank_calc_num
+                  << ", pre_rank_time = " << responseData.pre_rank_time << "ms"
+                  << ", estimate_saved_time = " << saved_time - responseData.pre_rank_time << "ms"
+                  << ", rank_agreement = " << PreRank::RankAgreement(responseData);
+    }
+
     StatisLogData::OutStatisLog(requestData, responseData, "After Rank", {50, 20, 8, 3}, false, true);
 
     double rank_call_end_time = Common::get_ms_time();
 
-    // 6. 展控模块
+    // 7. 展控模块, 前序阶段超出预算时跳过打散
+    if (pStageBudget != nullptr && lambda_over_budget(pStageBudget->BeforeDisplayMs()))
+    {
+        responseData.degrade_flags |= Degrade_ScatterSkip;
+    }
+
     int scError = Display::GetInstance()->CallDisplay(pDisplayParamData, requestData, responseData);
     if (scError != Common::Error::OK)
     {
@@ -344,13 +632,38 @@ bool AlgoCenter::GetRecommendItem(
               << ", displayUserGroup = " << requestData.displayUserGroup
               << ", Context Init Time = " << context_init_end_time - start_time << "ms"
               << ", Call Recall Time = " << call_recall_end_time - context_init_end_time << "ms"
+              << ", Catalog Prune Num = " << catalog_prune_num
               << ", Feature Init Time = " << feature_init_end_time - call_recall_end_time << "ms"
               << ", Call Filter Time = " << filter_end_time - feature_init_end_time << "ms"
+              << ", PreRank Time = " << pre_rank_end_time - filter_end_time << "ms"
               << ", Rank Calc Num = " << rank_calc_num
-              << ", Rank Calc Time = " << rank_call_end_time - filter_end_time << "ms"
+              << ", Rank Calc Time = " << rank_call_end_time - pre_rank_end_time << "ms"
               << ", Call Display Time = " << end_time - rank_call_end_time << "ms"
+              << ", Degrade Flags = " << responseData.degrade_flags
               << ", All Request Time = " << end_time - start_time << "ms.";
 
+    // 更新准入控制的阶段耗时估计
+    auto admission = AdmissionControl::GetInstance();
+    if (admission->IsInit())
+    {
+        admission->RecordStage(AdmissionControl::Stage_Context, context_init_end_time - start_time);
+        admission->RecordStage(AdmissionControl::Stage_Recall, call_recall_end_time - context_init_end_time);
+        admission->RecordStage(AdmissionControl::Stage_Feature, feature_init_end_time - call_recall_end_time);
+        admission->RecordStage(AdmissionControl::Stage_Filter, pre_rank_end_time - feature_init_end_time);
+        admission->RecordStage(AdmissionControl::Stage_Rank, rank_call_end_time - pre_rank_end_time);
+        admission->RecordStage(AdmissionControl::Stage_Display, end_time - rank_call_end_time);
+    }
+
+    responseData.vecStageCost = {{"context", context_init_end_time - start_time},
+                                 {"recall", call_recall_end_time - context_init_end_time},
+                                 {"feature", feature_init_end_time - call_recall_end_time},
+                                 {"filter", filter_end_time - feature_init_end_time},
+                                 {"prerank", pre_rank_end_time - filter_end_time},
+                                 {"rank", rank_call_end_time - pre_rank_end_time},
+                                 {"display", end_time - rank_call_end_time},
+                                 {"all", end_time - start_time}};
+    ObserveStageMonitor(requestData, responseData.vecStageCost);
+
     // 输出特征
     DebugLogFeature(requestData, responseData);
 
@@ -358,6 +671,25 @@ bool AlgoCenter::GetRecommendItem(
 }
 
 // 输出日志
+void AlgoCenter::ObserveStageMonitor(
+    const RequestData &requestData,
+    const std::vector<std::pair<std::string, double>> &vecStageCost)
+{
+    auto monitor = Monitor::GetInstance();
+    if (!monitor->IsInit())
+    {
+        return;
+    }
+
+    Monitor::RequestLabel label;
+    label.api = std::to_string(static_cast<int>(requestData.apiType));
+    label.recall_exp = std::to_string(requestData.recallExpID);
+    label.filter_exp = std::to_string(requestData.filterExpID);
+    label.display_exp = std::to_string(requestData.displayExpID);
+    label.user_group = requestData.recallUserGroup;
+    monitor->ObserveStage(label, vecStageCost);
+}
+
 void AlgoCenter::DebugLogFeature(
     const RequestData &requestData,
     const ResponseData &responseData)
@@ -428,7 +760,8 @@ void AlgoCenter::DebugLogFeature(
         logWriter.Key("item_id");
         logWriter.Int64(item_info.item_id);
         logWriter.Key("recall_type");
-        logWriter.String(item_info.recall_type.c_str(), item_info.recall_type.size());
+        const auto &recall_type = Common::GetRecallTypeName(item_info.recall_type_id);
+        logWriter.String(recall_type.c_str(), recall_type.size());
         logWriter.Key("score");
         logWriter.Double(item_info.score);
         logWriter.Key("sc_score");
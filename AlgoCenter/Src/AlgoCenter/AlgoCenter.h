@@ -7,6 +7,11 @@
 class RequestData;
 class ResponseData;
 
+namespace COMM_AlgoCenter
+{
+    class AlgoCenterRequest;
+}
+
 class AlgoCenter
 {
 public:
@@ -21,6 +26,12 @@ public:
         int &result,
         std::string &response);
 
+    // 请求 Proto 转换为 RequestData, cmd 不支持时返回 false
+    static bool InitRequestData(
+        const int cmd,
+        const COMM_AlgoCenter::AlgoCenterRequest &requestProto,
+        RequestData &requestData);
+
     static bool GetRecommendItem(
         RequestData &requestData,
         ResponseData &responseData);
@@ -30,4 +41,9 @@ protected:
     static void DebugLogFeature(
         const RequestData &requestData,
         const ResponseData &responseData);
+
+    // 上报各阶段耗时(毫秒)
+    static void ObserveStageMonitor(
+        const RequestData &requestData,
+        const std::vector<std::pair<std::string, double>> &vecStageCost);
 };
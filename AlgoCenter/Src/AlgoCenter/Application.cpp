@@ -1,5 +1,6 @@
 #include "Application.h"
 #include <thread>
+#include <algorithm>
 #include <unordered_map>
 #include "glog/logging.h"
 #include "timer/timer.h"
@@ -15,11 +16,28 @@
 #include "Recall/RecallConfig.h"
 #include "Recall/AnnoyRecall/AnnoyIndexCache.h"
 #include "Filter/FilterConfig.h"
+#include "Filter/DownloadSetCache.h"
+#include "Filter/ExposureStore.h"
+#include "Filter/CatalogBitmap.h"
 #include "Display/DisplayConfig.h"
 
 #include "Define.h"
 #include "Config.h"
 #include "AlgoCenter.h"
+#include "RankBatcher.h"
+#include "PreRank.h"
+#include "SampleLogPipeline.h"
+#include "AdmissionControl.h"
+#include "StageBudgetConfig.h"
+#include "ConfigSnapshot.h"
+#include "SessionCache.h"
+#include "RequestCoalescer.h"
+#include "DegradeStatis.h"
+#include "RequestArena.h"
+#include "StatisAggregator.h"
+#include "Monitor/Monitor.h"
+#include "Trace/Tracer.h"
+#include "Replay/Recorder.h"
 
 #include "TDPredict/Config/ModelConfig.h"
 #include "TDPredict/Config/RankExpConfig.h"
@@ -103,11 +121,144 @@ bool Application::Init(
         LOG(INFO) << "Init PushKafkaPool Succ.";
     }
 
+    // 初始化样本日志推送, 与推送开关无关, 开关可在配置更新时打开
+    if (!SampleLogPipeline::GetInstance()->Init(
+            conf->GetKafkaPushQueueSize(),
+            conf->GetKafkaPushBatchNum(),
+            conf->GetKafkaPushBatchWaitMs()))
+    {
+        LOG(ERROR) << "Init SampleLogPipeline Error!";
+        return false;
+    }
+    else
+    {
+        LOG(INFO) << "Init SampleLogPipeline Succ.";
+    }
+
+    // 初始化下载过滤集合缓存
+    if (conf->GetDownloadFilterCacheSwitch())
+    {
+        if (!DownloadSetCache::GetInstance()->Init(
+                conf->GetDownloadFilterCacheCapacity(),
+                conf->GetDownloadFilterCacheTTLMs()))
+        {
+            LOG(ERROR) << "Init DownloadSetCache Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init DownloadSetCache Succ.";
+        }
+    }
+
+    // 初始化近期曝光存储
+    if (conf->GetExposureSwitch())
+    {
+        if (!ExposureStore::GetInstance()->Init(
+                conf->GetExposureRingSize(),
+                conf->GetExposureTTLSec(),
+                conf->GetExposureMemoryBudgetMB()))
+        {
+            LOG(ERROR) << "Init ExposureStore Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init ExposureStore Succ.";
+        }
+    }
+
+    // 初始化翻页会话缓存
+    if (conf->GetSessionCacheSwitch())
+    {
+        if (!SessionCache::GetInstance()->Init(
+                conf->GetSessionCacheTTLMs(),
+                conf->GetSessionCacheMemoryBudgetMB()))
+        {
+            LOG(ERROR) << "Init SessionCache Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init SessionCache Succ.";
+        }
+    }
+
+    // 初始化在途请求合并
+    if (conf->GetCoalesceSwitch())
+    {
+        if (!RequestCoalescer::GetInstance()->Init(conf->GetCoalesceMaxWaitMs()))
+        {
+            LOG(ERROR) << "Init RequestCoalescer Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init RequestCoalescer Succ.";
+        }
+    }
+
+    // 初始化物料上架位图
+    if (conf->GetCatalogBitmapSwitch())
+    {
+        if (!CatalogBitmap::GetInstance()->Init(
+                conf->GetCatalogBitmapRedisName(),
+                conf->GetCatalogBitmapRedisKey(),
+                conf->GetCatalogBitmapSnapshotPath(),
+                conf->GetCatalogBitmapRefreshSec()))
+        {
+            LOG(ERROR) << "Init CatalogBitmap Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init CatalogBitmap Succ.";
+        }
+    }
+
+    // 初始化统计聚合
+    if (conf->GetStatisAggregate())
+    {
+        if (!StatisAggregator::GetInstance()->Init(
+                conf->GetStatisWindowSec(),
+                conf->GetStatisDiversityPos(),
+                conf->GetStatisDiversityTopItem(),
+                conf->GetStatisLegacyLog()))
+        {
+            LOG(ERROR) << "Init StatisAggregator Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init StatisAggregator Succ.";
+        }
+    }
+
+    // 初始化准入控制
+    if (conf->GetAdmissionSwitch())
+    {
+        if (!AdmissionControl::GetInstance()->Init(
+                conf->GetAdmissionMaxInflight(),
+                conf->GetAdmissionMaxQueueMs(),
+                conf->GetAdmissionCoDelTargetMs(),
+                conf->GetAdmissionCoDelIntervalMs(),
+                conf->GetAdmissionEstimateRatio()))
+        {
+            LOG(ERROR) << "Init AdmissionControl Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init AdmissionControl Succ.";
+        }
+    }
+
     // 初始化Annoy索引缓存模块
     if (!AnnoyIndexCache::GetInstance()->Init(
             conf->GetAnnoyBasicPath(),
             conf->GetAnnoyEmbDimension(),
-            conf->GetAnnoySearchNodeNum()))
+            conf->GetAnnoySearchNodeNum(),
+            conf->GetAnnoyIndexVectorSwitch()))
     {
         LOG(ERROR) << "Init AnnoyIndexCache Error!";
         return false;
@@ -117,6 +268,69 @@ bool Application::Init(
         LOG(INFO) << "Init AnnoyIndexCache Succ.";
     }
 
+    // 初始化排序工作线程池
+    if (conf->GetRankBatchSwitch())
+    {
+        if (!RankBatcher::GetInstance()->Init(conf->GetRankBatchThreadNum()))
+        {
+            LOG(ERROR) << "Init RankBatcher Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init RankBatcher Succ.";
+        }
+    }
+
+    // 初始化监控指标, 失败(如端口被占用)不影响服务启动, 指标埋点在未初始化时直接返回
+    if (conf->GetMonitorSwitch())
+    {
+        if (!Monitor::GetInstance()->Init(conf->GetMonitorBindAddr()))
+        {
+            LOG(ERROR) << "Init Monitor Error, Continue Without Monitor"
+                       << ", bind_addr = " << conf->GetMonitorBindAddr();
+        }
+        else
+        {
+            RegisterMonitorMetrics();
+            LOG(INFO) << "Init Monitor Succ.";
+        }
+    }
+
+    // 初始化链路追踪
+    if (conf->GetTraceSwitch())
+    {
+        if (!Tracer::GetInstance()->Init(
+                conf->GetTraceFilePath(),
+                conf->GetTraceMaxFileMB(),
+                conf->GetTraceMaxFileNum()))
+        {
+            LOG(ERROR) << "Init Tracer Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init Tracer Succ.";
+        }
+    }
+
+    // 初始化流量录制
+    if (conf->GetRecordSwitch())
+    {
+        if (!Recorder::GetInstance()->Init(
+                conf->GetRecordFilePath(),
+                conf->GetRecordSampleRate(),
+                conf->GetRecordMaxFileMB()))
+        {
+            LOG(ERROR) << "Init Recorder Error!";
+            return false;
+        }
+        else
+        {
+            LOG(INFO) << "Init Recorder Succ.";
+        }
+    }
+
     // 注册服务接口
     algoCenter = std::make_shared<AlgoCenter>();
     if (!algoCenter->Init())
@@ -174,6 +388,37 @@ bool Application::StartProcess(
     builder.AddChannelArgument(GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS, 5000);
     builder.AddChannelArgument(GRPC_ARG_HTTP2_MIN_SENT_PING_INTERVAL_WITHOUT_DATA_MS, 10000);
     builder.SetDefaultCompressionAlgorithm(GRPC_COMPRESS_GZIP);
+
+    // 同步服务线程模型调优: 完成队列数量、轮询线程与总线程数上限, 避免下游变慢时线程无限堆积
+    // 各项为 0 时不设置, 使用 gRPC 默认值(与未调优时一致)
+    if (conf->GetGrpcServerCqNum() > 0)
+    {
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS, conf->GetGrpcServerCqNum());
+    }
+    if (conf->GetGrpcServerMinPollers() > 0)
+    {
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MIN_POLLERS, conf->GetGrpcServerMinPollers());
+    }
+    if (conf->GetGrpcServerMaxPollers() > 0)
+    {
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MAX_POLLERS, conf->GetGrpcServerMaxPollers());
+    }
+    if (conf->GetGrpcServerMaxThreads() > 0)
+    {
+        grpc::ResourceQuota quota("AlgoCenter");
+        quota.SetMaxThreads(conf->GetGrpcServerMaxThreads());
+        builder.SetResourceQuota(quota);
+    }
+    if (conf->GetGrpcServerMaxConcurrentStreams() > 0)
+    {
+        builder.AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS, conf->GetGrpcServerMaxConcurrentStreams());
+    }
+    LOG(INFO) << "Application::StartProcess() grpc sync server option"
+              << ", cq_num = " << conf->GetGrpcServerCqNum()
+              << ", min_pollers = " << conf->GetGrpcServerMinPollers()
+              << ", max_pollers = " << conf->GetGrpcServerMaxPollers()
+              << ", max_threads = " << conf->GetGrpcServerMaxThreads()
+              << ", max_concurrent_streams = " << conf->GetGrpcServerMaxConcurrentStreams();
     builder.AddListeningPort(_addr, grpc::InsecureServerCredentials());
     builder.RegisterService(grpcService.get()); // 注册服务接收器
     grpcServer = builder.BuildAndStart();
@@ -308,6 +553,16 @@ bool Application::ConfigUpdate()
         }
     }
 
+    // 粗排模型
+    if (app->conf->GetPreRankSwitch())
+    {
+        if (!PreRank::GetInstance()->LoadModel(app->conf->GetPreRankModelPath()))
+        {
+            LOG(ERROR) << "PreRank LoadModel Error, Model Path = " << app->conf->GetPreRankModelPath();
+            return false;
+        }
+    }
+
     // 展控
     {
         std::string jsonData;
@@ -326,15 +581,130 @@ bool Application::ConfigUpdate()
         }
     }
 
+    // 阶段预算
+    {
+        std::string jsonData;
+        Common::FastReadFile(Common::ConfigPath_Budget, jsonData, false);
+        if (jsonData.empty())
+        {
+            LOG(ERROR) << "ConfigUpdate() read file: " << Common::ConfigPath_Budget << " empty.";
+            return false;
+        }
+
+        if (!StageBudgetConfig::GetInstance()->UpdateJson(jsonData))
+        {
+            LOG(ERROR) << "StageBudgetConfig UpdateJson Error, Config Path = " << Common::ConfigPath_Budget
+                       << ", jsonData : " << jsonData;
+            return false;
+        }
+    }
+
+    // 全部更新成功后发布配置快照, 任一失败时请求继续使用上一份快照
+    if (!ConfigSnapshot::Publish())
+    {
+        LOG(ERROR) << "ConfigUpdate() Publish Config Snapshot Error.";
+        return false;
+    }
+
     return true;
 }
 
+void Application::RegisterMonitorMetrics()
+{
+    auto monitor = Monitor::GetInstance();
+    const auto counter = Monitor::PullType::Counter;
+
+    // 缓存命中
+    monitor->RegisterPull("algocenter_cache_hit_total", "Local cache hits", counter, {{"cache", "ItemFeatureCache"}},
+                          []()
+                          { return (double)RedisProtoData::GetItemFeatureCacheStatis().hit_count; });
+    monitor->RegisterPull("algocenter_cache_miss_total", "Local cache misses", counter, {{"cache", "ItemFeatureCache"}},
+                          []()
+                          { return (double)RedisProtoData::GetItemFeatureCacheStatis().miss_count; });
+    monitor->RegisterPull("algocenter_cache_hit_total", "Local cache hits", counter, {{"cache", "SingleInvertIndexCache"}},
+                          []()
+                          { return (double)RedisProtoData::GetSingleInvertIndexCacheStatis().hit_count; });
+    monitor->RegisterPull("algocenter_cache_miss_total", "Local cache misses", counter, {{"cache", "SingleInvertIndexCache"}},
+                          []()
+                          { return (double)RedisProtoData::GetSingleInvertIndexCacheStatis().miss_count; });
+    monitor->RegisterPull("algocenter_cache_hit_total", "Local cache hits", counter, {{"cache", "AnnoyIndexCache"}},
+                          []()
+                          { return (double)AnnoyIndexCache::GetInstance()->GetQueryHitCount(); });
+    monitor->RegisterPull("algocenter_cache_miss_total", "Local cache misses", counter, {{"cache", "AnnoyIndexCache"}},
+                          []()
+                          { return (double)AnnoyIndexCache::GetInstance()->GetQueryMissCount(); });
+    monitor->RegisterPull("algocenter_cache_hit_total", "Local cache hits", counter, {{"cache", "DownloadSetCache"}},
+                          []()
+                          { return (double)DownloadSetCache::GetInstance()->GetHitCount(); });
+    monitor->RegisterPull("algocenter_cache_miss_total", "Local cache misses", counter, {{"cache", "DownloadSetCache"}},
+                          []()
+                          { return (double)DownloadSetCache::GetInstance()->GetMissCount(); });
+    monitor->RegisterPull("algocenter_cache_hit_total", "Local cache hits", counter, {{"cache", "SessionCache"}},
+                          []()
+                          { return (double)SessionCache::GetInstance()->GetHitCount(); });
+    monitor->RegisterPull("algocenter_cache_miss_total", "Local cache misses", counter, {{"cache", "SessionCache"}},
+                          []()
+                          { return (double)SessionCache::GetInstance()->GetMissCount(); });
+
+    // 准入控制
+    monitor->RegisterPull("algocenter_admission_total", "Admission decisions", counter, {{"decision", "admit"}},
+                          []()
+                          { return (double)AdmissionControl::GetInstance()->GetAdmitCount(); });
+    monitor->RegisterPull("algocenter_admission_total", "Admission decisions", counter, {{"decision", "degrade"}},
+                          []()
+                          { return (double)AdmissionControl::GetInstance()->GetDegradeCount(); });
+    monitor->RegisterPull("algocenter_admission_total", "Admission decisions", counter, {{"decision", "shed"}},
+                          []()
+                          { return (double)AdmissionControl::GetInstance()->GetShedCount(); });
+
+    // 在途请求合并
+    monitor->RegisterPull("algocenter_coalesce_total", "Coalesced duplicate requests", counter, {{"result", "coalesced"}},
+                          []()
+                          { return (double)RequestCoalescer::GetInstance()->GetCoalescedCount(); });
+    monitor->RegisterPull("algocenter_coalesce_total", "Coalesced duplicate requests", counter, {{"result", "timeout"}},
+                          []()
+                          { return (double)RequestCoalescer::GetInstance()->GetTimeoutCount(); });
+
+    // 降级
+    static const std::vector<std::pair<DegradeFlag, std::string>> s_vecDegradeFlag = {
+        {Degrade_Admission, "admission"},
+        {Degrade_RecallSkip, "recall_skip"},
+        {Degrade_RankTrunc, "rank_trunc"},
+        {Degrade_ScatterSkip, "scatter_skip"},
+    };
+    for (const auto &flag_name : s_vecDegradeFlag)
+    {
+        DegradeFlag flag = flag_name.first;
+        monitor->RegisterPull("algocenter_degrade_total", "Requests by degradation", counter, {{"degrade", flag_name.second}},
+                              [flag]()
+                              { return (double)DegradeStatis::GetInstance()->GetDegradeCount(flag); });
+    }
+
+    // 请求级内存池
+    monitor->RegisterPull("algocenter_request_arena_max_bytes", "Max request arena used bytes", Monitor::PullType::Gauge, {},
+                          []()
+                          { return (double)RequestArena::GetMaxUsedBytes(); });
+
+    // 统计聚合窗口摘要, 通过 /statis 查询
+    if (StatisAggregator::GetInstance()->IsInit())
+    {
+        StatisAggregator::GetInstance()->RegisterMonitor();
+    }
+}
+
 bool Application::Shutdown()
 {
-    grpcService = nullptr;                     // 清理服务接收器
-    RegisterCenter::GetInstance()->ShutDown(); // 停止客户端管理
-    RedisProtoData::ShutDownCache();           // 停止数据模块更新服务
-    RedisProtoData::ShutDownConnectPool();     // 停止连接池任务
+    grpcService = nullptr;                        // 清理服务接收器
+    RegisterCenter::GetInstance()->ShutDown();    // 停止客户端管理
+    RankBatcher::GetInstance()->ShutDown();       // 停止排序工作线程
+    Monitor::GetInstance()->ShutDown();           // 停止指标暴露
+    Tracer::GetInstance()->ShutDown();            // 写完剩余追踪数据
+    Recorder::GetInstance()->ShutDown();          // 写完剩余录制数据
+    SampleLogPipeline::GetInstance()->ShutDown(); // 推送剩余样本日志
+    StatisAggregator::GetInstance()->ShutDown();  // 输出剩余统计窗口
+    CatalogBitmap::GetInstance()->ShutDown();     // 停止上架位图刷新
+    RedisProtoData::ShutDownCache();              // 停止数据模块更新服务
+    RedisProtoData::ShutDownConnectPool();        // 停止连接池任务
     return true;
 }
 
@@ -42,6 +42,10 @@ public:
 
     bool ConfigUpdate();
 
+private:
+    // 注册拉取型监控指标
+    void RegisterMonitorMetrics();
+
 public:
     std::shared_ptr<Config> conf = nullptr;
     std::shared_ptr<AlgoCenter> algoCenter = nullptr;
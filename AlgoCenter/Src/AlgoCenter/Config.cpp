@@ -90,6 +90,90 @@ Config::Error Config::DecodeJsonData(const std::string &jsonData, const std::str
         return cfgErr;
     }
 
+    cfgErr = DecodeRankBatchConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodePreRankConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeDownloadFilterCacheConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeExposureConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeCatalogBitmapConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeGrpcServerConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeAdmissionConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeRequestArenaConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeMonitorConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeTraceConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeStatisConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeRecordConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeSessionCacheConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    cfgErr = DecodeCoalesceConfig(doc, idx);
+    if (cfgErr != Config::Error::OK)
+    {
+        return cfgErr;
+    }
+
     m_dataIdx = idx;
 
     return Config::Error::OK;
@@ -397,6 +481,38 @@ Config::Error Config::DecodeKafkaPushConfig(rapidjson::Document &doc, int dataId
     }
     m_data[dataIdx].m_KafkaPushTopic = std::string(tdKafka["Topic"].GetString());
 
+    // QueueSize
+    if (!tdKafka.HasMember("QueueSize") || !tdKafka["QueueSize"].IsInt())
+    {
+        LOG(ERROR) << "DecodeKafkaPushConfig() Parse jsonData Not Find QueueSize.";
+        return Config::Error::DecodeKafkaPushConfigError;
+    }
+    m_data[dataIdx].m_KafkaPushQueueSize = tdKafka["QueueSize"].GetInt();
+
+    // BatchNum
+    if (!tdKafka.HasMember("BatchNum") || !tdKafka["BatchNum"].IsInt())
+    {
+        LOG(ERROR) << "DecodeKafkaPushConfig() Parse jsonData Not Find BatchNum.";
+        return Config::Error::DecodeKafkaPushConfigError;
+    }
+    m_data[dataIdx].m_KafkaPushBatchNum = tdKafka["BatchNum"].GetInt();
+
+    // BatchWaitMs
+    if (!tdKafka.HasMember("BatchWaitMs") || !tdKafka["BatchWaitMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeKafkaPushConfig() Parse jsonData Not Find BatchWaitMs.";
+        return Config::Error::DecodeKafkaPushConfigError;
+    }
+    m_data[dataIdx].m_KafkaPushBatchWaitMs = tdKafka["BatchWaitMs"].GetInt();
+
+    // BinaryTopic
+    if (!tdKafka.HasMember("BinaryTopic") || !tdKafka["BinaryTopic"].IsString())
+    {
+        LOG(ERROR) << "DecodeKafkaPushConfig() Parse jsonData Not Find BinaryTopic.";
+        return Config::Error::DecodeKafkaPushConfigError;
+    }
+    m_data[dataIdx].m_KafkaPushBinaryTopic = std::string(tdKafka["BinaryTopic"].GetString());
+
     return Config::Error::OK;
 }
 
@@ -433,5 +549,589 @@ Config::Error Config::DecodeAnnoyConfig(rapidjson::Document &doc, int dataIdx)
     }
     m_data[dataIdx].m_AnnoySearchNodeNum = annoy["SearchNodeNum"].GetInt();
 
+    // IndexVectorSwitch
+    if (!annoy.HasMember("IndexVectorSwitch") || !annoy["IndexVectorSwitch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeAnnoyConfig() Parse jsonData Not Find IndexVectorSwitch.";
+        return Config::Error::DecodeAnnoyConfigError;
+    }
+    m_data[dataIdx].m_AnnoyIndexVectorSwitch = annoy["IndexVectorSwitch"].GetBool();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeRankBatchConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("RankBatch") || !doc["RankBatch"].IsObject())
+    {
+        LOG(ERROR) << "DecodeRankBatchConfig() Parse jsonData Not Find RankBatch.";
+        return Config::Error::DecodeRankBatchConfigError;
+    }
+    auto rankBatch = doc["RankBatch"].GetObject();
+
+    // Switch
+    if (!rankBatch.HasMember("Switch") || !rankBatch["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeRankBatchConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeRankBatchConfigError;
+    }
+    m_data[dataIdx].m_RankBatchSwitch = rankBatch["Switch"].GetBool();
+
+    // ThreadNum
+    if (!rankBatch.HasMember("ThreadNum") || !rankBatch["ThreadNum"].IsInt())
+    {
+        LOG(ERROR) << "DecodeRankBatchConfig() Parse jsonData Not Find ThreadNum.";
+        return Config::Error::DecodeRankBatchConfigError;
+    }
+    m_data[dataIdx].m_RankBatchThreadNum = rankBatch["ThreadNum"].GetInt();
+
+    // TimeoutMs
+    if (!rankBatch.HasMember("TimeoutMs") || !rankBatch["TimeoutMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeRankBatchConfig() Parse jsonData Not Find TimeoutMs.";
+        return Config::Error::DecodeRankBatchConfigError;
+    }
+    m_data[dataIdx].m_RankBatchTimeoutMs = rankBatch["TimeoutMs"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodePreRankConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("PreRank") || !doc["PreRank"].IsObject())
+    {
+        LOG(ERROR) << "DecodePreRankConfig() Parse jsonData Not Find PreRank.";
+        return Config::Error::DecodePreRankConfigError;
+    }
+    auto preRank = doc["PreRank"].GetObject();
+
+    // Switch
+    if (!preRank.HasMember("Switch") || !preRank["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodePreRankConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodePreRankConfigError;
+    }
+    m_data[dataIdx].m_PreRankSwitch = preRank["Switch"].GetBool();
+
+    // ModelPath
+    if (!preRank.HasMember("ModelPath") || !preRank["ModelPath"].IsString())
+    {
+        LOG(ERROR) << "DecodePreRankConfig() Parse jsonData Not Find ModelPath.";
+        return Config::Error::DecodePreRankConfigError;
+    }
+    m_data[dataIdx].m_PreRankModelPath = std::string(preRank["ModelPath"].GetString());
+
+    // TruncCount
+    if (!preRank.HasMember("TruncCount") || !preRank["TruncCount"].IsInt())
+    {
+        LOG(ERROR) << "DecodePreRankConfig() Parse jsonData Not Find TruncCount.";
+        return Config::Error::DecodePreRankConfigError;
+    }
+    m_data[dataIdx].m_PreRankTruncCount = preRank["TruncCount"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeDownloadFilterCacheConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("DownloadFilterCache") || !doc["DownloadFilterCache"].IsObject())
+    {
+        LOG(ERROR) << "DecodeDownloadFilterCacheConfig() Parse jsonData Not Find DownloadFilterCache.";
+        return Config::Error::DecodeDownloadFilterCacheConfigError;
+    }
+    auto downloadFilterCache = doc["DownloadFilterCache"].GetObject();
+
+    // Switch
+    if (!downloadFilterCache.HasMember("Switch") || !downloadFilterCache["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeDownloadFilterCacheConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeDownloadFilterCacheConfigError;
+    }
+    m_data[dataIdx].m_DownloadFilterCacheSwitch = downloadFilterCache["Switch"].GetBool();
+
+    // Capacity
+    if (!downloadFilterCache.HasMember("Capacity") || !downloadFilterCache["Capacity"].IsInt())
+    {
+        LOG(ERROR) << "DecodeDownloadFilterCacheConfig() Parse jsonData Not Find Capacity.";
+        return Config::Error::DecodeDownloadFilterCacheConfigError;
+    }
+    m_data[dataIdx].m_DownloadFilterCacheCapacity = downloadFilterCache["Capacity"].GetInt();
+
+    // TTLMs
+    if (!downloadFilterCache.HasMember("TTLMs") || !downloadFilterCache["TTLMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeDownloadFilterCacheConfig() Parse jsonData Not Find TTLMs.";
+        return Config::Error::DecodeDownloadFilterCacheConfigError;
+    }
+    m_data[dataIdx].m_DownloadFilterCacheTTLMs = downloadFilterCache["TTLMs"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeExposureConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("Exposure") || !doc["Exposure"].IsObject())
+    {
+        LOG(ERROR) << "DecodeExposureConfig() Parse jsonData Not Find Exposure.";
+        return Config::Error::DecodeExposureConfigError;
+    }
+    auto exposure = doc["Exposure"].GetObject();
+
+    // Switch
+    if (!exposure.HasMember("Switch") || !exposure["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeExposureConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeExposureConfigError;
+    }
+    m_data[dataIdx].m_ExposureSwitch = exposure["Switch"].GetBool();
+
+    // RingSize
+    if (!exposure.HasMember("RingSize") || !exposure["RingSize"].IsInt())
+    {
+        LOG(ERROR) << "DecodeExposureConfig() Parse jsonData Not Find RingSize.";
+        return Config::Error::DecodeExposureConfigError;
+    }
+    m_data[dataIdx].m_ExposureRingSize = exposure["RingSize"].GetInt();
+
+    // TTLSec
+    if (!exposure.HasMember("TTLSec") || !exposure["TTLSec"].IsInt())
+    {
+        LOG(ERROR) << "DecodeExposureConfig() Parse jsonData Not Find TTLSec.";
+        return Config::Error::DecodeExposureConfigError;
+    }
+    m_data[dataIdx].m_ExposureTTLSec = exposure["TTLSec"].GetInt();
+
+    // MemoryBudgetMB
+    if (!exposure.HasMember("MemoryBudgetMB") || !exposure["MemoryBudgetMB"].IsInt())
+    {
+        LOG(ERROR) << "DecodeExposureConfig() Parse jsonData Not Find MemoryBudgetMB.";
+        return Config::Error::DecodeExposureConfigError;
+    }
+    m_data[dataIdx].m_ExposureMemoryBudgetMB = exposure["MemoryBudgetMB"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeCatalogBitmapConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("CatalogBitmap") || !doc["CatalogBitmap"].IsObject())
+    {
+        LOG(ERROR) << "DecodeCatalogBitmapConfig() Parse jsonData Not Find CatalogBitmap.";
+        return Config::Error::DecodeCatalogBitmapConfigError;
+    }
+    auto catalogBitmap = doc["CatalogBitmap"].GetObject();
+
+    // Switch
+    if (!catalogBitmap.HasMember("Switch") || !catalogBitmap["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeCatalogBitmapConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeCatalogBitmapConfigError;
+    }
+    m_data[dataIdx].m_CatalogBitmapSwitch = catalogBitmap["Switch"].GetBool();
+
+    // RedisName
+    if (!catalogBitmap.HasMember("RedisName") || !catalogBitmap["RedisName"].IsString())
+    {
+        LOG(ERROR) << "DecodeCatalogBitmapConfig() Parse jsonData Not Find RedisName.";
+        return Config::Error::DecodeCatalogBitmapConfigError;
+    }
+    m_data[dataIdx].m_CatalogBitmapRedisName = std::string(catalogBitmap["RedisName"].GetString());
+
+    // RedisKey
+    if (!catalogBitmap.HasMember("RedisKey") || !catalogBitmap["RedisKey"].IsString())
+    {
+        LOG(ERROR) << "DecodeCatalogBitmapConfig() Parse jsonData Not Find RedisKey.";
+        return Config::Error::DecodeCatalogBitmapConfigError;
+    }
+    m_data[dataIdx].m_CatalogBitmapRedisKey = std::string(catalogBitmap["RedisKey"].GetString());
+
+    // SnapshotPath
+    if (!catalogBitmap.HasMember("SnapshotPath") || !catalogBitmap["SnapshotPath"].IsString())
+    {
+        LOG(ERROR) << "DecodeCatalogBitmapConfig() Parse jsonData Not Find SnapshotPath.";
+        return Config::Error::DecodeCatalogBitmapConfigError;
+    }
+    m_data[dataIdx].m_CatalogBitmapSnapshotPath = std::string(catalogBitmap["SnapshotPath"].GetString());
+
+    // RefreshSec
+    if (!catalogBitmap.HasMember("RefreshSec") || !catalogBitmap["RefreshSec"].IsInt())
+    {
+        LOG(ERROR) << "DecodeCatalogBitmapConfig() Parse jsonData Not Find RefreshSec.";
+        return Config::Error::DecodeCatalogBitmapConfigError;
+    }
+    m_data[dataIdx].m_CatalogBitmapRefreshSec = catalogBitmap["RefreshSec"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeGrpcServerConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("GrpcServer") || !doc["GrpcServer"].IsObject())
+    {
+        LOG(ERROR) << "DecodeGrpcServerConfig() Parse jsonData Not Find GrpcServer.";
+        return Config::Error::DecodeGrpcServerConfigError;
+    }
+    auto grpcServer = doc["GrpcServer"].GetObject();
+
+    // CqNum
+    if (!grpcServer.HasMember("CqNum") || !grpcServer["CqNum"].IsInt())
+    {
+        LOG(ERROR) << "DecodeGrpcServerConfig() Parse jsonData Not Find CqNum.";
+        return Config::Error::DecodeGrpcServerConfigError;
+    }
+    m_data[dataIdx].m_GrpcServerCqNum = grpcServer["CqNum"].GetInt();
+
+    // MinPollers
+    if (!grpcServer.HasMember("MinPollers") || !grpcServer["MinPollers"].IsInt())
+    {
+        LOG(ERROR) << "DecodeGrpcServerConfig() Parse jsonData Not Find MinPollers.";
+        return Config::Error::DecodeGrpcServerConfigError;
+    }
+    m_data[dataIdx].m_GrpcServerMinPollers = grpcServer["MinPollers"].GetInt();
+
+    // MaxPollers
+    if (!grpcServer.HasMember("MaxPollers") || !grpcServer["MaxPollers"].IsInt())
+    {
+        LOG(ERROR) << "DecodeGrpcServerConfig() Parse jsonData Not Find MaxPollers.";
+        return Config::Error::DecodeGrpcServerConfigError;
+    }
+    m_data[dataIdx].m_GrpcServerMaxPollers = grpcServer["MaxPollers"].GetInt();
+
+    // MaxThreads
+    if (!grpcServer.HasMember("MaxThreads") || !grpcServer["MaxThreads"].IsInt())
+    {
+        LOG(ERROR) << "DecodeGrpcServerConfig() Parse jsonData Not Find MaxThreads.";
+        return Config::Error::DecodeGrpcServerConfigError;
+    }
+    m_data[dataIdx].m_GrpcServerMaxThreads = grpcServer["MaxThreads"].GetInt();
+
+    // MaxConcurrentStreams
+    if (!grpcServer.HasMember("MaxConcurrentStreams") || !grpcServer["MaxConcurrentStreams"].IsInt())
+    {
+        LOG(ERROR) << "DecodeGrpcServerConfig() Parse jsonData Not Find MaxConcurrentStreams.";
+        return Config::Error::DecodeGrpcServerConfigError;
+    }
+    m_data[dataIdx].m_GrpcServerMaxConcurrentStreams = grpcServer["MaxConcurrentStreams"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeAdmissionConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("Admission") || !doc["Admission"].IsObject())
+    {
+        LOG(ERROR) << "DecodeAdmissionConfig() Parse jsonData Not Find Admission.";
+        return Config::Error::DecodeAdmissionConfigError;
+    }
+    auto admission = doc["Admission"].GetObject();
+
+    // Switch
+    if (!admission.HasMember("Switch") || !admission["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeAdmissionConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeAdmissionConfigError;
+    }
+    m_data[dataIdx].m_AdmissionSwitch = admission["Switch"].GetBool();
+
+    // MaxInflight
+    if (!admission.HasMember("MaxInflight") || !admission["MaxInflight"].IsInt())
+    {
+        LOG(ERROR) << "DecodeAdmissionConfig() Parse jsonData Not Find MaxInflight.";
+        return Config::Error::DecodeAdmissionConfigError;
+    }
+    m_data[dataIdx].m_AdmissionMaxInflight = admission["MaxInflight"].GetInt();
+
+    // MaxQueueMs
+    if (!admission.HasMember("MaxQueueMs") || !admission["MaxQueueMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeAdmissionConfig() Parse jsonData Not Find MaxQueueMs.";
+        return Config::Error::DecodeAdmissionConfigError;
+    }
+    m_data[dataIdx].m_AdmissionMaxQueueMs = admission["MaxQueueMs"].GetInt();
+
+    // CoDelTargetMs
+    if (!admission.HasMember("CoDelTargetMs") || !admission["CoDelTargetMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeAdmissionConfig() Parse jsonData Not Find CoDelTargetMs.";
+        return Config::Error::DecodeAdmissionConfigError;
+    }
+    m_data[dataIdx].m_AdmissionCoDelTargetMs = admission["CoDelTargetMs"].GetInt();
+
+    // CoDelIntervalMs
+    if (!admission.HasMember("CoDelIntervalMs") || !admission["CoDelIntervalMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeAdmissionConfig() Parse jsonData Not Find CoDelIntervalMs.";
+        return Config::Error::DecodeAdmissionConfigError;
+    }
+    m_data[dataIdx].m_AdmissionCoDelIntervalMs = admission["CoDelIntervalMs"].GetInt();
+
+    // EstimateRatio
+    if (!admission.HasMember("EstimateRatio") || !admission["EstimateRatio"].IsInt())
+    {
+        LOG(ERROR) << "DecodeAdmissionConfig() Parse jsonData Not Find EstimateRatio.";
+        return Config::Error::DecodeAdmissionConfigError;
+    }
+    m_data[dataIdx].m_AdmissionEstimateRatio = admission["EstimateRatio"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeRequestArenaConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("RequestArena") || !doc["RequestArena"].IsObject())
+    {
+        LOG(ERROR) << "DecodeRequestArenaConfig() Parse jsonData Not Find RequestArena.";
+        return Config::Error::DecodeRequestArenaConfigError;
+    }
+    auto requestArena = doc["RequestArena"].GetObject();
+
+    // Switch
+    if (!requestArena.HasMember("Switch") || !requestArena["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeRequestArenaConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeRequestArenaConfigError;
+    }
+    m_data[dataIdx].m_RequestArenaSwitch = requestArena["Switch"].GetBool();
+
+    // InitialBlockKB
+    if (!requestArena.HasMember("InitialBlockKB") || !requestArena["InitialBlockKB"].IsInt())
+    {
+        LOG(ERROR) << "DecodeRequestArenaConfig() Parse jsonData Not Find InitialBlockKB.";
+        return Config::Error::DecodeRequestArenaConfigError;
+    }
+    m_data[dataIdx].m_RequestArenaInitialBlockKB = requestArena["InitialBlockKB"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeMonitorConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("Monitor") || !doc["Monitor"].IsObject())
+    {
+        LOG(ERROR) << "DecodeMonitorConfig() Parse jsonData Not Find Monitor.";
+        return Config::Error::DecodeMonitorConfigError;
+    }
+    auto monitor = doc["Monitor"].GetObject();
+
+    // Switch
+    if (!monitor.HasMember("Switch") || !monitor["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeMonitorConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeMonitorConfigError;
+    }
+    m_data[dataIdx].m_MonitorSwitch = monitor["Switch"].GetBool();
+
+    // BindAddr
+    if (!monitor.HasMember("BindAddr") || !monitor["BindAddr"].IsString())
+    {
+        LOG(ERROR) << "DecodeMonitorConfig() Parse jsonData Not Find BindAddr.";
+        return Config::Error::DecodeMonitorConfigError;
+    }
+    m_data[dataIdx].m_MonitorBindAddr = std::string(monitor["BindAddr"].GetString());
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeTraceConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("Trace") || !doc["Trace"].IsObject())
+    {
+        LOG(ERROR) << "DecodeTraceConfig() Parse jsonData Not Find Trace.";
+        return Config::Error::DecodeTraceConfigError;
+    }
+    auto trace = doc["Trace"].GetObject();
+
+    // Switch
+    if (!trace.HasMember("Switch") || !trace["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeTraceConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeTraceConfigError;
+    }
+    m_data[dataIdx].m_TraceSwitch = trace["Switch"].GetBool();
+
+    // FilePath
+    if (!trace.HasMember("FilePath") || !trace["FilePath"].IsString())
+    {
+        LOG(ERROR) << "DecodeTraceConfig() Parse jsonData Not Find FilePath.";
+        return Config::Error::DecodeTraceConfigError;
+    }
+    m_data[dataIdx].m_TraceFilePath = std::string(trace["FilePath"].GetString());
+
+    // MaxFileMB
+    if (!trace.HasMember("MaxFileMB") || !trace["MaxFileMB"].IsInt())
+    {
+        LOG(ERROR) << "DecodeTraceConfig() Parse jsonData Not Find MaxFileMB.";
+        return Config::Error::DecodeTraceConfigError;
+    }
+    m_data[dataIdx].m_TraceMaxFileMB = trace["MaxFileMB"].GetInt();
+
+    // MaxFileNum
+    if (!trace.HasMember("MaxFileNum") || !trace["MaxFileNum"].IsInt())
+    {
+        LOG(ERROR) << "DecodeTraceConfig() Parse jsonData Not Find MaxFileNum.";
+        return Config::Error::DecodeTraceConfigError;
+    }
+    m_data[dataIdx].m_TraceMaxFileNum = trace["MaxFileNum"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeStatisConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("Statis") || !doc["Statis"].IsObject())
+    {
+        LOG(ERROR) << "DecodeStatisConfig() Parse jsonData Not Find Statis.";
+        return Config::Error::DecodeStatisConfigError;
+    }
+    auto statis = doc["Statis"].GetObject();
+
+    // Aggregate
+    if (!statis.HasMember("Aggregate") || !statis["Aggregate"].IsBool())
+    {
+        LOG(ERROR) << "DecodeStatisConfig() Parse jsonData Not Find Aggregate.";
+        return Config::Error::DecodeStatisConfigError;
+    }
+    m_data[dataIdx].m_StatisAggregate = statis["Aggregate"].GetBool();
+
+    // LegacyLog
+    if (!statis.HasMember("LegacyLog") || !statis["LegacyLog"].IsBool())
+    {
+        LOG(ERROR) << "DecodeStatisConfig() Parse jsonData Not Find LegacyLog.";
+        return Config::Error::DecodeStatisConfigError;
+    }
+    m_data[dataIdx].m_StatisLegacyLog = statis["LegacyLog"].GetBool();
+
+    // WindowSec
+    if (!statis.HasMember("WindowSec") || !statis["WindowSec"].IsInt())
+    {
+        LOG(ERROR) << "DecodeStatisConfig() Parse jsonData Not Find WindowSec.";
+        return Config::Error::DecodeStatisConfigError;
+    }
+    m_data[dataIdx].m_StatisWindowSec = statis["WindowSec"].GetInt();
+
+    // DiversityPos
+    if (!statis.HasMember("DiversityPos") || !statis["DiversityPos"].IsInt())
+    {
+        LOG(ERROR) << "DecodeStatisConfig() Parse jsonData Not Find DiversityPos.";
+        return Config::Error::DecodeStatisConfigError;
+    }
+    m_data[dataIdx].m_StatisDiversityPos = statis["DiversityPos"].GetInt();
+
+    // DiversityTopItem
+    if (!statis.HasMember("DiversityTopItem") || !statis["DiversityTopItem"].IsInt())
+    {
+        LOG(ERROR) << "DecodeStatisConfig() Parse jsonData Not Find DiversityTopItem.";
+        return Config::Error::DecodeStatisConfigError;
+    }
+    m_data[dataIdx].m_StatisDiversityTopItem = statis["DiversityTopItem"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeRecordConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("Record") || !doc["Record"].IsObject())
+    {
+        LOG(ERROR) << "DecodeRecordConfig() Parse jsonData Not Find Record.";
+        return Config::Error::DecodeRecordConfigError;
+    }
+    auto record = doc["Record"].GetObject();
+
+    // Switch
+    if (!record.HasMember("Switch") || !record["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeRecordConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeRecordConfigError;
+    }
+    m_data[dataIdx].m_RecordSwitch = record["Switch"].GetBool();
+
+    // FilePath
+    if (!record.HasMember("FilePath") || !record["FilePath"].IsString())
+    {
+        LOG(ERROR) << "DecodeRecordConfig() Parse jsonData Not Find FilePath.";
+        return Config::Error::DecodeRecordConfigError;
+    }
+    m_data[dataIdx].m_RecordFilePath = std::string(record["FilePath"].GetString());
+
+    // SampleRate
+    if (!record.HasMember("SampleRate") || !record["SampleRate"].IsInt())
+    {
+        LOG(ERROR) << "DecodeRecordConfig() Parse jsonData Not Find SampleRate.";
+        return Config::Error::DecodeRecordConfigError;
+    }
+    m_data[dataIdx].m_RecordSampleRate = record["SampleRate"].GetInt();
+
+    // MaxFileMB
+    if (!record.HasMember("MaxFileMB") || !record["MaxFileMB"].IsInt())
+    {
+        LOG(ERROR) << "DecodeRecordConfig() Parse jsonData Not Find MaxFileMB.";
+        return Config::Error::DecodeRecordConfigError;
+    }
+    m_data[dataIdx].m_RecordMaxFileMB = record["MaxFileMB"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeSessionCacheConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("SessionCache") || !doc["SessionCache"].IsObject())
+    {
+        LOG(ERROR) << "DecodeSessionCacheConfig() Parse jsonData Not Find SessionCache.";
+        return Config::Error::DecodeSessionCacheConfigError;
+    }
+    auto sessionCache = doc["SessionCache"].GetObject();
+
+    // Switch
+    if (!sessionCache.HasMember("Switch") || !sessionCache["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeSessionCacheConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeSessionCacheConfigError;
+    }
+    m_data[dataIdx].m_SessionCacheSwitch = sessionCache["Switch"].GetBool();
+
+    // TTLMs
+    if (!sessionCache.HasMember("TTLMs") || !sessionCache["TTLMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeSessionCacheConfig() Parse jsonData Not Find TTLMs.";
+        return Config::Error::DecodeSessionCacheConfigError;
+    }
+    m_data[dataIdx].m_SessionCacheTTLMs = sessionCache["TTLMs"].GetInt();
+
+    // MemoryBudgetMB
+    if (!sessionCache.HasMember("MemoryBudgetMB") || !sessionCache["MemoryBudgetMB"].IsInt())
+    {
+        LOG(ERROR) << "DecodeSessionCacheConfig() Parse jsonData Not Find MemoryBudgetMB.";
+        return Config::Error::DecodeSessionCacheConfigError;
+    }
+    m_data[dataIdx].m_SessionCacheMemoryBudgetMB = sessionCache["MemoryBudgetMB"].GetInt();
+
+    return Config::Error::OK;
+}
+
+Config::Error Config::DecodeCoalesceConfig(rapidjson::Document &doc, int dataIdx)
+{
+    if (!doc.HasMember("Coalesce") || !doc["Coalesce"].IsObject())
+    {
+        LOG(ERROR) << "DecodeCoalesceConfig() Parse jsonData Not Find Coalesce.";
+        return Config::Error::DecodeCoalesceConfigError;
+    }
+    auto coalesce = doc["Coalesce"].GetObject();
+
+    // Switch
+    if (!coalesce.HasMember("Switch") || !coalesce["Switch"].IsBool())
+    {
+        LOG(ERROR) << "DecodeCoalesceConfig() Parse jsonData Not Find Switch.";
+        return Config::Error::DecodeCoalesceConfigError;
+    }
+    m_data[dataIdx].m_CoalesceSwitch = coalesce["Switch"].GetBool();
+
+    // MaxWaitMs
+    if (!coalesce.HasMember("MaxWaitMs") || !coalesce["MaxWaitMs"].IsInt())
+    {
+        LOG(ERROR) << "DecodeCoalesceConfig() Parse jsonData Not Find MaxWaitMs.";
+        return Config::Error::DecodeCoalesceConfigError;
+    }
+    m_data[dataIdx].m_CoalesceMaxWaitMs = coalesce["MaxWaitMs"].GetInt();
+
     return Config::Error::OK;
 }
@@ -43,14 +43,98 @@ struct ConfigData
 
     // Kafka推送配置
     TDKafkaConfig m_KafkaConf;
-    bool m_KafkaPushSwitch = false;    // 推送开关
-    int m_KafkaPushThreadNum = 0;      // 推送线程数量
-    std::string m_KafkaPushTopic = ""; // 推送Topic
+    bool m_KafkaPushSwitch = false;          // 推送开关
+    int m_KafkaPushThreadNum = 0;            // 推送线程数量
+    std::string m_KafkaPushTopic = "";       // 推送Topic
+    int m_KafkaPushQueueSize = 0;            // 样本日志队列长度, 队列满时丢弃
+    int m_KafkaPushBatchNum = 0;             // 单条Kafka消息合并的记录数
+    int m_KafkaPushBatchWaitMs = 0;          // 攒批最长等待时间(ms)
+    std::string m_KafkaPushBinaryTopic = ""; // 二进制样本日志Topic, 为空时按原 JSON 格式推送到 Topic
 
     // Annoy配置
     std::string m_AnnoyBasicPath;
     int m_AnnoyEmbDimension;
     int m_AnnoySearchNodeNum = 0;
+    bool m_AnnoyIndexVectorSwitch = false; // 物料向量从索引读取, 不保留浮点副本
+
+    // 排序工作线程池配置
+    bool m_RankBatchSwitch = false; // 开关
+    int m_RankBatchThreadNum = 0;   // 工作线程数量
+    int m_RankBatchTimeoutMs = 0;   // 调用方等待超时(毫秒), 超时降级
+
+    // 粗排配置
+    bool m_PreRankSwitch = false;        // 粗排开关
+    std::string m_PreRankModelPath = ""; // 粗排模型文件路径
+    int m_PreRankTruncCount = 0;         // 粗排截断数量
+
+    // 下载过滤集合缓存配置
+    bool m_DownloadFilterCacheSwitch = false; // 缓存开关
+    int m_DownloadFilterCacheCapacity = 0;    // 缓存用户集合总数
+    int m_DownloadFilterCacheTTLMs = 0;       // 缓存有效期(毫秒)
+
+    // 近期曝光存储配置
+    bool m_ExposureSwitch = false;    // 曝光记录开关
+    int m_ExposureRingSize = 0;       // 每个用户保留的最近曝光数量
+    int m_ExposureTTLSec = 0;         // 曝光有效期(秒)
+    int m_ExposureMemoryBudgetMB = 0; // 内存预算(MB)
+
+    // 物料上架位图配置
+    bool m_CatalogBitmapSwitch = false;           // 位图剔除开关
+    std::string m_CatalogBitmapRedisName = "";    // Redis 连接名
+    std::string m_CatalogBitmapRedisKey = "";     // 位图 Redis Key
+    std::string m_CatalogBitmapSnapshotPath = ""; // 本地快照文件路径
+    int m_CatalogBitmapRefreshSec = 0;            // 刷新间隔(秒)
+
+    // gRPC服务配置
+    int m_GrpcServerCqNum = 0;                // 同步服务完成队列数量, 0 表示gRPC默认
+    int m_GrpcServerMinPollers = 0;           // 每个完成队列最少轮询线程数, 0 表示gRPC默认
+    int m_GrpcServerMaxPollers = 0;           // 每个完成队列最多轮询线程数, 0 表示gRPC默认
+    int m_GrpcServerMaxThreads = 0;           // 服务最大线程数, 0 表示不限制
+    int m_GrpcServerMaxConcurrentStreams = 0; // 单连接最大并发流, 0 表示默认
+
+    // 准入控制配置
+    bool m_AdmissionSwitch = false;     // 准入控制开关
+    int m_AdmissionMaxInflight = 0;     // 最大在途请求数
+    int m_AdmissionMaxQueueMs = 0;      // 最长排队时间(毫秒)
+    int m_AdmissionCoDelTargetMs = 0;   // CoDel目标排队时间(毫秒)
+    int m_AdmissionCoDelIntervalMs = 0; // CoDel观察窗口(毫秒)
+    int m_AdmissionEstimateRatio = 0;   // 耗时估计放大比例(百分比)
+
+    // 请求级内存池配置
+    bool m_RequestArenaSwitch = false;    // 请求级内存池开关
+    int m_RequestArenaInitialBlockKB = 0; // 首块内存大小(KB)
+
+    // 监控指标配置
+    bool m_MonitorSwitch = false;       // 监控指标开关
+    std::string m_MonitorBindAddr = ""; // 指标监听地址
+
+    // 链路追踪配置
+    bool m_TraceSwitch = false;       // 链路追踪开关, 采样跟随统计日志
+    std::string m_TraceFilePath = ""; // 追踪文件路径
+    int m_TraceMaxFileMB = 0;         // 单个追踪文件大小上限(MB)
+    int m_TraceMaxFileNum = 0;        // 保留的滚动文件个数
+
+    // 统计聚合配置
+    bool m_StatisAggregate = false;   // 统计聚合开关
+    bool m_StatisLegacyLog = true;    // 保留逐请求统计日志
+    int m_StatisWindowSec = 0;        // 聚合窗口(秒)
+    int m_StatisDiversityPos = 0;     // 多样性统计推荐位数
+    int m_StatisDiversityTopItem = 0; // 多样性集中度头部物料数
+
+    // 流量录制配置
+    bool m_RecordSwitch = false;       // 流量录制开关
+    std::string m_RecordFilePath = ""; // 录制文件路径, 启动时覆盖
+    int m_RecordSampleRate = 0;        // 采样率, 万分比
+    int m_RecordMaxFileMB = 0;         // 录制文件大小上限(MB), 写满后停止录制
+
+    // 翻页会话缓存配置
+    bool m_SessionCacheSwitch = false;    // 翻页会话缓存开关
+    int m_SessionCacheTTLMs = 0;          // 会话有效期(毫秒)
+    int m_SessionCacheMemoryBudgetMB = 0; // 内存预算(MB)
+
+    // 在途请求合并配置
+    bool m_CoalesceSwitch = false; // 在途请求合并开关
+    int m_CoalesceMaxWaitMs = 0;   // 重复请求最长等待时间(毫秒), 超时后自行计算
 };
 
 class Config : public Singleton<Config>
@@ -69,6 +153,20 @@ public:
         DecodeTDKafkaConfigError,      // 解析TDKafka配置出错
         DecodeKafkaPushConfigError,    // 解析Kafka推送配置出错
         DecodeAnnoyConfigError,        // 解析Annoy配置出错
+        DecodeRankBatchConfigError,    // 解析排序线程池配置出错
+        DecodePreRankConfigError,      // 解析粗排配置出错
+        DecodeDownloadFilterCacheConfigError, // 解析下载过滤集合缓存配置出错
+        DecodeExposureConfigError,            // 解析近期曝光存储配置出错
+        DecodeCatalogBitmapConfigError,       // 解析物料上架位图配置出错
+        DecodeGrpcServerConfigError,          // 解析gRPC服务配置出错
+        DecodeAdmissionConfigError,           // 解析准入控制配置出错
+        DecodeRequestArenaConfigError,        // 解析请求级内存池配置出错
+        DecodeMonitorConfigError,             // 解析监控指标配置出错
+        DecodeTraceConfigError,               // 解析链路追踪配置出错
+        DecodeStatisConfigError,              // 解析统计聚合配置出错
+        DecodeRecordConfigError,              // 解析流量录制配置出错
+        DecodeSessionCacheConfigError,        // 解析翻页会话缓存配置出错
+        DecodeCoalesceConfigError,            // 解析在途请求合并配置出错
     } Error;
 
 public:
@@ -129,6 +227,26 @@ public:
         return m_data[m_dataIdx].m_AnnoyBasicPath;
     }
 
+    const int GetKafkaPushQueueSize() const noexcept
+    {
+        return m_data[m_dataIdx].m_KafkaPushQueueSize;
+    }
+
+    const int GetKafkaPushBatchNum() const noexcept
+    {
+        return m_data[m_dataIdx].m_KafkaPushBatchNum;
+    }
+
+    const int GetKafkaPushBatchWaitMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_KafkaPushBatchWaitMs;
+    }
+
+    std::string GetKafkaPushBinaryTopic() const noexcept
+    {
+        return m_data[m_dataIdx].m_KafkaPushBinaryTopic;
+    }
+
     const int GetAnnoyEmbDimension() const noexcept
     {
         return m_data[m_dataIdx].m_AnnoyEmbDimension;
@@ -139,6 +257,266 @@ public:
         return m_data[m_dataIdx].m_AnnoySearchNodeNum;
     }
 
+    const bool GetAnnoyIndexVectorSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_AnnoyIndexVectorSwitch;
+    }
+
+    const bool GetRankBatchSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_RankBatchSwitch;
+    }
+
+    const int GetRankBatchThreadNum() const noexcept
+    {
+        return m_data[m_dataIdx].m_RankBatchThreadNum;
+    }
+
+    const int GetRankBatchTimeoutMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_RankBatchTimeoutMs;
+    }
+
+    const bool GetPreRankSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_PreRankSwitch;
+    }
+
+    std::string GetPreRankModelPath() const noexcept
+    {
+        return m_data[m_dataIdx].m_PreRankModelPath;
+    }
+
+    const int GetPreRankTruncCount() const noexcept
+    {
+        return m_data[m_dataIdx].m_PreRankTruncCount;
+    }
+
+    const bool GetDownloadFilterCacheSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_DownloadFilterCacheSwitch;
+    }
+
+    const int GetDownloadFilterCacheCapacity() const noexcept
+    {
+        return m_data[m_dataIdx].m_DownloadFilterCacheCapacity;
+    }
+
+    const int GetDownloadFilterCacheTTLMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_DownloadFilterCacheTTLMs;
+    }
+
+    const bool GetExposureSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_ExposureSwitch;
+    }
+
+    const int GetExposureRingSize() const noexcept
+    {
+        return m_data[m_dataIdx].m_ExposureRingSize;
+    }
+
+    const int GetExposureTTLSec() const noexcept
+    {
+        return m_data[m_dataIdx].m_ExposureTTLSec;
+    }
+
+    const int GetExposureMemoryBudgetMB() const noexcept
+    {
+        return m_data[m_dataIdx].m_ExposureMemoryBudgetMB;
+    }
+
+    const bool GetCatalogBitmapSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_CatalogBitmapSwitch;
+    }
+
+    std::string GetCatalogBitmapRedisName() const noexcept
+    {
+        return m_data[m_dataIdx].m_CatalogBitmapRedisName;
+    }
+
+    std::string GetCatalogBitmapRedisKey() const noexcept
+    {
+        return m_data[m_dataIdx].m_CatalogBitmapRedisKey;
+    }
+
+    std::string GetCatalogBitmapSnapshotPath() const noexcept
+    {
+        return m_data[m_dataIdx].m_CatalogBitmapSnapshotPath;
+    }
+
+    const int GetCatalogBitmapRefreshSec() const noexcept
+    {
+        return m_data[m_dataIdx].m_CatalogBitmapRefreshSec;
+    }
+
+    const int GetGrpcServerCqNum() const noexcept
+    {
+        return m_data[m_dataIdx].m_GrpcServerCqNum;
+    }
+
+    const int GetGrpcServerMinPollers() const noexcept
+    {
+        return m_data[m_dataIdx].m_GrpcServerMinPollers;
+    }
+
+    const int GetGrpcServerMaxPollers() const noexcept
+    {
+        return m_data[m_dataIdx].m_GrpcServerMaxPollers;
+    }
+
+    const int GetGrpcServerMaxThreads() const noexcept
+    {
+        return m_data[m_dataIdx].m_GrpcServerMaxThreads;
+    }
+
+    const int GetGrpcServerMaxConcurrentStreams() const noexcept
+    {
+        return m_data[m_dataIdx].m_GrpcServerMaxConcurrentStreams;
+    }
+
+    const bool GetAdmissionSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_AdmissionSwitch;
+    }
+
+    const int GetAdmissionMaxInflight() const noexcept
+    {
+        return m_data[m_dataIdx].m_AdmissionMaxInflight;
+    }
+
+    const int GetAdmissionMaxQueueMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_AdmissionMaxQueueMs;
+    }
+
+    const int GetAdmissionCoDelTargetMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_AdmissionCoDelTargetMs;
+    }
+
+    const int GetAdmissionCoDelIntervalMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_AdmissionCoDelIntervalMs;
+    }
+
+    const int GetAdmissionEstimateRatio() const noexcept
+    {
+        return m_data[m_dataIdx].m_AdmissionEstimateRatio;
+    }
+
+    const bool GetRequestArenaSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_RequestArenaSwitch;
+    }
+
+    const int GetRequestArenaInitialBlockKB() const noexcept
+    {
+        return m_data[m_dataIdx].m_RequestArenaInitialBlockKB;
+    }
+
+    const bool GetMonitorSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_MonitorSwitch;
+    }
+
+    std::string GetMonitorBindAddr() const noexcept
+    {
+        return m_data[m_dataIdx].m_MonitorBindAddr;
+    }
+
+    const bool GetTraceSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_TraceSwitch;
+    }
+
+    std::string GetTraceFilePath() const noexcept
+    {
+        return m_data[m_dataIdx].m_TraceFilePath;
+    }
+
+    const int GetTraceMaxFileMB() const noexcept
+    {
+        return m_data[m_dataIdx].m_TraceMaxFileMB;
+    }
+
+    const int GetTraceMaxFileNum() const noexcept
+    {
+        return m_data[m_dataIdx].m_TraceMaxFileNum;
+    }
+
+    const bool GetStatisAggregate() const noexcept
+    {
+        return m_data[m_dataIdx].m_StatisAggregate;
+    }
+
+    const bool GetStatisLegacyLog() const noexcept
+    {
+        return m_data[m_dataIdx].m_StatisLegacyLog;
+    }
+
+    const int GetStatisWindowSec() const noexcept
+    {
+        return m_data[m_dataIdx].m_StatisWindowSec;
+    }
+
+    const int GetStatisDiversityPos() const noexcept
+    {
+        return m_data[m_dataIdx].m_StatisDiversityPos;
+    }
+
+    const int GetStatisDiversityTopItem() const noexcept
+    {
+        return m_data[m_dataIdx].m_StatisDiversityTopItem;
+    }
+
+    const bool GetRecordSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_RecordSwitch;
+    }
+
+    std::string GetRecordFilePath() const noexcept
+    {
+        return m_data[m_dataIdx].m_RecordFilePath;
+    }
+
+    const int GetRecordSampleRate() const noexcept
+    {
+        return m_data[m_dataIdx].m_RecordSampleRate;
+    }
+
+    const int GetRecordMaxFileMB() const noexcept
+    {
+        return m_data[m_dataIdx].m_RecordMaxFileMB;
+    }
+
+    const bool GetSessionCacheSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_SessionCacheSwitch;
+    }
+
+    const int GetSessionCacheTTLMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_SessionCacheTTLMs;
+    }
+
+    const int GetSessionCacheMemoryBudgetMB() const noexcept
+    {
+        return m_data[m_dataIdx].m_SessionCacheMemoryBudgetMB;
+    }
+
+    const bool GetCoalesceSwitch() const noexcept
+    {
+        return m_data[m_dataIdx].m_CoalesceSwitch;
+    }
+
+    const int GetCoalesceMaxWaitMs() const noexcept
+    {
+        return m_data[m_dataIdx].m_CoalesceMaxWaitMs;
+    }
+
     Config(token) { m_dataIdx = 0; }
     ~Config() {}
     Config(Config &) = delete;
@@ -155,6 +533,20 @@ protected:
     Config::Error DecodeTDKafkaConfig(rapidjson::Document &doc, int dataIdx);
     Config::Error DecodeKafkaPushConfig(rapidjson::Document &doc, int dataIdx);
     Config::Error DecodeAnnoyConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeRankBatchConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodePreRankConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeDownloadFilterCacheConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeExposureConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeCatalogBitmapConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeGrpcServerConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeAdmissionConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeRequestArenaConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeMonitorConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeTraceConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeStatisConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeRecordConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeSessionCacheConfig(rapidjson::Document &doc, int dataIdx);
+    Config::Error DecodeCoalesceConfig(rapidjson::Document &doc, int dataIdx);
 
 private:
     std::atomic<int> m_dataIdx = 0;
@@ -0,0 +1,27 @@
+#include "ConfigSnapshot.h"
+#include <atomic>
+#include "glog/logging.h"
+
+static std::shared_ptr<const ConfigSnapshot> s_spConfigSnapshot;
+
+std::shared_ptr<const ConfigSnapshot> ConfigSnapshot::Current()
+{
+    return std::atomic_load(&s_spConfigSnapshot);
+}
+
+bool ConfigSnapshot::Publish()
+{
+    auto spSnapshot = std::make_shared<ConfigSnapshot>();
+    spSnapshot->spRecall = RecallConfig::GetInstance()->GetConfigData();
+    spSnapshot->spFilter = FilterConfig::GetInstance()->GetConfigData();
+    spSnapshot->spDisplay = DisplayConfig::GetInstance()->GetConfigData();
+    spSnapshot->spStageBudget = StageBudgetConfig::GetInstance()->GetConfigData();
+    if (!spSnapshot->routeTable.Build(*spSnapshot->spRecall, *spSnapshot->spFilter,
+                                      *spSnapshot->spDisplay, *spSnapshot->spStageBudget))
+    {
+        LOG(ERROR) << "ConfigSnapshot::Publish() build route table failed.";
+        return false;
+    }
+    std::atomic_store(&s_spConfigSnapshot, std::shared_ptr<const ConfigSnapshot>(std::move(spSnapshot)));
+    return true;
+}
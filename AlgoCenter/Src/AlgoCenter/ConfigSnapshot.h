@@ -0,0 +1,29 @@
+#pragma once
+#include <memory>
+#include "Recall/RecallConfig.h"
+#include "Filter/FilterConfig.h"
+#include "Display/DisplayConfig.h"
+#include "AlgoCenter/StageBudgetConfig.h"
+#include "AlgoCenter/RouteTable.h"
+
+// 请求级配置快照
+// 1. 配置更新时各配置在新对象上解析, 全部成功后由 Publish 组合成一份快照整体替换
+// 2. 请求开始时 Current 取一次快照并持有到请求结束, 召回/过滤/展控/阶段预算都从同一份快照读取
+// 3. 发布时编译实验路由表(RouteTable.h), 请求按接口、实验与用户组一次路由到各层级配置
+// 4. 旧快照在最后一个持有它的请求结束后释放, 配置连续更新也不会改写请求正在读取的数据
+struct ConfigSnapshot
+{
+    std::shared_ptr<const RecallConfigData> spRecall;
+    std::shared_ptr<const FilterConfigData> spFilter;
+    std::shared_ptr<const DisplayConfigData> spDisplay;
+    std::shared_ptr<const StageBudgetConfigData> spStageBudget;
+
+    RouteTable routeTable; // 指向以上配置数据
+
+    // 当前快照, 未发布过时返回 nullptr
+    static std::shared_ptr<const ConfigSnapshot> Current();
+
+    // 以各配置的当前数据生成快照并发布, 在配置更新锁内调用
+    // 路由表编译失败时不发布, 请求继续使用上一份快照
+    static bool Publish();
+};
@@ -36,4 +36,7 @@ namespace Common
     // 展控配置路径
     const static std::string ConfigPath_Display = "./config/DisplayExpConf.json";
 
+    // 阶段预算配置路径
+    const static std::string ConfigPath_Budget = "./config/BudgetExpConf.json";
+
 } // namespace Common
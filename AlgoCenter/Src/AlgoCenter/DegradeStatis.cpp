@@ -0,0 +1,39 @@
+#include "DegradeStatis.h"
+#include <chrono>
+#include "glog/logging.h"
+
+void DegradeStatis::Record(uint32_t degrade_flags)
+{
+    m_RequestCount.fetch_add(1, std::memory_order_relaxed);
+    for (int bit = 0; bit < Degrade_FlagNum; bit++)
+    {
+        if (degrade_flags & (1u << bit))
+        {
+            m_DegradeCount[bit].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    LogStatis();
+}
+
+void DegradeStatis::LogStatis()
+{
+    static const long log_interval_sec = 10;
+
+    long now_sec = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+    long last_sec = m_LastLogTime.load(std::memory_order_relaxed);
+    if (now_sec - last_sec < log_interval_sec ||
+        !m_LastLogTime.compare_exchange_strong(last_sec, now_sec))
+    {
+        return;
+    }
+
+    LOG(INFO) << "DegradeStatis"
+              << ", request = " << GetRequestCount()
+              << ", admission = " << GetDegradeCount(Degrade_Admission)
+              << ", recall_skip = " << GetDegradeCount(Degrade_RecallSkip)
+              << ", rank_trunc = " << GetDegradeCount(Degrade_RankTrunc)
+              << ", scatter_skip = " << GetDegradeCount(Degrade_ScatterSkip);
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "Common/Singleton.h"
+#include "ResponseData.h"
+
+// 降级统计: 按降级标记累计请求数, 每 10 秒输出一次日志
+class DegradeStatis : public Singleton<DegradeStatis>
+{
+public:
+    // 记录一次请求的降级标记
+    void Record(uint32_t degrade_flags);
+
+    // 指定降级标记的累计次数
+    inline long GetDegradeCount(DegradeFlag flag) const noexcept
+    {
+        for (int bit = 0; bit < Degrade_FlagNum; bit++)
+        {
+            if (flag == (1u << bit))
+            {
+                return m_DegradeCount[bit].load(std::memory_order_relaxed);
+            }
+        }
+        return 0;
+    }
+
+    inline long GetRequestCount() const noexcept { return m_RequestCount.load(std::memory_order_relaxed); }
+
+private:
+    void LogStatis();
+
+private:
+    std::atomic<long> m_RequestCount = 0;
+    std::atomic<long> m_DegradeCount[Degrade_FlagNum] = {};
+    std::atomic<long> m_LastLogTime = 0;
+
+public:
+    DegradeStatis(token) {}
+    ~DegradeStatis() {}
+    DegradeStatis(DegradeStatis &) = delete;
+    DegradeStatis &operator=(const DegradeStatis &) = delete;
+};
@@ -5,99 +5,42 @@
 #include "glog/logging.h"
 #include "Common/Function.h"
 
-#include "rapidjson/document.h"
-#include "rapidjson/writer.h"
-#include "rapidjson/stringbuffer.h"
-
 #include "Config.h"
 #include "Define.h"
 #include "RequestData.h"
 #include "ResponseData.h"
+#include "RankBatcher.h"
+#include "SampleLogPipeline.h"
+#include "Trace/Tracer.h"
 
 #include "TDPredict/RankCalc/RankCalc.h"
 #include "Feature/UserFeature.h"
 #include "Feature/ItemFeature.h"
 #include "Feature/TFFeature.h"
 
-#include "KafkaClient/PushKafkaPool.h"
+#ifdef ALGOCENTER_BENCH
+ItemRank::LocalScorer ItemRank::s_LocalScorer;
 
-static std::string GenerateAlgoData(
-    const RequestData &requestData,
-    const std::vector<TDPredict::RankItem> &vec_rank_item)
+void ItemRank::SetLocalScorer(LocalScorer scorer)
+{
+    s_LocalScorer = std::move(scorer);
+}
+#endif
+
+// 样本日志类型
+static std::string GetSampleLogType(const Common::APIType apiType)
 {
-    std::string data_type = "";
-    switch (requestData.apiType)
+    switch (apiType)
     {
     case Common::APIType::Get_Download_Recommend:
     {
-        data_type = "rec_download_user_feature";
-        break;
+        return "rec_download_user_feature";
     }
     default:
     {
-        break;
+        return "";
     }
     }
-
-    long now_time = Common::get_timestamp();
-
-    // 构造 Json
-    rapidjson::StringBuffer logBuf;
-    rapidjson::Writer<rapidjson::StringBuffer> logWriter(logBuf);
-    logWriter.StartObject();
-    {
-        logWriter.Key("type");
-        logWriter.String(data_type.c_str(), data_type.size());
-
-        logWriter.Key("data");
-        logWriter.StartObject();
-        {
-            logWriter.Key("add_time");
-            logWriter.Int64(now_time);
-            logWriter.Key("request_id");
-            logWriter.String(requestData.uuid.c_str(), requestData.uuid.size());
-            logWriter.Key("user_id");
-            logWriter.Int64(requestData.user_id);
-            logWriter.Key("context_item_id");
-            logWriter.Int64(requestData.context_item_id);
-            logWriter.Key("context_res_type");
-            logWriter.Int(requestData.context_res_type);
-
-            // 公共特征
-            logWriter.Key("common_feature");
-            logWriter.StartArray();
-            {
-                if (!vec_rank_item.empty())
-                {
-                    auto &rank_item = vec_rank_item[0];
-                    const auto &common_feature = rank_item.spFeatureData->common_feature;
-                    for (const auto &field_item_list : common_feature)
-                    {
-                        for (const auto &field_item : field_item_list)
-                        {
-                            logWriter.StartObject();
-                            {
-                                std::string field_value = std::to_string(field_item.field_value.field_value());
-                                logWriter.Key(field_value.c_str(), field_value.size());
-                                logWriter.Double(field_item.weight);
-                            }
-                            logWriter.EndObject();
-                        }
-                    }
-                }
-            }
-            logWriter.EndArray();
-        }
-        logWriter.EndObject();
-    }
-    logWriter.EndObject();
-
-    // 打印Log
-    std::string featureJsonLog;
-    featureJsonLog.clear();
-    featureJsonLog.append(logBuf.GetString(), logBuf.GetSize());
-
-    return featureJsonLog;
 }
 
 int ItemRank::RankCalc(
@@ -105,6 +48,7 @@ int ItemRank::RankCalc(
     ResponseData &responseData)
 {
     double start_time = Common::get_ms_time();
+    TraceSpan rankSpan("RankCalc");
 
     // 百分之一的概率打印5条排序日志
     int rank_log_count = 0;
@@ -117,81 +61,141 @@ int ItemRank::RankCalc(
     rank_log_count = 5;
 #endif
 
-    // 设置 user_id 与 item_id
-    const int items_list_size = responseData.items_list.size();
-    std::vector<TDPredict::RankItem> vec_rank_item(items_list_size);
-    for (int idx = 0; idx != items_list_size; idx++)
+    // 构造列式排序上下文: 物料信息移入 origin_items_list, RankItem 只携带下标 ctx_idx
+    std::vector<ItemInfo> origin_items_list = std::move(responseData.items_list);
+    responseData.items_list.clear();
+
+    const int items_list_size = origin_items_list.size();
+    auto spRankContext = std::make_shared<RankContext>();
     {
-        auto &rank_item = vec_rank_item[idx];
-        rank_item.setParam("user_id", requestData.user_id);
-        rank_item.setParam("context_item_id", requestData.context_item_id);
-        rank_item.setParam("context_res_type", (long)requestData.context_res_type);
-        rank_item.setParam("item_id", responseData.items_list[idx].item_id);
-        rank_item.setParam("res_type", (long)responseData.items_list[idx].res_type);
-        rank_item.setParam("recall_type_id", responseData.items_list[idx].recall_type_id);
-        rank_item.setParam("recall_type", responseData.items_list[idx].recall_type);
+        auto &request_context = spRankContext->request;
+        request_context.user_id = requestData.user_id;
+        request_context.context_item_id = requestData.context_item_id;
+        request_context.context_res_type = requestData.context_res_type;
+        request_context.spInitStruct = std::make_shared<InitStruct>();
+        request_context.spInitStruct->spUserFeature = std::make_shared<UserFeature>(requestData.userFeature);
+        request_context.spInitStruct->spItemFeature = std::make_shared<ItemFeature>(requestData.itemFeature);
     }
 
-    auto spInitStruct = std::make_shared<InitStruct>();
-    spInitStruct->spUserFeature = std::make_shared<UserFeature>(requestData.userFeature);
-    spInitStruct->spItemFeature = std::make_shared<ItemFeature>(requestData.itemFeature);
-
-    std::unordered_map<TDPredict::RankType, int> rand_exp_id;
-
-    // 执行多级排序计算
-    TDPredict::RankCalc calc;
-    calc.SetUUID(requestData.uuid);
-    calc.SetRankLogCount(rank_log_count);
-    calc.SetRankLogFeature(true);
-    calc.SetFeatureFactory(TDPredict::GetFeatureFactory());
-    calc.SetInitData(spInitStruct);
-    calc.Calc(requestData.vecExpID, vec_rank_item, rand_exp_id);
-
-    // 输出 Kafka & 日志文件
-    if (Config::GetInstance()->GetKafkaPushSwitch())
+    spRankContext->vecItem.resize(items_list_size);
+    std::vector<TDPredict::RankItem> vec_rank_item(items_list_size);
+    for (int idx = 0; idx != items_list_size; idx++)
     {
-        TDKafkaData kafka_data;
-        kafka_data.msg = GenerateAlgoData(requestData, vec_rank_item);
-        kafka_data.topic_id = Config::GetInstance()->GetKafkaPushTopic();
-        kafka_data.partition = RdKafka::Topic::PARTITION_UA;
+        auto &item_context = spRankContext->vecItem[idx];
+        item_context.item_id = origin_items_list[idx].item_id;
+        item_context.res_type = origin_items_list[idx].res_type;
 
-        LOG(DATA) << kafka_data.msg;
+        vec_rank_item[idx].setParam(RankParam_ContextIdx, (long)idx);
+    }
 
-        int free_threads_num = 0;
-        int queue_tasks_num = 0;
-        PushKafkaPool::GetInstance()->Push(std::move(kafka_data), free_threads_num, queue_tasks_num);
+    // 本地打分分数, 下标为 ctx_idx, 只在离线压测中填充
+    std::vector<float> vec_local_score;
 
-        if ((rand() % 1000) < 5)
+    auto conf = Config::GetInstance();
+#ifdef ALGOCENTER_BENCH
+    if (s_LocalScorer)
+    {
+        // 本地打分替代模型计算, 特征构造与结果回填保持不变
+        vec_local_score.resize(items_list_size);
+        for (int idx = 0; idx != items_list_size; idx++)
         {
-            LOG(INFO) << "ItemRank::RankCalc() PushKafkaPool Status"
-                      << ", free_threads_num = " << free_threads_num
-                      << ", queue_tasks_num = " << queue_tasks_num;
+            vec_local_score[idx] = s_LocalScorer(requestData, origin_items_list[idx]);
         }
+        std::stable_sort(vec_rank_item.begin(), vec_rank_item.end(),
+                         [&vec_local_score](const TDPredict::RankItem &a, const TDPredict::RankItem &b)
+                         {
+                             long a_idx = 0, b_idx = 0;
+                             a.getParam(RankParam_ContextIdx, a_idx);
+                             b.getParam(RankParam_ContextIdx, b_idx);
+                             return vec_local_score[a_idx] > vec_local_score[b_idx];
+                         });
+    }
+    else
+#endif
+    if (conf->GetRankBatchSwitch() && RankBatcher::GetInstance()->IsInit())
+    {
+        // 提交到排序工作线程, 超时降级
+        auto spTask = std::make_shared<RankBatchTask>();
+        spTask->uuid = requestData.uuid;
+        spTask->vecExpID = requestData.vecExpID;
+        spTask->rankLogCount = rank_log_count;
+        spTask->truncCount = requestData.rankTruncCount;
+        spTask->spRankContext = spRankContext;
+        spTask->vecRankItem = std::move(vec_rank_item);
+
+        int err = RankBatcher::GetInstance()->Calc(spTask, conf->GetRankBatchTimeoutMs());
+        if (err != Common::Error::OK)
+        {
+            // 排序失败或超时, 降级为召回顺序返回
+            responseData.items_list = std::move(origin_items_list);
+            if ((int)responseData.items_list.size() > requestData.rankTruncCount)
+            {
+                responseData.items_list.resize(requestData.rankTruncCount);
+            }
+
+            LOG(WARNING) << "ItemRank::RankCalc() RankBatcher Calc failed, fallback to recall order"
+                         << ", uuid = " << requestData.uuid
+                         << ", user_id = " << requestData.user_id
+                         << ", items_list = " << responseData.items_list.size()
+                         << ", err = " << err;
+            return Common::Error::OK;
+        }
+        vec_rank_item = std::move(spTask->vecRankItem);
+    }
+    else
+    {
+        std::unordered_map<TDPredict::RankType, int> rand_exp_id;
+
+        // 执行多级排序计算
+        TDPredict::RankCalc calc;
+        calc.SetUUID(requestData.uuid);
+        calc.SetRankLogCount(rank_log_count);
+        calc.SetRankLogFeature(true);
+        calc.SetFeatureFactory(TDPredict::GetFeatureFactory());
+        calc.SetInitData(spRankContext);
+        calc.Calc(requestData.vecExpID, vec_rank_item, rand_exp_id);
+    }
+
+    // 样本日志异步推送 Kafka, 请求线程只负责入队, 本地打分没有模型特征不推送
+    // 两条排序路径都只计算本请求的物料并拼接特征, 首个物料的公共特征即本请求的公共特征
+    if (conf->GetKafkaPushSwitch() && vec_local_score.empty() && !vec_rank_item.empty())
+    {
+        SampleLogRecord record;
+        record.type = GetSampleLogType(requestData.apiType);
+
+        // 配置二进制 Topic 时推送二进制格式, 否则按原 JSON 格式推送到原 Topic
+        std::string binary_topic = conf->GetKafkaPushBinaryTopic();
+        record.binary = !binary_topic.empty();
+        record.topic = record.binary ? std::move(binary_topic) : conf->GetKafkaPushTopic();
+        record.add_time = Common::get_timestamp();
+        record.uuid = requestData.uuid;
+        record.user_id = requestData.user_id;
+        record.context_item_id = requestData.context_item_id;
+        record.context_res_type = requestData.context_res_type;
+        record.spFeatureData = vec_rank_item[0].spFeatureData;
+        SampleLogPipeline::GetInstance()->Push(std::move(record));
     }
 
     // 截断返回数量
     const int trunc_count = std::min(requestData.rankTruncCount, int(vec_rank_item.size()));
     vec_rank_item.resize(trunc_count);
 
-    // 写回 items_list
-    responseData.items_list.clear();
+    // 按 ctx_idx 把物料信息移回 items_list
     responseData.items_list.reserve(trunc_count);
     for (int idx = 0; idx < trunc_count; idx++)
     {
         const auto &rank_item = vec_rank_item[idx];
 
-        long item_id = 0;
-        long res_type = 0;
-        long recall_type_id = 0;
-        std::string recall_type = "";
-        if (rank_item.getParam("item_id", item_id) &&
-            rank_item.getParam("res_type", res_type) &&
-            rank_item.getParam("recall_type_id", recall_type_id) &&
-            rank_item.getParam("recall_type", recall_type))
+        long ctx_idx = 0;
+        if (rank_item.getParam(RankParam_ContextIdx, ctx_idx) &&
+            ctx_idx >= 0 && ctx_idx < items_list_size)
         {
-            auto score = rank_item.getRankScore(TDPredict::RankType::Rank);
-            responseData.items_list.emplace_back(
-                item_id, res_type, recall_type_id, recall_type, score, score);
+            auto &item_info = origin_items_list[ctx_idx];
+            item_info.score = vec_local_score.empty()
+                                  ? rank_item.getRankScore(TDPredict::RankType::Rank)
+                                  : vec_local_score[ctx_idx];
+            item_info.sc_score = item_info.score;
+            responseData.items_list.push_back(std::move(item_info));
         }
     }
 
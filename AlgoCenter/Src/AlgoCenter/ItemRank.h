@@ -1,10 +1,12 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <functional>
 #include <unordered_map>
 
 class RequestData;
 class ResponseData;
+struct ItemInfo;
 
 class ItemRank
 {
@@ -12,4 +14,17 @@ public:
     static int RankCalc(
         const RequestData &requestData,
         ResponseData &responseData);
+
+#ifdef ALGOCENTER_BENCH
+public:
+    // 本地打分函数, 返回值越大排序越靠前
+    using LocalScorer = std::function<float(const RequestData &, const ItemInfo &)>;
+
+    // 设置本地打分函数, 设置后替代排序模型计算, 只在离线压测(AlgoCenterBench)中编译
+    // 非线程安全, 需在请求到来前设置
+    static void SetLocalScorer(LocalScorer scorer);
+
+private:
+    static LocalScorer s_LocalScorer;
+#endif
 };
@@ -0,0 +1,105 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+// 有界无锁队列, 多生产者单消费者
+// 基于环形数组与每个槽位的序号(Vyukov bounded queue), 队列满时 TryPush 直接返回 false
+template <typename T>
+class MPSCQueue
+{
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+public:
+    // 容量向上取整为2的幂
+    explicit MPSCQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        m_mask = size - 1;
+        m_buffer.reset(new Cell[size]);
+        for (size_t idx = 0; idx < size; idx++)
+        {
+            m_buffer[idx].sequence.store(idx, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    // 生产者调用, 线程安全
+    bool TryPush(T &&value) noexcept
+    {
+        Cell *cell = nullptr;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &m_buffer[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // 队列已满
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者调用, 只允许单线程
+    bool TryPop(T &value) noexcept
+    {
+        Cell *cell = &m_buffer[m_dequeuePos & m_mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(m_dequeuePos + 1) < 0)
+        {
+            // 队列为空
+            return false;
+        }
+
+        value = std::move(cell->data);
+        cell->sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+        m_dequeuePos++;
+        return true;
+    }
+
+    // 消费者调用, 队列是否为空
+    bool Empty() const noexcept
+    {
+        const Cell *cell = &m_buffer[m_dequeuePos & m_mask];
+        size_t seq = cell->sequence.load(std::memory_order_acquire);
+        return static_cast<intptr_t>(seq) - static_cast<intptr_t>(m_dequeuePos + 1) < 0;
+    }
+
+    size_t Capacity() const noexcept { return m_mask + 1; }
+
+private:
+    size_t m_mask = 0;
+    std::unique_ptr<Cell[]> m_buffer;
+
+    alignas(64) std::atomic<size_t> m_enqueuePos = 0;
+    alignas(64) size_t m_dequeuePos = 0;
+};
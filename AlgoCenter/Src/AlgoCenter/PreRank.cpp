@@ -0,0 +1,327 @@
+#include "PreRank.h"
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include "glog/logging.h"
+#include "Common/Function.h"
+
+#include "Define.h"
+#include "Config.h"
+#include "RequestData.h"
+#include "ResponseData.h"
+
+#include "Feature/AnalyseFeature.hpp"
+
+namespace
+{
+    // 特征槽位与取值
+    struct SlotValue
+    {
+        size_t slot;
+        float value;
+    };
+
+    // 展开 FeatureItem 为 (槽位, 取值) 列表, FeatureItem 按 field_id 下标存放
+    void CollectSlots(
+        const TDPredict::FeatureItem &feature_item,
+        const int hash_bits,
+        std::vector<SlotValue> &vec_slot)
+    {
+        int field_id = 0;
+        for (const auto &field_item_list : feature_item)
+        {
+            for (const auto &field_item : field_item_list)
+            {
+                vec_slot.push_back({PreRank::FeatureSlot(field_id, field_item.field_value.field_value(), hash_bits),
+                                    static_cast<float>(field_item.weight)});
+            }
+            field_id++;
+        }
+    }
+
+    // 累加一阶项与 FM 二阶项的中间量
+    float AccumulateSlots(
+        const PreRankModelData &model,
+        const std::vector<SlotValue> &vec_slot,
+        float *sum_v,
+        float *sum_v2)
+    {
+        const int factor_num = model.iFactorNum;
+        float linear = 0.0f;
+        for (const auto &slot_value : vec_slot)
+        {
+            const float x = slot_value.value;
+            linear += model.vecWeight[slot_value.slot] * x;
+
+            const float *v = &model.vecFactor[slot_value.slot * factor_num];
+            for (int f = 0; f < factor_num; f++)
+            {
+                const float vx = v[f] * x;
+                sum_v[f] += vx;
+                sum_v2[f] += vx * vx;
+            }
+        }
+        return linear;
+    }
+}
+
+size_t PreRank::FeatureSlot(const int field_id, const long field_value, const int hash_bits)
+{
+    // splitmix64
+    uint64_t h = (static_cast<uint64_t>(field_id) << 48) ^ static_cast<uint64_t>(field_value);
+    h += 0x9E3779B97F4A7C15ULL;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+    h = h ^ (h >> 31);
+    return static_cast<size_t>(h & ((1ULL << hash_bits) - 1));
+}
+
+bool PreRank::LoadModel(const std::string &model_path)
+{
+    std::string buffer;
+    if (Common::FastReadFile(model_path, buffer, false) == false || buffer.empty())
+    {
+        LOG(ERROR) << "PreRank::LoadModel() call FastReadFile failed, model_path = " << model_path;
+        return false;
+    }
+
+    auto spModel = std::make_shared<PreRankModelData>();
+    auto &model = *spModel.get();
+
+    long feature_num = 0;
+    long line_num = 0;
+    std::istringstream input(buffer);
+    std::string line;
+    while (std::getline(input, line))
+    {
+        line_num++;
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream line_input(line);
+        std::string head;
+        line_input >> head;
+        if (head == "hash_bits")
+        {
+            line_input >> model.iHashBits;
+        }
+        else if (head == "factor_num")
+        {
+            line_input >> model.iFactorNum;
+        }
+        else if (head == "bias")
+        {
+            line_input >> model.fBias;
+        }
+        else
+        {
+            if (model.iHashBits <= 0 || model.iHashBits > 30 || model.iFactorNum < 0)
+            {
+                LOG(ERROR) << "PreRank::LoadModel() model header error"
+                           << ", model_path = " << model_path
+                           << ", hash_bits = " << model.iHashBits
+                           << ", factor_num = " << model.iFactorNum;
+                return false;
+            }
+
+            if (model.vecWeight.empty())
+            {
+                size_t slot_num = 1UL << model.iHashBits;
+                model.vecWeight.assign(slot_num, 0.0f);
+                model.vecFactor.assign(slot_num * model.iFactorNum, 0.0f);
+            }
+
+            int field_id = atoi(head.c_str());
+            long field_value = 0;
+            float weight = 0.0f;
+            if (!(line_input >> field_value >> weight))
+            {
+                LOG(ERROR) << "PreRank::LoadModel() parse line failed"
+                           << ", model_path = " << model_path
+                           << ", line_num = " << line_num;
+                return false;
+            }
+
+            size_t slot = FeatureSlot(field_id, field_value, model.iHashBits);
+            model.vecWeight[slot] += weight;
+            for (int f = 0; f < model.iFactorNum; f++)
+            {
+                float factor = 0.0f;
+                if (!(line_input >> factor))
+                {
+                    LOG(ERROR) << "PreRank::LoadModel() factor num error"
+                               << ", model_path = " << model_path
+                               << ", line_num = " << line_num;
+                    return false;
+                }
+                model.vecFactor[slot * model.iFactorNum + f] = factor;
+            }
+            feature_num++;
+        }
+    }
+
+    if (feature_num == 0)
+    {
+        LOG(ERROR) << "PreRank::LoadModel() model is empty, model_path = " << model_path;
+        return false;
+    }
+
+    // 整体替换, 请求线程持有的旧模型在其引用释放后析构
+    std::atomic_store(&m_spModel, std::shared_ptr<const PreRankModelData>(spModel));
+
+    LOG(INFO) << "PreRank::LoadModel() succ"
+              << ", model_path = " << model_path
+              << ", hash_bits = " << model.iHashBits
+              << ", factor_num = " << model.iFactorNum
+              << ", feature_num = " << feature_num;
+
+    return true;
+}
+
+int PreRank::PreRankCalc(
+    const RequestData &requestData,
+    ResponseData &responseData)
+{
+    const auto spModel = std::atomic_load(&m_spModel);
+    if (spModel == nullptr)
+    {
+        return Common::Error::OK;
+    }
+    const auto &model = *spModel.get();
+
+    auto &items_list = responseData.items_list;
+    const int trunc_count = Config::GetInstance()->GetPreRankTruncCount();
+    if (trunc_count <= 0 || (int)items_list.size() <= trunc_count)
+    {
+        return Common::Error::OK;
+    }
+
+    double start_time = Common::get_ms_time();
+
+    const int factor_num = model.iFactorNum;
+    std::vector<SlotValue> vec_slot;
+    vec_slot.reserve(128);
+
+    // 1. 公共特征只计算一次
+    std::vector<float> common_sum_v(factor_num, 0.0f);
+    std::vector<float> common_sum_v2(factor_num, 0.0f);
+    float common_linear = 0.0f;
+    {
+        const auto &userFeature = requestData.GetUserFeature();
+        const auto &itemFeature = requestData.itemFeature;
+        const int context_res_type = requestData.context_res_type;
+
+        TDPredict::FeatureItem common_feature;
+        AnalyseFeature::AnalyseUserFeatureBasic(userFeature.GetUserFeatureBasic(), common_feature);
+        AnalyseFeature::AnalyseUserLiveFeatureClick(context_res_type, userFeature.GetUserLiveFeatureClick(), common_feature);
+        AnalyseFeature::AnalyseUserLiveFeatureSearch(context_res_type, userFeature.GetUserLiveFeatureSearch(), common_feature);
+        AnalyseFeature::AnalyseUserLiveFeatureDownload(context_res_type, userFeature.GetUserLiveFeatureDownload(), common_feature);
+        AnalyseFeature::AnalyseContextFeatureItemBasic(
+            itemFeature.GetItemFeatureBasic(requestData.context_item_id, context_res_type), common_feature);
+        AnalyseFeature::AnalyseContextFeatureItemStatis(
+            itemFeature.GetItemFeatureStatis(requestData.context_item_id, context_res_type), common_feature);
+
+        CollectSlots(common_feature, model.iHashBits, vec_slot);
+        common_linear = AccumulateSlots(model, vec_slot, common_sum_v.data(), common_sum_v2.data());
+    }
+
+    // 2. 逐物料打分, 公共部分的中间量作为初值
+    const int items_list_size = items_list.size();
+    std::vector<std::pair<float, int>> vec_score;
+    vec_score.reserve(items_list_size);
+
+    std::vector<float> sum_v(factor_num);
+    std::vector<float> sum_v2(factor_num);
+    for (int idx = 0; idx < items_list_size; idx++)
+    {
+        const auto &item_info = items_list[idx];
+
+        TDPredict::FeatureItem rank_feature;
+        AnalyseFeature::AnalyseItemFeatureBasic(
+            requestData.itemFeature.GetItemFeatureBasic(item_info.item_id, item_info.res_type), rank_feature);
+        AnalyseFeature::AnalyseItemFeatureStatis(
+            requestData.itemFeature.GetItemFeatureStatis(item_info.item_id, item_info.res_type), rank_feature);
+
+        vec_slot.clear();
+        CollectSlots(rank_feature, model.iHashBits, vec_slot);
+
+        std::copy(common_sum_v.begin(), common_sum_v.end(), sum_v.begin());
+        std::copy(common_sum_v2.begin(), common_sum_v2.end(), sum_v2.begin());
+        float score = model.fBias + common_linear + AccumulateSlots(model, vec_slot, sum_v.data(), sum_v2.data());
+
+        float interaction = 0.0f;
+        for (int f = 0; f < factor_num; f++)
+        {
+            interaction += sum_v[f] * sum_v[f] - sum_v2[f];
+        }
+        score += 0.5f * interaction;
+
+        vec_score.emplace_back(score, idx);
+    }
+
+    // 3. 按粗排分截断
+    std::partial_sort(
+        vec_score.begin(), vec_score.begin() + trunc_count, vec_score.end(),
+        [](const std::pair<float, int> &lhs, const std::pair<float, int> &rhs)
+        { return lhs.first > rhs.first; });
+
+    std::vector<ItemInfo> pre_rank_items;
+    pre_rank_items.reserve(trunc_count);
+    responseData.pre_rank_position.clear();
+    responseData.pre_rank_position.reserve(trunc_count);
+    for (int idx = 0; idx < trunc_count; idx++)
+    {
+        auto &item_info = items_list[vec_score[idx].second];
+        item_info.score = vec_score[idx].first;
+        responseData.pre_rank_position[ItemKey(item_info.item_id, item_info.res_type)] = idx;
+        pre_rank_items.push_back(std::move(item_info));
+    }
+
+    responseData.pre_rank_input_num = items_list_size;
+    items_list.swap(pre_rank_items);
+
+    responseData.pre_rank_time = Common::get_ms_time() - start_time;
+
+    return Common::Error::OK;
+}
+
+double PreRank::RankAgreement(const ResponseData &responseData)
+{
+    const auto &pre_rank_position = responseData.pre_rank_position;
+    if (pre_rank_position.empty())
+    {
+        return 0.0;
+    }
+
+    // 取精排后仍存在的物料, 计算两组位置的 Spearman 相关系数
+    std::vector<std::pair<int, int>> vec_position;
+    vec_position.reserve(responseData.items_list.size());
+    for (size_t idx = 0; idx < responseData.items_list.size(); idx++)
+    {
+        const auto &item_info = responseData.items_list[idx];
+        auto iter = pre_rank_position.find(ItemKey(item_info.item_id, item_info.res_type));
+        if (iter != pre_rank_position.end())
+        {
+            vec_position.emplace_back(iter->second, vec_position.size());
+        }
+    }
+
+    const size_t n = vec_position.size();
+    if (n < 2)
+    {
+        return 0.0;
+    }
+
+    // 粗排位置重新编号为 0..n-1
+    std::sort(vec_position.begin(), vec_position.end());
+    double sum_d2 = 0.0;
+    for (size_t pre_rank = 0; pre_rank < n; pre_rank++)
+    {
+        double d = static_cast<double>(pre_rank) - vec_position[pre_rank].second;
+        sum_d2 += d * d;
+    }
+
+    return 1.0 - 6.0 * sum_d2 / (static_cast<double>(n) * (static_cast<double>(n) * n - 1.0));
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Common/Singleton.h"
+
+class RequestData;
+class ResponseData;
+
+// 粗排 FM 模型参数
+// 模型文件为文本格式, 由离线训练产出:
+//   hash_bits <n>                                    哈希槽位数 2^n
+//   factor_num <k>                                   隐向量维度, 为0时退化为线性模型
+//   bias <b>
+//   <field_id> <field_value> <w> [v_1 ... v_k]       每个特征一行, field 与 FeatureField 一致
+// 以 # 开头的行为注释
+struct PreRankModelData
+{
+    int iHashBits = 0;
+    int iFactorNum = 0;
+    float fBias = 0.0f;
+    std::vector<float> vecWeight; // 一阶权重, 下标为哈希槽位
+    std::vector<float> vecFactor; // 隐向量, 下标为 槽位 * iFactorNum
+};
+
+// 粗排模块: 在远程排序前用本地 FM 模型打分, 截断到 TruncCount
+class PreRank : public Singleton<PreRank>
+{
+public:
+    PreRank(token) {}
+    virtual ~PreRank() {}
+    PreRank(const PreRank &) = delete;
+    PreRank &operator=(const PreRank &) = delete;
+
+public:
+    // 加载本地模型文件, 成功后整体替换当前模型
+    bool LoadModel(const std::string &model_path);
+
+    // 粗排打分并截断, 记录粗排位置用于一致性统计
+    int PreRankCalc(
+        const RequestData &requestData,
+        ResponseData &responseData);
+
+    // 统计粗排与精排的排序一致性(Spearman 相关系数), 需在精排后调用
+    static double RankAgreement(const ResponseData &responseData);
+
+    // (field_id, field_value) 映射到哈希槽位, 离线训练需使用同一哈希
+    static size_t FeatureSlot(const int field_id, const long field_value, const int hash_bits);
+
+    // 物料唯一键, 用于记录粗排位置
+    static long ItemKey(const long item_id, const int res_type)
+    {
+        return (item_id << 8) | (res_type & 0xff);
+    }
+
+private:
+    // 当前模型, 以 std::atomic_load / std::atomic_store 读写
+    std::shared_ptr<const PreRankModelData> m_spModel;
+};
@@ -0,0 +1,145 @@
+#include "RankBatcher.h"
+#include <chrono>
+#include "glog/logging.h"
+#include "Common/Function.h"
+
+#include "Define.h"
+#include "Feature/TFFeature.h"
+
+bool RankBatcher::Init(const int thread_num)
+{
+    if (thread_num <= 0)
+    {
+        LOG(ERROR) << "RankBatcher::Init() param error"
+                   << ", thread_num = " << thread_num;
+        return false;
+    }
+
+    g_Init = true;
+    g_WorkThreadList.reserve(thread_num);
+    for (int idx = 0; idx < thread_num; idx++)
+    {
+        g_WorkThreadList.push_back(std::make_shared<std::thread>(std::bind(&RankBatcher::OnWork, this)));
+    }
+
+    LOG(INFO) << "RankBatcher::Init() start success"
+              << ", thread_num = " << thread_num;
+
+    return true;
+}
+
+void RankBatcher::ShutDown()
+{
+    if (g_Init)
+    {
+        g_Init = false;
+        m_QueueCond.notify_all();
+        for (auto &work_thread : g_WorkThreadList)
+        {
+            if (work_thread->joinable())
+            {
+                work_thread->join();
+            }
+        }
+        LOG(INFO) << "RankBatcher::ShutDown() g_WorkThreadList.join() finish.";
+    }
+}
+
+int RankBatcher::Calc(const RankBatchTaskPtr &spTask, const long timeout_ms)
+{
+    if (!g_Init)
+    {
+        return Common::Error::Failed;
+    }
+
+    auto future = spTask->promise.get_future();
+    {
+        std::lock_guard<std::mutex> lg(m_QueueLock);
+        m_TaskQueue.push_back(spTask);
+    }
+    m_QueueCond.notify_one();
+
+    if (future.wait_for(std::chrono::milliseconds(timeout_ms)) != std::future_status::ready)
+    {
+        // 超时后任务可能仍在计算, 结果由工作线程持有, 调用方不再访问
+        spTask->abandoned = true;
+        long timeout_count = ++m_TimeoutCount;
+        LOG(WARNING) << "RankBatcher::Calc() wait timeout"
+                     << ", uuid = " << spTask->uuid
+                     << ", timeout_ms = " << timeout_ms
+                     << ", timeout_count = " << timeout_count;
+        return Common::Error::Failed;
+    }
+
+    return future.get();
+}
+
+void RankBatcher::OnWork()
+{
+    while (g_Init)
+    {
+        auto spTask = PopTask();
+        if (spTask == nullptr)
+        {
+            break;
+        }
+        CalcSingle(spTask);
+    }
+}
+
+RankBatchTaskPtr RankBatcher::PopTask()
+{
+    std::unique_lock<std::mutex> ul(m_QueueLock);
+    while (true)
+    {
+        m_QueueCond.wait(ul, [this]()
+                         { return !m_TaskQueue.empty() || !g_Init; });
+        if (!g_Init)
+        {
+            return nullptr;
+        }
+
+        auto spTask = std::move(m_TaskQueue.front());
+        m_TaskQueue.pop_front();
+
+        // 调用方已放弃的任务直接丢弃
+        if (spTask->abandoned)
+        {
+            spTask->promise.set_value(Common::Error::Failed);
+            continue;
+        }
+        return spTask;
+    }
+}
+
+void RankBatcher::CalcSingle(const RankBatchTaskPtr &spTask)
+{
+    double start_time = Common::get_ms_time();
+    std::unordered_map<TDPredict::RankType, int> rand_exp_id;
+
+    TDPredict::RankCalc calc;
+    calc.SetUUID(spTask->uuid);
+    calc.SetRankLogCount(spTask->rankLogCount);
+    calc.SetRankLogFeature(true);
+    calc.SetFeatureFactory(TDPredict::GetFeatureFactory());
+    calc.SetInitData(spTask->spRankContext);
+    calc.Calc(spTask->vecExpID, spTask->vecRankItem, rand_exp_id);
+
+    if ((int)spTask->vecRankItem.size() > spTask->truncCount)
+    {
+        spTask->vecRankItem.resize(std::max(0, spTask->truncCount));
+    }
+
+    long task_count = ++m_TaskCount;
+    if ((rand() % 1000) < 5)
+    {
+        LOG(INFO) << "RankBatcher::CalcSingle() Status"
+                  << ", uuid = " << spTask->uuid
+                  << ", items = " << spTask->vecRankItem.size()
+                  << ", task_count = " << task_count
+                  << ", timeout_count = " << m_TimeoutCount
+                  << ", all_time = " << Common::get_ms_time() - start_time << "ms.";
+    }
+
+    spTask->promise.set_value(Common::Error::OK);
+}
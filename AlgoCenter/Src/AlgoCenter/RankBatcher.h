@@ -0,0 +1,76 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <future>
+#include <vector>
+#include <condition_variable>
+#include "Common/Singleton.h"
+
+#include "TDPredict/RankCalc/RankCalc.h"
+#include "Feature/TFFeature_ContextAdapter.h"
+
+// 排序任务, 对应一次请求的全部排序物料
+struct RankBatchTask
+{
+    std::string uuid;
+    std::vector<int> vecExpID;
+    int rankLogCount = 0;
+    int truncCount = 0; // 本请求排序后的截断数量
+
+    // 本请求的列式排序上下文
+    RankContextPtr spRankContext;
+
+    // 提交时传入待排序物料, 完成后为本请求排好序并截断后的物料
+    std::vector<TDPredict::RankItem> vecRankItem;
+
+    std::atomic<bool> abandoned = false; // 调用方已超时放弃
+    std::promise<int> promise;
+};
+using RankBatchTaskPtr = std::shared_ptr<RankBatchTask>;
+
+// 排序工作线程池
+// 请求线程提交排序任务后最多等待 TimeoutMs, 超时由调用方降级为召回顺序, 排序并发数由 ThreadNum 限制
+// 每个任务独立执行一次 RankCalc, 不跨请求合并:
+// TDPredict 未约定对每个物料以其所属请求的上下文拼接公共特征, 样本日志也只取首个物料的特征,
+// 多个请求合并计算时可能以同一用户的公共特征打分, 因此一次 RankCalc 只包含一个请求的物料
+class RankBatcher : public Singleton<RankBatcher>
+{
+public:
+    RankBatcher(token) {}
+    virtual ~RankBatcher() {}
+    RankBatcher(const RankBatcher &) = delete;
+    RankBatcher &operator=(const RankBatcher &) = delete;
+
+public:
+    bool Init(const int thread_num);
+
+    void ShutDown();
+
+    bool IsInit() const noexcept { return g_Init; }
+
+    // 提交任务并等待结果, 超时返回错误, 由调用方降级
+    int Calc(const RankBatchTaskPtr &spTask, const long timeout_ms);
+
+private:
+    void OnWork();
+
+    // 取出一个待计算任务, 服务退出时返回 nullptr
+    RankBatchTaskPtr PopTask();
+
+    // 单个任务独立计算
+    void CalcSingle(const RankBatchTaskPtr &spTask);
+
+private:
+    std::atomic<bool> g_Init = false;
+    std::vector<std::shared_ptr<std::thread>> g_WorkThreadList;
+
+    std::mutex m_QueueLock;
+    std::condition_variable m_QueueCond;
+    std::deque<RankBatchTaskPtr> m_TaskQueue;
+
+    // 统计
+    std::atomic<long> m_TaskCount = 0;    // 完成计算的任务数
+    std::atomic<long> m_TimeoutCount = 0; // 调用方超时次数
+};
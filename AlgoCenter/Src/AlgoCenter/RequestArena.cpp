@@ -0,0 +1,65 @@
+#include "RequestArena.h"
+#include <chrono>
+#include <algorithm>
+#include "glog/logging.h"
+
+std::shared_ptr<RequestArena> RequestArena::Create(std::size_t initial_block_bytes)
+{
+    return std::shared_ptr<RequestArena>(new RequestArena(initial_block_bytes));
+}
+
+RequestArena::RequestArena(std::size_t initial_block_bytes)
+    : m_InitialBlockBytes(std::max<std::size_t>(initial_block_bytes, 1024) & ~std::size_t(15)),
+      m_InitialBlock(new char[m_InitialBlockBytes]),
+      m_ProtoArena(MakeProtoArenaOptions(m_InitialBlock.get(), m_InitialBlockBytes / 2)),
+      m_MonotonicResource(m_InitialBlock.get() + m_InitialBlockBytes / 2, m_InitialBlockBytes / 2),
+      m_CountingResource(&m_MonotonicResource)
+{
+}
+
+RequestArena::~RequestArena()
+{
+    LogStatis(GetUsedBytes());
+}
+
+google::protobuf::ArenaOptions RequestArena::MakeProtoArenaOptions(char *block, std::size_t block_bytes)
+{
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block;
+    options.initial_block_size = block_bytes;
+    return options;
+}
+
+std::size_t RequestArena::GetUsedBytes() const
+{
+    return static_cast<std::size_t>(m_ProtoArena.SpaceUsed()) + m_CountingResource.GetBytes();
+}
+
+void RequestArena::LogStatis(std::size_t used_bytes)
+{
+    static const long log_interval_sec = 10;
+
+    long request_count = gs_RequestCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    long total_bytes = gs_TotalUsedBytes.fetch_add(used_bytes, std::memory_order_relaxed) + used_bytes;
+    long max_bytes = gs_MaxUsedBytes.load(std::memory_order_relaxed);
+    while ((long)used_bytes > max_bytes &&
+           !gs_MaxUsedBytes.compare_exchange_weak(max_bytes, used_bytes, std::memory_order_relaxed))
+    {
+    }
+
+    long now_sec = std::chrono::duration_cast<std::chrono::seconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+    long last_sec = gs_LastLogTime.load(std::memory_order_relaxed);
+    if (now_sec - last_sec < log_interval_sec ||
+        !gs_LastLogTime.compare_exchange_strong(last_sec, now_sec))
+    {
+        return;
+    }
+
+    LOG(INFO) << "RequestArena Statis"
+              << ", request = " << request_count
+              << ", avg_used_bytes = " << total_bytes / request_count
+              << ", max_used_bytes = " << std::max<long>(max_bytes, used_bytes)
+              << ", initial_block_bytes = " << m_InitialBlockBytes;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include "google/protobuf/arena.h"
+
+// 请求级内存池, 请求结束时一次性释放
+// 1. Protobuf Arena: 请求/应答 Proto 与用户特征 Proto
+// 2. 单调内存资源: 请求内临时容器
+// 首块内存随对象一次分配, 由 Proto Arena 与单调资源各用一半
+// 对外提供的 Proto 指针持有本对象的引用, 排序工作线程等跨线程使用不会悬空
+class RequestArena : public std::enable_shared_from_this<RequestArena>
+{
+public:
+    // [in] initial_block_bytes 首块内存大小(字节)
+    static std::shared_ptr<RequestArena> Create(std::size_t initial_block_bytes);
+
+    ~RequestArena();
+    RequestArena(const RequestArena &) = delete;
+    RequestArena &operator=(const RequestArena &) = delete;
+
+    inline google::protobuf::Arena *GetProtoArena() noexcept { return &m_ProtoArena; }
+
+    // 与本对象共享生命周期的 Proto Arena
+    inline std::shared_ptr<google::protobuf::Arena> GetSPProtoArena()
+    {
+        return std::shared_ptr<google::protobuf::Arena>(shared_from_this(), &m_ProtoArena);
+    }
+
+    // 请求内临时容器使用, 非线程安全
+    inline std::pmr::memory_resource *GetResource() noexcept { return &m_CountingResource; }
+
+    // 已使用字节数: Proto Arena + 单调资源
+    std::size_t GetUsedBytes() const;
+
+    // 累计统计
+    static inline long GetRequestCount() noexcept { return gs_RequestCount.load(std::memory_order_relaxed); }
+    static inline long GetMaxUsedBytes() noexcept { return gs_MaxUsedBytes.load(std::memory_order_relaxed); }
+
+private:
+    // 统计经过的分配字节数
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit CountingResource(std::pmr::memory_resource *upstream) : m_Upstream(upstream) {}
+
+        inline std::size_t GetBytes() const noexcept { return m_Bytes; }
+
+    private:
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            m_Bytes += bytes;
+            return m_Upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+        {
+            m_Upstream->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        std::pmr::memory_resource *m_Upstream = nullptr;
+        std::size_t m_Bytes = 0;
+    };
+
+    RequestArena(std::size_t initial_block_bytes);
+
+    static google::protobuf::ArenaOptions MakeProtoArenaOptions(char *block, std::size_t block_bytes);
+
+    void LogStatis(std::size_t used_bytes);
+
+private:
+    // 声明顺序即构造顺序, 首块内存必须先于使用者构造、后于使用者析构
+    std::size_t m_InitialBlockBytes = 0;
+    std::unique_ptr<char[]> m_InitialBlock;
+    google::protobuf::Arena m_ProtoArena;
+    std::pmr::monotonic_buffer_resource m_MonotonicResource;
+    CountingResource m_CountingResource;
+
+    static inline std::atomic<long> gs_RequestCount = 0;
+    static inline std::atomic<long> gs_TotalUsedBytes = 0;
+    static inline std::atomic<long> gs_MaxUsedBytes = 0;
+    static inline std::atomic<long> gs_LastLogTime = 0;
+};
@@ -0,0 +1,104 @@
+#include "RequestCoalescer.h"
+#include <chrono>
+#include "glog/logging.h"
+
+// 定长字段直接写入, 变长字段带长度前缀, 不同请求不会拼出相同的键
+template <typename T>
+static inline void AppendPod(std::string &key, const T &value)
+{
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+std::string RequestCoalescer::MakeKey(
+    int cmd, long user_id, long context_item_id, int context_res_type,
+    const std::vector<int> &vecExpID, const std::vector<std::string> &vecKeynames,
+    int ret_count)
+{
+    std::string key;
+    key.reserve(64 + vecExpID.size() * sizeof(int) + vecKeynames.size() * 16);
+    AppendPod(key, cmd);
+    AppendPod(key, user_id);
+    AppendPod(key, context_item_id);
+    AppendPod(key, context_res_type);
+    AppendPod(key, ret_count);
+
+    AppendPod(key, vecExpID.size());
+    for (auto exp_id : vecExpID)
+    {
+        AppendPod(key, exp_id);
+    }
+
+    AppendPod(key, vecKeynames.size());
+    for (const auto &keyname : vecKeynames)
+    {
+        AppendPod(key, keyname.size());
+        key.append(keyname);
+    }
+    return key;
+}
+
+bool RequestCoalescer::Init(int max_wait_ms)
+{
+    if (max_wait_ms <= 0)
+    {
+        LOG(ERROR) << "RequestCoalescer::Init() params error"
+                   << ", max_wait_ms = " << max_wait_ms;
+        return false;
+    }
+
+    m_MaxWaitMs = max_wait_ms;
+    g_Init = true;
+
+    LOG(INFO) << "RequestCoalescer::Init() succ"
+              << ", max_wait_ms = " << max_wait_ms;
+    return true;
+}
+
+bool RequestCoalescer::Join(const std::string &key, FlightFuture &future)
+{
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    auto [iter, inserted] = shard.data.try_emplace(key);
+    if (inserted)
+    {
+        iter->second.future = iter->second.promise.get_future().share();
+        return true;
+    }
+
+    future = iter->second.future;
+    m_CoalescedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void RequestCoalescer::Complete(const std::string &key, int result, const std::string &response)
+{
+    auto &shard = GetShard(key);
+    std::promise<std::shared_ptr<const FlightResult>> promise;
+    {
+        std::lock_guard<std::mutex> lg(shard.mtx);
+        auto iter = shard.data.find(key);
+        if (iter == shard.data.end())
+        {
+            return;
+        }
+        promise = std::move(iter->second.promise);
+        shard.data.erase(iter);
+    }
+
+    // 锁外拷贝应答并唤醒等待者
+    auto spResult = std::make_shared<FlightResult>();
+    spResult->result = result;
+    spResult->response = response;
+    promise.set_value(std::move(spResult));
+}
+
+std::shared_ptr<const RequestCoalescer::FlightResult> RequestCoalescer::Wait(const FlightFuture &future, int wait_ms)
+{
+    if (future.wait_for(std::chrono::milliseconds(wait_ms)) != std::future_status::ready)
+    {
+        m_TimeoutCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return future.get();
+}
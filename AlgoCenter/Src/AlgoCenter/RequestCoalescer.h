@@ -0,0 +1,118 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Common/Singleton.h"
+
+// 相同在途请求合并(single-flight)
+// 客户端重试、重复触发的翻页会在毫秒级内发来相同请求, 首个请求完整计算, 其余请求等待并复用它的应答
+// 请求键由用户、上下文、实验列表、关键词与返回数量组成, 完整比较, 不会把结果交给不同的请求
+class RequestCoalescer : public Singleton<RequestCoalescer>
+{
+public:
+    // 请求结果, 与 OnDownloadRecommen 的 result/response 对应
+    struct FlightResult
+    {
+        int result = 0;
+        std::string response;
+    };
+    typedef std::shared_future<std::shared_ptr<const FlightResult>> FlightFuture;
+
+    // 生成请求键
+    static std::string MakeKey(int cmd, long user_id, long context_item_id, int context_res_type,
+                               const std::vector<int> &vecExpID, const std::vector<std::string> &vecKeynames,
+                               int ret_count);
+
+public:
+    // 初始化
+    // [in] max_wait_ms 重复请求最长等待时间(毫秒), 超时后自行计算
+    bool Init(int max_wait_ms);
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    inline int GetMaxWaitMs() const noexcept { return m_MaxWaitMs; }
+
+    // 加入请求
+    // 没有相同的在途请求时成为发起者, 返回 true, 计算完成后必须调用 Complete
+    // 否则返回 false, future 为发起者的结果
+    bool Join(const std::string &key, FlightFuture &future);
+
+    // 发起者完成计算, 唤醒等待的重复请求
+    void Complete(const std::string &key, int result, const std::string &response);
+
+    // 等待发起者的结果, 超时返回 nullptr
+    std::shared_ptr<const FlightResult> Wait(const FlightFuture &future, int wait_ms);
+
+    inline long GetCoalescedCount() const noexcept { return m_CoalescedCount.load(std::memory_order_relaxed); }
+    inline long GetTimeoutCount() const noexcept { return m_TimeoutCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Flight
+    {
+        std::promise<std::shared_ptr<const FlightResult>> promise;
+        FlightFuture future;
+    };
+
+    struct FlightShard
+    {
+        std::mutex mtx;
+        std::unordered_map<std::string, Flight> data;
+    };
+
+    static constexpr int ShardNum = 32;
+
+    inline FlightShard &GetShard(const std::string &key) noexcept
+    {
+        return m_Shard[std::hash<std::string>()(key) % ShardNum];
+    }
+
+private:
+    std::atomic<bool> g_Init = false;
+    int m_MaxWaitMs = 0;
+    FlightShard m_Shard[ShardNum];
+
+    std::atomic<long> m_CoalescedCount = 0;
+    std::atomic<long> m_TimeoutCount = 0;
+
+public:
+    RequestCoalescer(token) {}
+    ~RequestCoalescer() {}
+    RequestCoalescer(RequestCoalescer &) = delete;
+    RequestCoalescer &operator=(const RequestCoalescer &) = delete;
+};
+
+// 发起者守卫, 析构时提交结果, 所有返回路径都会唤醒等待者
+class CoalesceGuard
+{
+public:
+    CoalesceGuard(const int &result, const std::string &response)
+        : m_Result(result), m_Response(response)
+    {
+    }
+    ~CoalesceGuard()
+    {
+        if (m_Hold)
+        {
+            RequestCoalescer::GetInstance()->Complete(m_Key, m_Result, m_Response);
+        }
+    }
+    CoalesceGuard(const CoalesceGuard &) = delete;
+    CoalesceGuard &operator=(const CoalesceGuard &) = delete;
+
+    inline void Hold(std::string &&key) noexcept
+    {
+        m_Key = std::move(key);
+        m_Hold = true;
+    }
+
+private:
+    bool m_Hold = false;
+    std::string m_Key;
+    const int &m_Result;
+    const std::string &m_Response;
+};
@@ -7,16 +7,21 @@
 
 #include "Define.h"
 #include "APIType.h"
+#include "RequestArena.h"
 
 #include "Feature/UserFeature.h"
 #include "Feature/ItemFeature.h"
 
+struct ConfigSnapshot;
+
 class RequestData
 {
 public:
     int32_t InitUserFeature() noexcept
     {
-        int err = this->userFeature.InitUserFeature(this->user_id, this->context_item_id, this->context_res_type);
+        int err = this->userFeature.InitUserFeature(
+            this->user_id, this->context_item_id, this->context_res_type,
+            this->spArena != nullptr ? this->spArena->GetSPProtoArena() : nullptr);
         if (Common::Error::OK != err)
         {
             return err;
@@ -88,6 +93,19 @@ public:
     // 是否输出统计日志
     bool is_statis_log = false;
 
+    // 是否降级, 降级时召回后直接使用备用列表, 跳过特征、过滤与排序
+    bool is_degrade = false;
+
+    // 召回阶段截止时间(Common::get_ms_time), 0 表示不限制
+    double recall_deadline_ms = 0.0;
+
+public:
+    // 请求级内存池, 为空时使用默认分配
+    std::shared_ptr<RequestArena> spArena = nullptr;
+
+    // 请求开始时持有的配置快照(ConfigSnapshot.h), 请求内各层级配置一致
+    std::shared_ptr<const ConfigSnapshot> spConfigSnapshot = nullptr;
+
 public:
     UserFeature userFeature;
     ItemFeature itemFeature;
@@ -1,35 +1,49 @@
 #pragma once
+#include <string>
 #include <vector>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
 #include <unordered_map>
 
+// 物料信息, 平凡可拷贝, 召回类型名称通过 Common::GetRecallTypeName(recall_type_id) 获取
 struct ItemInfo
 {
     long item_id = 0;
     int res_type = 0;
-
-    long recall_type_id = 0;
-    std::string recall_type = "";
+    int recall_type_id = 0;
 
     float score = 0.0f;
     float sc_score = 0.0f;
 
-    ItemInfo() {}
+    ItemInfo() = default;
 
     ItemInfo(long _item_id,
              int _res_type,
-             long _recall_type_id,
-             const std::string &_recall_type,
+             int _recall_type_id,
              float _score,
              float _sc_score)
         : item_id(_item_id),
           res_type(_res_type),
           recall_type_id(_recall_type_id),
-          recall_type(_recall_type),
           score(_score),
           sc_score(_sc_score)
     {
     }
 };
+static_assert(std::is_trivially_copyable<ItemInfo>::value, "ItemInfo must be trivially copyable");
+static_assert(sizeof(ItemInfo) <= 32, "ItemInfo must fit in 32 bytes");
+
+// 降级标记, 按位组合
+enum DegradeFlag : uint32_t
+{
+    Degrade_None = 0,
+    Degrade_Admission = 1u << 0,   // 准入控制降级, 直接返回备用列表
+    Degrade_RecallSkip = 1u << 1,  // 召回超出预算, 跳过剩余渠道
+    Degrade_RankTrunc = 1u << 2,   // 前序超出预算, 截断排序数量
+    Degrade_ScatterSkip = 1u << 3, // 前序超出预算, 跳过打散
+    Degrade_FlagNum = 4,
+};
 
 class ResponseData
 {
@@ -42,4 +56,15 @@ public:
 
     // 独立召回集
     std::unordered_map<std::string, std::vector<ItemInfo>> exclusive_items_list;
+
+    // 粗排信息
+    int pre_rank_input_num = 0;                      // 粗排输入数量, 0表示未执行粗排
+    double pre_rank_time = 0.0;                      // 粗排耗时(ms)
+    std::unordered_map<long, int> pre_rank_position; // 物料键 -> 粗排位置
+
+    // 本次请求触发的降级, DegradeFlag 按位组合
+    uint32_t degrade_flags = Degrade_None;
+
+    // 各阶段耗时(毫秒), 阶段名 -> 耗时
+    std::vector<std::pair<std::string, double>> vecStageCost;
 };
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "RouteTable.h"
+#include "glog/logging.h"
+
+#include "Define.h"
+#include "StageBudgetConfig.h"
+#include "Recall/RecallConfig.h"
+#include "Filter/FilterConfig.h"
+#include "Display/DisplayConfig.h"
+
+bool RouteTable::Build(
+    const RecallConfigData &recallData,
+    const FilterConfigData &filterData,
+    const DisplayConfigData &displayData,
+    const StageBudgetConfigData &stageBudgetData)
+{
+    m_UserGroupID.clear();
+    m_vecAPIRoute.clear();
+
+    for (const auto &[apiType, mapExp] : recallData.m_RecallParamData)
+    {
+        auto &apiRoute = GetAPIRoute(apiType);
+        for (const auto &[exp_id, vecParamData] : mapExp)
+        {
+            BuildGroupRoute(vecParamData, apiRoute.mapRecall[exp_id]);
+        }
+    }
+
+    for (const auto &[apiType, mapExp] : filterData.m_FilterParamData)
+    {
+        auto &apiRoute = GetAPIRoute(apiType);
+        for (const auto &[exp_id, vecParamData] : mapExp)
+        {
+            BuildGroupRoute(vecParamData, apiRoute.mapFilter[exp_id]);
+        }
+    }
+
+    for (const auto &[apiType, mapExp] : displayData.m_DisplayParamData)
+    {
+        auto &apiRoute = GetAPIRoute(apiType);
+        for (const auto &[exp_id, vecParamData] : mapExp)
+        {
+            BuildGroupRoute(vecParamData, apiRoute.mapDisplay[exp_id]);
+        }
+    }
+
+    for (const auto &item : stageBudgetData.m_StageBudgetParam)
+    {
+        GetAPIRoute(item.first);
+    }
+
+    // 接口列表不再变化, 实验表可以安全引用各层级路由列表
+    for (auto &apiRoute : m_vecAPIRoute)
+    {
+        LinkExpRoute(apiRoute, stageBudgetData);
+    }
+
+    LOG(INFO) << "RouteTable::Build() succ"
+              << ", api_num = " << m_vecAPIRoute.size()
+              << ", user_group_num = " << m_UserGroupID.size();
+    return true;
+}
+
+UserGroupMask RouteTable::GetUserGroupMask(const std::unordered_set<std::string> &userGroupList) const
+{
+    UserGroupMask mask;
+    for (const auto &user_group : userGroupList)
+    {
+        auto it = m_UserGroupID.find(user_group);
+        if (it != m_UserGroupID.end())
+        {
+            mask.Set(it->second);
+        }
+    }
+    return mask;
+}
+
+void RouteTable::Route(
+    Common::APIType apiType,
+    const std::vector<int> &vecExpIDList,
+    const UserGroupMask &userGroupMask,
+    RoutePlan &plan) const
+{
+    plan = RoutePlan();
+
+    const APIRoute *pAPIRoute = nullptr;
+    for (const auto &apiRoute : m_vecAPIRoute)
+    {
+        if (apiRoute.apiType == static_cast<int>(apiType))
+        {
+            pAPIRoute = &apiRoute;
+            break;
+        }
+    }
+    if (pAPIRoute == nullptr)
+    {
+        return;
+    }
+
+    // 各层级取实验列表中第一个已配置的 exp_id
+    ExpRoute expRoute;
+    for (auto exp_id : vecExpIDList)
+    {
+        if (exp_id == 0)
+        {
+            continue;
+        }
+        auto itExp = pAPIRoute->mapExpRoute.find(exp_id);
+        if (itExp == pAPIRoute->mapExpRoute.end())
+        {
+            continue;
+        }
+        const auto &route = itExp->second;
+        if (expRoute.pRecall == nullptr && route.pRecall != nullptr)
+        {
+            expRoute.pRecall = route.pRecall;
+            plan.recallExpID = exp_id;
+        }
+        if (expRoute.pFilter == nullptr && route.pFilter != nullptr)
+        {
+            expRoute.pFilter = route.pFilter;
+            plan.filterExpID = exp_id;
+        }
+        if (expRoute.pDisplay == nullptr && route.pDisplay != nullptr)
+        {
+            expRoute.pDisplay = route.pDisplay;
+            plan.displayExpID = exp_id;
+        }
+        if (expRoute.pStageBudget == nullptr && route.pStageBudget != nullptr)
+        {
+            expRoute.pStageBudget = route.pStageBudget;
+        }
+    }
+
+    // 未命中实验的层级使用默认exp_id -> 0
+    auto itDef = pAPIRoute->mapExpRoute.find(0);
+    if (itDef != pAPIRoute->mapExpRoute.end())
+    {
+        const auto &route = itDef->second;
+        if (expRoute.pRecall == nullptr)
+        {
+            expRoute.pRecall = route.pRecall;
+        }
+        if (expRoute.pFilter == nullptr)
+        {
+            expRoute.pFilter = route.pFilter;
+        }
+        if (expRoute.pDisplay == nullptr)
+        {
+            expRoute.pDisplay = route.pDisplay;
+        }
+        if (expRoute.pStageBudget == nullptr)
+        {
+            expRoute.pStageBudget = route.pStageBudget;
+        }
+    }
+
+    plan.pRecallParamData = MatchGroup(expRoute.pRecall, userGroupMask);
+    plan.pFilterParamData = MatchGroup(expRoute.pFilter, userGroupMask);
+    plan.pDisplayParamData = MatchGroup(expRoute.pDisplay, userGroupMask);
+    plan.pStageBudget = expRoute.pStageBudget;
+}
+
+RouteTable::APIRoute &RouteTable::GetAPIRoute(int apiType)
+{
+    for (auto &apiRoute : m_vecAPIRoute)
+    {
+        if (apiRoute.apiType == apiType)
+        {
+            return apiRoute;
+        }
+    }
+    auto &apiRoute = m_vecAPIRoute.emplace_back();
+    apiRoute.apiType = apiType;
+    return apiRoute;
+}
+
+void RouteTable::LinkExpRoute(APIRoute &apiRoute, const StageBudgetConfigData &stageBudgetData)
+{
+    for (const auto &[exp_id, groupRouteList] : apiRoute.mapRecall)
+    {
+        apiRoute.mapExpRoute[exp_id].pRecall = &groupRouteList;
+    }
+    for (const auto &[exp_id, groupRouteList] : apiRoute.mapFilter)
+    {
+        apiRoute.mapExpRoute[exp_id].pFilter = &groupRouteList;
+    }
+    for (const auto &[exp_id, groupRouteList] : apiRoute.mapDisplay)
+    {
+        apiRoute.mapExpRoute[exp_id].pDisplay = &groupRouteList;
+    }
+
+    auto itType = stageBudgetData.m_StageBudgetParam.find(apiRoute.apiType);
+    if (itType != stageBudgetData.m_StageBudgetParam.end())
+    {
+        for (const auto &[exp_id, param] : itType->second)
+        {
+            apiRoute.mapExpRoute[exp_id].pStageBudget = &param;
+        }
+    }
+}
+
+int RouteTable::InternUserGroup(const std::string &user_group)
+{
+    if (user_group == Common::DefaultUserGroup)
+    {
+        return DefaultUserGroupID;
+    }
+
+    auto it = m_UserGroupID.find(user_group);
+    if (it == m_UserGroupID.end())
+    {
+        it = m_UserGroupID.emplace(user_group, static_cast<int>(m_UserGroupID.size())).first;
+    }
+    return it->second;
+}
+
+template <typename T>
+void RouteTable::BuildGroupRoute(const std::vector<T> &vecParamData, GroupRouteList<T> &groupRouteList)
+{
+    groupRouteList.clear();
+    groupRouteList.reserve(vecParamData.size());
+    for (const auto &paramData : vecParamData)
+    {
+        int group_id = InternUserGroup(paramData.user_group);
+        groupRouteList.emplace_back(group_id, &paramData);
+
+        // 默认组之后的配置不会被匹配
+        if (group_id == DefaultUserGroupID)
+        {
+            break;
+        }
+    }
+}
+
+// 按配置顺序匹配, 命中用户所属组或遇到默认组即返回
+template <typename T>
+const T *RouteTable::MatchGroup(const GroupRouteList<T> *pGroupRouteList, const UserGroupMask &userGroupMask)
+{
+    if (pGroupRouteList == nullptr)
+    {
+        return nullptr;
+    }
+    for (const auto &[group_id, pParamData] : *pGroupRouteList)
+    {
+        if (group_id == DefaultUserGroupID || userGroupMask.Test(group_id))
+        {
+            return pParamData;
+        }
+    }
+    return nullptr;
+}
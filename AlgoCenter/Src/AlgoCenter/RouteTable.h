@@ -0,0 +1,139 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "APIType.h"
+
+struct RecallConfigData;
+struct FilterConfigData;
+struct DisplayConfigData;
+struct StageBudgetConfigData;
+
+struct RecallParamData;
+struct FilterParamData;
+struct DisplayParamData;
+struct StageBudgetParam;
+
+// 一次请求的路由结果, 指针指向配置快照内数据, 随快照一起有效
+struct RoutePlan
+{
+    int recallExpID = 0;
+    int filterExpID = 0;
+    int displayExpID = 0;
+
+    const RecallParamData *pRecallParamData = nullptr;
+    const FilterParamData *pFilterParamData = nullptr;
+    const DisplayParamData *pDisplayParamData = nullptr;
+    const StageBudgetParam *pStageBudget = nullptr; // 未配置时为 nullptr
+};
+
+// 请求所属用户组位图, 按用户组编号置位
+// 前 64 个用户组存放在定长字段, 超出部分按需分配, 用户组较少时不分配内存
+class UserGroupMask
+{
+public:
+    inline void Set(int group_id)
+    {
+        if (group_id < 64)
+        {
+            m_Low |= 1ULL << group_id;
+            return;
+        }
+
+        size_t word = static_cast<size_t>(group_id / 64 - 1);
+        if (m_vecHigh.size() <= word)
+        {
+            m_vecHigh.resize(word + 1, 0);
+        }
+        m_vecHigh[word] |= 1ULL << (group_id % 64);
+    }
+
+    inline bool Test(int group_id) const noexcept
+    {
+        if (group_id < 64)
+        {
+            return (m_Low & (1ULL << group_id)) != 0;
+        }
+
+        size_t word = static_cast<size_t>(group_id / 64 - 1);
+        return word < m_vecHigh.size() && (m_vecHigh[word] & (1ULL << (group_id % 64))) != 0;
+    }
+
+private:
+    uint64_t m_Low = 0;
+    std::vector<uint64_t> m_vecHigh; // 编号 64 及以上
+};
+
+// 实验路由表, 配置快照发布时由召回/过滤/展控/阶段预算配置编译生成
+// 1. 用户组名称统一编号, 请求所属用户组转为位图, 按组匹配只做位测试, 用户组数量不设上限
+// 2. 每个接口下以 exp_id 建一张表, 同时记录各层级是否配置该实验, 请求的实验列表只遍历一次
+// 3. 各层级在实验下的用户组配置按原顺序展开为(位图, 配置)列表, 默认组匹配任意用户
+// 匹配规则与原各层级配置一致: 各层级取实验列表中第一个已配置的 exp_id, 未命中用 exp_id = 0
+class RouteTable
+{
+public:
+    RouteTable() = default;
+    RouteTable(const RouteTable &) = delete;
+    RouteTable &operator=(const RouteTable &) = delete;
+
+    // 编译路由表
+    bool Build(const RecallConfigData &recallData,
+               const FilterConfigData &filterData,
+               const DisplayConfigData &displayData,
+               const StageBudgetConfigData &stageBudgetData);
+
+    // 请求所属用户组位图, 未编号的用户组忽略
+    UserGroupMask GetUserGroupMask(const std::unordered_set<std::string> &userGroupList) const;
+
+    // 按接口、实验列表与用户组位图路由, 层级未命中配置时对应指针为 nullptr
+    void Route(Common::APIType apiType, const std::vector<int> &vecExpIDList, const UserGroupMask &userGroupMask, RoutePlan &plan) const;
+
+private:
+    // 默认组编号, 匹配任意用户
+    static const int DefaultUserGroupID = -1;
+
+    // (用户组编号, 配置)列表
+    template <typename T>
+    using GroupRouteList = std::vector<std::pair<int, const T *>>;
+
+    // 单个实验在各层级的用户组路由, 层级未配置该实验时为 nullptr
+    struct ExpRoute
+    {
+        const GroupRouteList<RecallParamData> *pRecall = nullptr;
+        const GroupRouteList<FilterParamData> *pFilter = nullptr;
+        const GroupRouteList<DisplayParamData> *pDisplay = nullptr;
+        const StageBudgetParam *pStageBudget = nullptr;
+    };
+
+    struct APIRoute
+    {
+        int apiType = 0;
+        std::unordered_map<int, ExpRoute> mapExpRoute;
+
+        std::unordered_map<int, GroupRouteList<RecallParamData>> mapRecall;
+        std::unordered_map<int, GroupRouteList<FilterParamData>> mapFilter;
+        std::unordered_map<int, GroupRouteList<DisplayParamData>> mapDisplay;
+    };
+
+    APIRoute &GetAPIRoute(int apiType);
+
+    // 各层级路由列表生成后, 汇总到实验表
+    void LinkExpRoute(APIRoute &apiRoute, const StageBudgetConfigData &stageBudgetData);
+
+    // 用户组编号, 默认组返回 DefaultUserGroupID
+    int InternUserGroup(const std::string &user_group);
+
+    template <typename T>
+    void BuildGroupRoute(const std::vector<T> &vecParamData, GroupRouteList<T> &groupRouteList);
+
+    template <typename T>
+    static const T *MatchGroup(const GroupRouteList<T> *pGroupRouteList, const UserGroupMask &userGroupMask);
+
+private:
+    std::unordered_map<std::string, int> m_UserGroupID; // 用户组名称 -> 编号
+    std::vector<APIRoute> m_vecAPIRoute;                // 接口数量很少, 顺序查找
+};
@@ -0,0 +1,326 @@
+#include "SampleLogPipeline.h"
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include "glog/logging.h"
+#include "Common/Function.h"
+
+#include "rapidjson/writer.h"
+#include "rapidjson/stringbuffer.h"
+
+#include "KafkaClient/PushKafkaPool.h"
+
+#include "Define.h"
+
+namespace
+{
+    static const uint8_t SampleLogVersion = 1;
+
+    void PutVarint(std::string &output, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            output.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(static_cast<char>(value));
+    }
+
+    void PutZigZag(std::string &output, int64_t value)
+    {
+        PutVarint(output, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void PutString(std::string &output, const std::string &value)
+    {
+        PutVarint(output, value.size());
+        output.append(value);
+    }
+
+    void PutFloat(std::string &output, float value)
+    {
+        char buffer[sizeof(float)];
+        std::memcpy(buffer, &value, sizeof(float));
+        output.append(buffer, sizeof(float));
+    }
+
+    // 单个 Topic 的待推送批次
+    struct TopicBatch
+    {
+        std::string buffer;
+        int record_num = 0;
+        double first_time = 0.0;
+    };
+}
+
+bool SampleLogPipeline::Init(
+    const int queue_size,
+    const int batch_num,
+    const int batch_wait_ms)
+{
+    if (queue_size <= 0 || batch_num <= 0 || batch_wait_ms <= 0)
+    {
+        LOG(ERROR) << "SampleLogPipeline::Init() param error"
+                   << ", queue_size = " << queue_size
+                   << ", batch_num = " << batch_num
+                   << ", batch_wait_ms = " << batch_wait_ms;
+        return false;
+    }
+
+    m_BatchNum = batch_num;
+    m_BatchWaitMs = batch_wait_ms;
+    m_QueuePtr = std::make_unique<MPSCQueue<SampleLogRecord>>(queue_size);
+
+    g_Init = true;
+    g_WorkThreadPtr = std::make_shared<std::thread>(std::bind(&SampleLogPipeline::OnWork, this));
+
+    LOG(INFO) << "SampleLogPipeline::Init() start success"
+              << ", queue_capacity = " << m_QueuePtr->Capacity()
+              << ", batch_num = " << batch_num
+              << ", batch_wait_ms = " << batch_wait_ms;
+
+    return true;
+}
+
+void SampleLogPipeline::ShutDown()
+{
+    if (g_Init)
+    {
+        g_Init = false;
+        {
+            std::lock_guard<std::mutex> lg(m_Mutex);
+        }
+        m_Cond.notify_one();
+
+        if (g_WorkThreadPtr->joinable())
+        {
+            g_WorkThreadPtr->join();
+            LOG(INFO) << "SampleLogPipeline::ShutDown() g_WorkThreadPtr.join() finish"
+                      << ", push_count = " << m_PushCount
+                      << ", drop_count = " << m_DropCount
+                      << ", uninit_drop_count = " << m_UninitDropCount;
+        }
+    }
+}
+
+bool SampleLogPipeline::Push(SampleLogRecord &&record) noexcept
+{
+    if (!g_Init)
+    {
+        long uninit_drop_count = ++m_UninitDropCount;
+        if ((uninit_drop_count % 1000) == 1)
+        {
+            LOG(WARNING) << "SampleLogPipeline::Push() not init, drop record"
+                         << ", uninit_drop_count = " << uninit_drop_count;
+        }
+        return false;
+    }
+
+    if (!m_QueuePtr->TryPush(std::move(record)))
+    {
+        long drop_count = ++m_DropCount;
+        if ((drop_count % 1000) == 1)
+        {
+            LOG(WARNING) << "SampleLogPipeline::Push() queue full, drop record"
+                         << ", drop_count = " << drop_count;
+        }
+        return false;
+    }
+
+    m_PushCount++;
+
+    // 与后台线程入睡前的检查配对: 要么后台线程看到新记录, 要么这里看到 m_Sleeping 并唤醒
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_Sleeping.load(std::memory_order_relaxed))
+    {
+        {
+            std::lock_guard<std::mutex> lg(m_Mutex);
+        }
+        m_Cond.notify_one();
+    }
+    return true;
+}
+
+void SampleLogPipeline::EncodeRecord(const SampleLogRecord &record, std::string &output)
+{
+    std::string body;
+    body.reserve(256);
+    body.push_back(static_cast<char>(SampleLogVersion));
+    PutString(body, record.type);
+    PutVarint(body, record.add_time);
+    PutString(body, record.uuid);
+    PutVarint(body, record.user_id);
+    PutVarint(body, record.context_item_id);
+    PutVarint(body, record.context_res_type);
+
+    size_t feature_num = 0;
+    if (record.spFeatureData != nullptr)
+    {
+        for (const auto &field_item_list : record.spFeatureData->common_feature)
+        {
+            feature_num += field_item_list.size();
+        }
+    }
+    PutVarint(body, feature_num);
+
+    if (record.spFeatureData != nullptr)
+    {
+        for (const auto &field_item_list : record.spFeatureData->common_feature)
+        {
+            for (const auto &field_item : field_item_list)
+            {
+                PutZigZag(body, field_item.field_value.field_value());
+                PutFloat(body, field_item.weight);
+            }
+        }
+    }
+
+    PutVarint(output, body.size());
+    output.append(body);
+}
+
+void SampleLogPipeline::EncodeJson(const SampleLogRecord &record, std::string &output)
+{
+    rapidjson::StringBuffer logBuf;
+    rapidjson::Writer<rapidjson::StringBuffer> logWriter(logBuf);
+    logWriter.StartObject();
+    {
+        logWriter.Key("type");
+        logWriter.String(record.type.c_str(), record.type.size());
+
+        logWriter.Key("data");
+        logWriter.StartObject();
+        {
+            logWriter.Key("add_time");
+            logWriter.Int64(record.add_time);
+            logWriter.Key("request_id");
+            logWriter.String(record.uuid.c_str(), record.uuid.size());
+            logWriter.Key("user_id");
+            logWriter.Int64(record.user_id);
+            logWriter.Key("context_item_id");
+            logWriter.Int64(record.context_item_id);
+            logWriter.Key("context_res_type");
+            logWriter.Int(record.context_res_type);
+
+            // 公共特征
+            logWriter.Key("common_feature");
+            logWriter.StartArray();
+            if (record.spFeatureData != nullptr)
+            {
+                for (const auto &field_item_list : record.spFeatureData->common_feature)
+                {
+                    for (const auto &field_item : field_item_list)
+                    {
+                        logWriter.StartObject();
+                        {
+                            std::string field_value = std::to_string(field_item.field_value.field_value());
+                            logWriter.Key(field_value.c_str(), field_value.size());
+                            logWriter.Double(field_item.weight);
+                        }
+                        logWriter.EndObject();
+                    }
+                }
+            }
+            logWriter.EndArray();
+        }
+        logWriter.EndObject();
+    }
+    logWriter.EndObject();
+
+    output.append(logBuf.GetString(), logBuf.GetSize());
+}
+
+void SampleLogPipeline::OnWork()
+{
+    std::unordered_map<std::string, TopicBatch> topic_batch;
+
+    auto lambda_push = [](const std::string &topic, std::string &&msg)
+    {
+        TDKafkaData kafka_data;
+        kafka_data.msg = std::move(msg);
+        kafka_data.topic_id = topic;
+        kafka_data.partition = RdKafka::Topic::PARTITION_UA;
+
+        int free_threads_num = 0;
+        int queue_tasks_num = 0;
+        PushKafkaPool::GetInstance()->Push(std::move(kafka_data), free_threads_num, queue_tasks_num);
+    };
+
+    auto lambda_flush = [&lambda_push](const std::string &topic, TopicBatch &batch)
+    {
+        lambda_push(topic, std::move(batch.buffer));
+        batch.buffer.clear();
+        batch.record_num = 0;
+    };
+
+    SampleLogRecord record;
+    bool running = true;
+    while (running)
+    {
+        // 退出前把队列中剩余的记录处理完
+        running = g_Init;
+
+        while (m_QueuePtr->TryPop(record))
+        {
+            if (!record.binary)
+            {
+                // 原 JSON 格式逐条推送
+                std::string msg;
+                EncodeJson(record, msg);
+                LOG(DATA) << msg;
+                lambda_push(record.topic, std::move(msg));
+                record = SampleLogRecord();
+                continue;
+            }
+
+            auto &batch = topic_batch[record.topic];
+            if (batch.record_num == 0)
+            {
+                batch.first_time = Common::get_ms_time();
+            }
+            EncodeRecord(record, batch.buffer);
+            batch.record_num++;
+
+            if (batch.record_num >= m_BatchNum)
+            {
+                lambda_flush(record.topic, batch);
+            }
+            record = SampleLogRecord();
+        }
+
+        // 超过等待时间的批次, 或退出时的剩余批次; 同时计算最近一个批次的剩余等待时间
+        double now_time = Common::get_ms_time();
+        double wait_ms = m_BatchWaitMs;
+        for (auto &iter : topic_batch)
+        {
+            auto &batch = iter.second;
+            if (batch.record_num <= 0)
+            {
+                continue;
+            }
+
+            double remain_ms = m_BatchWaitMs - (now_time - batch.first_time);
+            if (!running || remain_ms <= 0)
+            {
+                lambda_flush(iter.first, batch);
+                continue;
+            }
+            wait_ms = std::min(wait_ms, remain_ms);
+        }
+
+        if (!running)
+        {
+            break;
+        }
+
+        // 队列为空时等待 Push 唤醒, 最多等到最近一个批次到期
+        std::unique_lock<std::mutex> lk(m_Mutex);
+        m_Sleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        m_Cond.wait_for(lk, std::chrono::microseconds(static_cast<long>(wait_ms * 1000) + 1),
+                        [this]()
+                        { return !g_Init || !m_QueuePtr->Empty(); });
+        m_Sleeping.store(false, std::memory_order_relaxed);
+    }
+}
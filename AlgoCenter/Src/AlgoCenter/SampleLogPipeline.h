@@ -0,0 +1,97 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <condition_variable>
+#include "Common/Singleton.h"
+
+#include "TDPredict/RankCalc/RankCalc.h"
+
+#include "MPSCQueue.h"
+
+// 样本日志记录, 请求线程只填充原始字段, 特征数据与 RankItem 共享不做拷贝
+struct SampleLogRecord
+{
+    std::string type;
+    std::string topic;
+    bool binary = false; // true 时按二进制格式攒批推送, 否则按原 JSON 格式逐条推送
+    long add_time = 0;
+    std::string uuid;
+    long user_id = 0;
+    long context_item_id = 0;
+    int context_res_type = 0;
+    decltype(TDPredict::RankItem::spFeatureData) spFeatureData;
+};
+
+// 异步样本日志推送
+// 请求线程通过 Push 入无锁队列, 队列满时丢弃并计数; 后台线程空闲时等待条件变量, 由 Push 唤醒.
+// 后台线程按记录格式编码后推送 Kafka:
+// 1. JSON(默认): 与原格式一致, 每条记录一条消息, 同时输出 DATA 日志
+// 2. 二进制: 配置 KafkaPush.BinaryTopic 后推送到该 Topic, 按 Topic 攒批, 原 Topic 的消费方不受影响
+//
+// 二进制消息体由若干条记录拼接, 每条为 [varint 长度][记录], 记录格式:
+//   uint8   version (=1)
+//   string  type                       字符串均为 [varint 长度][字节]
+//   varint  add_time
+//   string  uuid
+//   varint  user_id
+//   varint  context_item_id
+//   varint  context_res_type
+//   varint  feature_num
+//   feature_num * { zigzag-varint field_value, float32(LE) weight }   公共特征
+class SampleLogPipeline : public Singleton<SampleLogPipeline>
+{
+public:
+    SampleLogPipeline(token) {}
+    virtual ~SampleLogPipeline() {}
+    SampleLogPipeline(const SampleLogPipeline &) = delete;
+    SampleLogPipeline &operator=(const SampleLogPipeline &) = delete;
+
+public:
+    bool Init(
+        const int queue_size,
+        const int batch_num,
+        const int batch_wait_ms);
+
+    // 停止后台线程, 剩余数据推送后退出
+    void ShutDown();
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 请求线程调用, 未初始化或队列满时丢弃并分别计数, 返回 false
+    bool Push(SampleLogRecord &&record) noexcept;
+
+    long GetDropCount() const noexcept { return m_DropCount; }
+
+    long GetUninitDropCount() const noexcept { return m_UninitDropCount; }
+
+    // 二进制记录编码, 追加到 output
+    static void EncodeRecord(const SampleLogRecord &record, std::string &output);
+
+    // JSON 记录编码, 与原推送格式一致
+    static void EncodeJson(const SampleLogRecord &record, std::string &output);
+
+private:
+    void OnWork();
+
+private:
+    std::atomic<bool> g_Init = false;
+    std::shared_ptr<std::thread> g_WorkThreadPtr;
+
+    std::unique_ptr<MPSCQueue<SampleLogRecord>> m_QueuePtr;
+
+    // 后台线程空闲等待, m_Sleeping 为 true 时 Push 才加锁唤醒
+    std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+    std::atomic<bool> m_Sleeping = false;
+
+    int m_BatchNum = 0;
+    int m_BatchWaitMs = 0;
+
+    // 统计
+    std::atomic<long> m_PushCount = 0;
+    std::atomic<long> m_DropCount = 0;       // 队列满丢弃
+    std::atomic<long> m_UninitDropCount = 0; // 未初始化丢弃
+};
@@ -0,0 +1,171 @@
+#include "SessionCache.h"
+#include <chrono>
+#include <algorithm>
+#include "glog/logging.h"
+
+// 单个会话除物料列表外的固定开销估算: 哈希节点 + LRU 节点
+static const size_t s_SessionOverheadBytes = sizeof(SessionCache::SessionKey) * 2 + 128;
+
+uint64_t SessionCache::HashExpList(const std::vector<int> &vecExpID) noexcept
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (auto exp_id : vecExpID)
+    {
+        h ^= static_cast<uint32_t>(exp_id);
+        h *= 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// FNV-1a 追加定长字段
+template <typename T>
+static inline void HashPod(uint64_t &h, const T &value) noexcept
+{
+    const auto *data = reinterpret_cast<const unsigned char *>(&value);
+    for (size_t idx = 0; idx < sizeof(value); idx++)
+    {
+        h ^= data[idx];
+        h *= 0x100000001b3ULL;
+    }
+}
+
+uint64_t SessionCache::HashKeynames(const std::vector<std::string> &vecKeynames) noexcept
+{
+    uint64_t h = 0xcbf29ce484222325ULL;
+    HashPod(h, vecKeynames.size());
+    for (const auto &keyname : vecKeynames)
+    {
+        HashPod(h, keyname.size());
+        for (unsigned char c : keyname)
+        {
+            h ^= c;
+            h *= 0x100000001b3ULL;
+        }
+    }
+    return h;
+}
+
+bool SessionCache::Init(int ttl_ms, int memory_budget_mb)
+{
+    if (ttl_ms <= 0 || memory_budget_mb <= 0)
+    {
+        LOG(ERROR) << "SessionCache::Init() params error"
+                   << ", ttl_ms = " << ttl_ms
+                   << ", memory_budget_mb = " << memory_budget_mb;
+        return false;
+    }
+
+    m_TTLMs = ttl_ms;
+    m_ShardBytesLimit = std::max<size_t>(1, static_cast<size_t>(memory_budget_mb) * 1024 * 1024 / ShardNum);
+    g_Init = true;
+
+    LOG(INFO) << "SessionCache::Init() succ"
+              << ", ttl_ms = " << ttl_ms
+              << ", memory_budget_mb = " << memory_budget_mb
+              << ", shard_bytes_limit = " << m_ShardBytesLimit;
+    return true;
+}
+
+bool SessionCache::Fetch(const SessionKey &key, const std::string &uuid, int ret_count, std::vector<ItemInfo> &vecItem)
+{
+    if (ret_count <= 0)
+    {
+        return false;
+    }
+
+    long now_ms = GetNowMs();
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    auto iter = shard.data.find(key);
+    if (iter == shard.data.end())
+    {
+        m_MissCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto &node = iter->second;
+    if (node.expire_ms > now_ms && !uuid.empty() && uuid == node.last_uuid)
+    {
+        // 同一请求重试, 返回上次的区间, 游标不前进
+        vecItem.assign(node.vecItem.begin() + node.last_begin, node.vecItem.begin() + node.cursor);
+        shard.lru.splice(shard.lru.begin(), shard.lru, node.lru_iter);
+
+        m_HitCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (node.expire_ms <= now_ms || node.cursor >= node.vecItem.size())
+    {
+        // 过期或已取完, 由完整请求重新计算
+        Erase(shard, iter);
+        m_MissCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t end = std::min(node.vecItem.size(), node.cursor + static_cast<size_t>(ret_count));
+    vecItem.assign(node.vecItem.begin() + node.cursor, node.vecItem.begin() + end);
+    node.last_begin = node.cursor;
+    node.last_uuid = uuid;
+    node.cursor = end;
+    shard.lru.splice(shard.lru.begin(), shard.lru, node.lru_iter);
+
+    m_HitCount.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void SessionCache::Store(const SessionKey &key, const std::string &uuid, std::vector<ItemInfo> &&vecItem, int served_num)
+{
+    size_t cursor = static_cast<size_t>(std::max(0, served_num));
+    if (cursor >= vecItem.size())
+    {
+        return;
+    }
+
+    size_t bytes = vecItem.size() * sizeof(ItemInfo) + s_SessionOverheadBytes;
+    auto &shard = GetShard(key);
+    if (bytes > m_ShardBytesLimit)
+    {
+        return;
+    }
+
+    long expire_ms = GetNowMs() + m_TTLMs;
+
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    auto iter = shard.data.find(key);
+    if (iter != shard.data.end())
+    {
+        Erase(shard, iter);
+    }
+
+    // 超出内存预算, 淘汰最久未使用
+    while (shard.bytes + bytes > m_ShardBytesLimit && !shard.lru.empty())
+    {
+        Erase(shard, shard.data.find(shard.lru.back()));
+    }
+
+    shard.lru.push_front(key);
+    auto &node = shard.data[key];
+    node.vecItem = std::move(vecItem);
+    node.cursor = cursor;
+    node.last_begin = 0;
+    node.last_uuid = uuid;
+    node.bytes = bytes;
+    node.expire_ms = expire_ms;
+    node.lru_iter = shard.lru.begin();
+    shard.bytes += bytes;
+}
+
+void SessionCache::Erase(SessionShard &shard, std::unordered_map<SessionKey, SessionNode, SessionKeyHash>::iterator iter)
+{
+    shard.bytes -= iter->second.bytes;
+    shard.lru.erase(iter->second.lru_iter);
+    shard.data.erase(iter);
+}
+
+long SessionCache::GetNowMs() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Common/Singleton.h"
+#include "ResponseData.h"
+
+// 翻页会话缓存, 同一用户在同一上下文下连续翻页时直接返回上次计算的结果
+// 1. 完整请求计算出的排序打散列表, 除本次返回的部分外按会话键缓存, 有效期较短
+// 2. 后续请求按游标依次取下一页, 已返回的物料不会再出现, 取完或过期后重新计算
+//    会话记录最近一次返回的区间与请求 uuid, 客户端重试(uuid 相同)时返回同一页, 新 uuid 才前进
+//    会话键包含关键词列表, 关键词不同的翻页请求不会取到其他关键词的列表
+// 3. 分片 LRU, 按列表字节数计入内存预算
+class SessionCache : public Singleton<SessionCache>
+{
+public:
+    // 会话键, 用户 + 上下文 + 实验列表 + 关键词列表
+    struct SessionKey
+    {
+        long user_id = 0;
+        long context_item_id = 0;
+        int context_res_type = 0;
+        uint64_t exp_hash = 0;
+        uint64_t keyname_hash = 0;
+
+        bool operator==(const SessionKey &other) const noexcept
+        {
+            return user_id == other.user_id &&
+                   context_item_id == other.context_item_id &&
+                   context_res_type == other.context_res_type &&
+                   exp_hash == other.exp_hash &&
+                   keyname_hash == other.keyname_hash;
+        }
+    };
+
+    // 实验列表哈希, 顺序相关(各层级按顺序匹配实验)
+    static uint64_t HashExpList(const std::vector<int> &vecExpID) noexcept;
+
+    // 关键词列表哈希, 关键词驱动其他场景召回, 不同关键词不能共用会话
+    // 与 RequestCoalescer::MakeKey 一致, 数量与每个关键词都带长度前缀, 拼接方式不同的列表不会相同
+    static uint64_t HashKeynames(const std::vector<std::string> &vecKeynames) noexcept;
+
+public:
+    // 初始化
+    // [in] ttl_ms 会话有效期(毫秒), 自完整计算起算
+    // [in] memory_budget_mb 内存预算(MB)
+    bool Init(int ttl_ms, int memory_budget_mb);
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 取下一页
+    // [in] uuid 请求 uuid, 与上次返回的请求相同时重新返回上一页
+    // [in] ret_count 本页数量
+    // [out] vecItem 本页物料
+    // 未命中、过期或已取完返回 false
+    bool Fetch(const SessionKey &key, const std::string &uuid, int ret_count, std::vector<ItemInfo> &vecItem);
+
+    // 写入会话
+    // [in] uuid 完整计算的请求 uuid, 重试时重新返回第一页
+    // [in] vecItem 完整列表
+    // [in] served_num 本次已返回的数量, 下一页从这里开始
+    void Store(const SessionKey &key, const std::string &uuid, std::vector<ItemInfo> &&vecItem, int served_num);
+
+    inline long GetHitCount() const noexcept { return m_HitCount.load(std::memory_order_relaxed); }
+    inline long GetMissCount() const noexcept { return m_MissCount.load(std::memory_order_relaxed); }
+
+private:
+    struct SessionKeyHash
+    {
+        size_t operator()(const SessionKey &key) const noexcept
+        {
+            uint64_t h = static_cast<uint64_t>(key.user_id) * 0x9E3779B97F4A7C15ULL;
+            h ^= static_cast<uint64_t>(key.context_item_id) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            h ^= static_cast<uint64_t>(key.context_res_type) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            h ^= key.exp_hash + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            h ^= key.keyname_hash + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    struct SessionNode
+    {
+        std::vector<ItemInfo> vecItem;
+        size_t cursor = 0; // 下一页起始位置
+        size_t last_begin = 0; // 最近一次返回的区间 [last_begin, cursor)
+        std::string last_uuid; // 最近一次返回的请求 uuid
+        size_t bytes = 0;
+        long expire_ms = 0;
+        std::list<SessionKey>::iterator lru_iter;
+    };
+
+    struct SessionShard
+    {
+        std::mutex mtx;
+        size_t bytes = 0;
+        std::list<SessionKey> lru; // 头部最近使用
+        std::unordered_map<SessionKey, SessionNode, SessionKeyHash> data;
+    };
+
+    static constexpr int ShardNum = 32;
+
+    inline SessionShard &GetShard(const SessionKey &key) noexcept
+    {
+        return m_Shard[SessionKeyHash()(key) % ShardNum];
+    }
+
+    // 删除会话, 调用方持有分片锁
+    void Erase(SessionShard &shard, std::unordered_map<SessionKey, SessionNode, SessionKeyHash>::iterator iter);
+
+    static long GetNowMs() noexcept;
+
+private:
+    std::atomic<bool> g_Init = false;
+    long m_TTLMs = 0;
+    size_t m_ShardBytesLimit = 0;
+    SessionShard m_Shard[ShardNum];
+
+    std::atomic<long> m_HitCount = 0;
+    std::atomic<long> m_MissCount = 0;
+
+public:
+    SessionCache(token) {}
+    ~SessionCache() {}
+    SessionCache(SessionCache &) = delete;
+    SessionCache &operator=(const SessionCache &) = delete;
+};
@@ -0,0 +1,112 @@
+#include "StageBudgetConfig.h"
+#include <algorithm>
+#include "glog/logging.h"
+#include "Common/Function.h"
+
+static const std::unordered_map<std::string, Common::APIType> StageBudgetName2CmdType = {
+    std::make_pair<std::string, Common::APIType>("Download_Recommend", Common::APIType::Get_Download_Recommend),
+};
+
+bool StageBudgetConfig::UpdateJson(const std::string &jsonData)
+{
+    std::lock_guard<std::mutex> lg(m_update_lock);
+    if (jsonData.empty())
+    {
+        LOG(ERROR) << "StageBudgetConfig::UpdateJson() json_data empty.";
+        return false;
+    }
+    return DecodeJsonData(jsonData) == StageBudgetConfig::Error::OK;
+}
+
+StageBudgetConfig::Error StageBudgetConfig::DecodeJsonData(const std::string &jsonData)
+{
+    rapidjson::Document doc;
+    if (doc.Parse(jsonData.data()).HasParseError())
+    {
+        LOG(ERROR) << "DecodeJsonData() Parse jsonData HasParseError. err = " << doc.GetParseError();
+        return StageBudgetConfig::Error::ParseError;
+    }
+
+    // 在新对象上解析, 完成后整体替换, 已持有旧数据的请求不受影响
+    auto spData = std::make_shared<StageBudgetConfigData>();
+
+    // 解析阶段预算配置
+    auto cfgErr = DecodeStageBudgetParam(doc, *spData);
+    if (cfgErr != StageBudgetConfig::Error::OK)
+    {
+        return cfgErr;
+    }
+
+    std::atomic_store(&m_spData, std::shared_ptr<const StageBudgetConfigData>(std::move(spData)));
+
+    return StageBudgetConfig::Error::OK;
+}
+
+// 阶段预算配置
+StageBudgetConfig::Error StageBudgetConfig::DecodeStageBudgetParam(rapidjson::Document &doc, StageBudgetConfigData &data)
+{
+    if (!doc.HasMember("StageBudget") || !doc["StageBudget"].IsObject())
+    {
+        LOG(ERROR) << "DecodeStageBudgetParam() StageBudget Not Find Or Not Object.";
+        return StageBudgetConfig::Error::DecodeStageBudgetParamError;
+    }
+
+    auto lambda_get_int = [](const rapidjson::Value &object, const char *key) -> int
+    {
+        if (object.HasMember(key) && object[key].IsInt())
+        {
+            return std::max(0, object[key].GetInt());
+        }
+        return 0;
+    };
+
+    auto StageBudgetObject = doc["StageBudget"].GetObject();
+    for (auto &api : StageBudgetName2CmdType)
+    {
+        const char *apiName = api.first.c_str();
+        int apiType = static_cast<int>(api.second);
+
+        // 未配置的接口不做预算控制
+        if (!StageBudgetObject.HasMember(apiName))
+        {
+            continue;
+        }
+
+        if (!StageBudgetObject[apiName].IsArray())
+        {
+            LOG(ERROR) << "DecodeStageBudgetParam() Parse " << apiName << " not array.";
+            return StageBudgetConfig::Error::DecodeStageBudgetParamError;
+        }
+
+        auto apiParamList = StageBudgetObject[apiName].GetArray();
+        rapidjson::SizeType ParamListSize = apiParamList.Size();
+        for (rapidjson::SizeType ParamListIdx = 0; ParamListIdx < ParamListSize; ++ParamListIdx)
+        {
+            const auto &ParamListItem = apiParamList[ParamListIdx];
+            if (!ParamListItem.IsObject())
+            {
+                LOG(ERROR) << "DecodeStageBudgetParam() Parse " << apiName
+                           << ", Param List index = " << ParamListIdx << ", not object.";
+                return StageBudgetConfig::Error::DecodeStageBudgetParamError;
+            }
+
+            // 获取实验ID
+            if (!ParamListItem.HasMember("exp_id") || !ParamListItem["exp_id"].IsInt())
+            {
+                LOG(ERROR) << "DecodeStageBudgetParam() Parse " << apiName
+                           << ", Param List index = " << ParamListIdx
+                           << ", not find exp_id.";
+                return StageBudgetConfig::Error::DecodeStageBudgetParamError;
+            }
+            int exp_id = ParamListItem["exp_id"].GetInt();
+
+            auto &param = data.m_StageBudgetParam[apiType][exp_id];
+            param.recall_ms = lambda_get_int(ParamListItem, "RecallMs");
+            param.feature_ms = lambda_get_int(ParamListItem, "FeatureMs");
+            param.filter_ms = lambda_get_int(ParamListItem, "FilterMs");
+            param.rank_ms = lambda_get_int(ParamListItem, "RankMs");
+            param.rank_degrade_num = lambda_get_int(ParamListItem, "RankDegradeNum");
+        }
+    }
+    return StageBudgetConfig::Error::OK;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include "rapidjson/document.h"
+#include "Common/Singleton.h"
+
+#include "Define.h"
+#include "APIType.h"
+
+// 各阶段时间预算(毫秒), 0 表示不限制
+struct StageBudgetParam
+{
+    int recall_ms = 0;  // 召回, 超出后跳过剩余召回渠道
+    int feature_ms = 0; // 物料特征
+    int filter_ms = 0;  // 过滤与粗排
+    int rank_ms = 0;    // 排序, 前序与排序累计超出时跳过打散
+
+    // 前序阶段累计超出预算时, 只对召回融合顺序前 N 个物料排序, 0 表示不截断
+    int rank_degrade_num = 0;
+
+    // 召回至过滤的累计预算, 任一阶段不限制时累计也不限制, 返回 0
+    inline int BeforeRankMs() const noexcept
+    {
+        return (recall_ms > 0 && feature_ms > 0 && filter_ms > 0) ? recall_ms + feature_ms + filter_ms : 0;
+    }
+
+    // 召回至排序的累计预算, 任一阶段不限制时返回 0
+    inline int BeforeDisplayMs() const noexcept
+    {
+        int before_rank_ms = BeforeRankMs();
+        return (before_rank_ms > 0 && rank_ms > 0) ? before_rank_ms + rank_ms : 0;
+    }
+};
+
+struct StageBudgetConfigData
+{
+    std::unordered_map<int, std::unordered_map<int, StageBudgetParam>> m_StageBudgetParam;
+};
+
+class StageBudgetConfig : public Singleton<StageBudgetConfig>
+{
+public:
+    typedef enum class StageBudgetConfigErrorCode
+    {
+        OK = 0,
+        JsonDataEmpty = 1,
+        ParseError,
+        DecodeStageBudgetParamError, // 解析阶段预算配置出错
+    } Error;
+
+public:
+    bool UpdateJson(const std::string &jsonData);
+
+    // 当前配置, 请求开始时经 ConfigSnapshot 取一次, 之后只读
+    inline std::shared_ptr<const StageBudgetConfigData> GetConfigData() const { return std::atomic_load(&m_spData); }
+
+    StageBudgetConfig(token) : m_spData(std::make_shared<StageBudgetConfigData>()) {}
+    ~StageBudgetConfig() {}
+    StageBudgetConfig(StageBudgetConfig &) = delete;
+    StageBudgetConfig &operator=(const StageBudgetConfig &) = delete;
+
+protected:
+    StageBudgetConfig::Error DecodeJsonData(const std::string &jsonData);
+
+    StageBudgetConfig::Error DecodeStageBudgetParam(rapidjson::Document &doc, StageBudgetConfigData &data);
+
+private:
+    std::shared_ptr<const StageBudgetConfigData> m_spData; // 当前配置, 通过 std::atomic_load/atomic_store 读写
+
+    std::mutex m_update_lock; // 更新锁
+};
@@ -0,0 +1,570 @@
+#include "StatisAggregator.h"
+#include <chrono>
+#include <limits>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include "glog/logging.h"
+#include "Monitor/Monitor.h"
+
+// 窗口结束后延迟关闭的时间(秒), 等待跨越窗口边界的请求写完分片
+static const long s_CloseDelaySec = 1;
+
+static long GetNowSec()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void StatisAggregator::StatisValue::Merge(const StatisValue &other)
+{
+    request_num += other.request_num;
+    for (const auto &topN_num : other.topNTypeNum)
+    {
+        auto &typeNum = topNTypeNum[topN_num.first];
+        for (int type_id = 0; type_id < Common::RT_ID::RTI_Limit; type_id++)
+        {
+            typeNum[type_id] += topN_num.second[type_id];
+        }
+    }
+
+    for (int type_id = 0; type_id < Common::RT_ID::RTI_Limit; type_id++)
+    {
+        spareTypeNum[type_id] += other.spareTypeNum[type_id];
+        exclusiveTypeNum[type_id] += other.exclusiveTypeNum[type_id];
+    }
+
+    for (const auto &item_num : other.diversityItemNum)
+    {
+        diversityItemNum[item_num.first] += item_num.second;
+    }
+    diversity_total += other.diversity_total;
+}
+
+bool StatisAggregator::Init(int window_sec, int diversity_pos, int diversity_top_item, bool legacy_log)
+{
+    if (window_sec <= 0 || diversity_pos < 0 || diversity_top_item <= 0)
+    {
+        LOG(ERROR) << "StatisAggregator::Init() params error"
+                   << ", window_sec = " << window_sec
+                   << ", diversity_pos = " << diversity_pos
+                   << ", diversity_top_item = " << diversity_top_item;
+        return false;
+    }
+
+    m_WindowSec = window_sec;
+    m_DiversityPos = diversity_pos;
+    m_DiversityTopItem = diversity_top_item;
+    m_LegacyLog = legacy_log;
+    g_Init = true;
+    g_WorkThreadPtr = std::make_shared<std::thread>(std::bind(&StatisAggregator::OnTimer, this));
+
+    LOG(INFO) << "StatisAggregator::Init() succ"
+              << ", window_sec = " << window_sec
+              << ", diversity_pos = " << diversity_pos
+              << ", diversity_top_item = " << diversity_top_item
+              << ", legacy_log = " << legacy_log;
+    return true;
+}
+
+void StatisAggregator::Record(
+    const RequestData &requestData,
+    const ResponseData &responseData,
+    const std::string &describe,
+    const std::vector<int> &topNList,
+    bool spareSwitch,
+    bool exclusiveSwitch)
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    long window = GetNowSec() / m_WindowSec * m_WindowSec;
+
+    auto &shard = GetShard();
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    if (shard.window != window)
+    {
+        if (!shard.data.empty())
+        {
+            HandOff(shard.window, shard.data);
+            shard.data.clear();
+        }
+        shard.window = window;
+    }
+
+    StatisKey key;
+    key.api = static_cast<int>(requestData.apiType);
+    key.recall_exp = requestData.recallExpID;
+    key.filter_exp = requestData.filterExpID;
+    key.display_exp = requestData.displayExpID;
+    key.stage = describe;
+
+    auto &value = shard.data[key];
+    value.request_num++;
+
+    // 各截断位置的召回类型分布
+    const auto &items_list = responseData.items_list;
+    const int item_size = items_list.size();
+    bool has_top_n = false;
+    for (const int top_n : topNList)
+    {
+        auto &typeNum = value.topNTypeNum[top_n];
+        int use_item_size = top_n > 0 ? std::min(top_n, item_size) : item_size;
+        for (int idx = 0; idx < use_item_size; idx++)
+        {
+            int type_id = items_list[idx].recall_type_id;
+            if (type_id >= 0 && type_id < Common::RT_ID::RTI_Limit)
+            {
+                typeNum[type_id]++;
+            }
+        }
+        has_top_n = has_top_n || top_n > 0;
+    }
+
+    if (spareSwitch)
+    {
+        for (const auto &item_info : responseData.spare_items_list)
+        {
+            int type_id = item_info.recall_type_id;
+            if (type_id >= 0 && type_id < Common::RT_ID::RTI_Limit)
+            {
+                value.spareTypeNum[type_id]++;
+            }
+        }
+    }
+
+    if (exclusiveSwitch)
+    {
+        for (const auto &type_items : responseData.exclusive_items_list)
+        {
+            value.exclusiveTypeNum[Common::GetRecallTypeID(type_items.first)] += type_items.second.size();
+        }
+    }
+
+    // 排序后的阶段统计头部推荐位多样性
+    if (has_top_n)
+    {
+        int use_item_size = std::min(m_DiversityPos, item_size);
+        for (int idx = 0; idx < use_item_size; idx++)
+        {
+            const auto &item_info = items_list[idx];
+            uint64_t item_key = (static_cast<uint64_t>(item_info.item_id) << 16) |
+                                static_cast<uint16_t>(item_info.res_type);
+            value.diversityItemNum[item_key]++;
+        }
+        value.diversity_total += use_item_size;
+    }
+}
+
+void StatisAggregator::ShutDown()
+{
+    if (g_Init)
+    {
+        g_Init = false;
+        if (g_WorkThreadPtr->joinable())
+        {
+            g_WorkThreadPtr->join();
+            LOG(INFO) << "StatisAggregator::ShutDown() g_WorkThreadPtr.join() finish.";
+        }
+
+        Flush(std::numeric_limits<long>::max());
+    }
+}
+
+StatisAggregator::StatisShard &StatisAggregator::GetShard()
+{
+    static thread_local std::shared_ptr<StatisShard> t_spShard;
+    if (t_spShard == nullptr)
+    {
+        t_spShard = std::make_shared<StatisShard>();
+        std::lock_guard<std::mutex> lg(m_ShardMutex);
+        m_vecShard.push_back(t_spShard);
+    }
+    return *t_spShard;
+}
+
+void StatisAggregator::HandOff(long window, StatisData &shardData)
+{
+    std::lock_guard<std::mutex> lg(m_Mutex);
+
+    auto &pendingData = m_PendingData[window];
+    for (auto &key_value : shardData)
+    {
+        auto iter = pendingData.find(key_value.first);
+        if (iter == pendingData.end())
+        {
+            pendingData.emplace(key_value.first, std::move(key_value.second));
+        }
+        else
+        {
+            iter->second.Merge(key_value.second);
+        }
+    }
+}
+
+void StatisAggregator::Flush(long close_window)
+{
+    // 收集各线程分片中早于 close_window 的数据, 已退出线程的分片取空后移除
+    {
+        std::lock_guard<std::mutex> lg(m_ShardMutex);
+        for (auto iter = m_vecShard.begin(); iter != m_vecShard.end();)
+        {
+            auto &shard = **iter;
+            bool empty = true;
+            {
+                std::lock_guard<std::mutex> shard_lg(shard.mtx);
+                if (!shard.data.empty() && shard.window < close_window)
+                {
+                    HandOff(shard.window, shard.data);
+                    shard.data.clear();
+                }
+                empty = shard.data.empty();
+            }
+
+            if (empty && iter->use_count() == 1)
+            {
+                iter = m_vecShard.erase(iter);
+            }
+            else
+            {
+                iter++;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lg(m_Mutex);
+    while (!m_PendingData.empty() && m_PendingData.begin()->first < close_window)
+    {
+        auto spSummary = std::make_shared<StatisSummary>();
+        spSummary->window_start_sec = m_PendingData.begin()->first;
+        spSummary->data = std::move(m_PendingData.begin()->second);
+        m_PendingData.erase(m_PendingData.begin());
+
+        LogSummary(*spSummary);
+
+        // 补充摘要只输出日志, 不覆盖更新的窗口
+        auto spLatest = std::atomic_load(&m_spLatest);
+        if (spLatest == nullptr || spLatest->window_start_sec < spSummary->window_start_sec)
+        {
+            std::atomic_store(&m_spLatest, std::shared_ptr<const StatisSummary>(spSummary));
+        }
+    }
+}
+
+void StatisAggregator::OnTimer()
+{
+    static const long sleep_ms = 100; // 每次睡 100 (ms)
+
+    long last_close_window = 0;
+    while (g_Init)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+        if (!g_Init)
+        {
+            break;
+        }
+
+        // 窗口结束 s_CloseDelaySec 秒后关闭, 每个窗口收集一次
+        long close_window = (GetNowSec() - s_CloseDelaySec) / m_WindowSec * m_WindowSec;
+        if (close_window == last_close_window)
+        {
+            continue;
+        }
+        last_close_window = close_window;
+
+        Flush(close_window);
+    }
+}
+
+std::shared_ptr<const StatisAggregator::StatisSummary> StatisAggregator::GetLatestSummary() const
+{
+    return std::atomic_load(&m_spLatest);
+}
+
+// 头部物料占比与去重率
+static void DiversityInfo(const StatisAggregator::StatisValue &value, int top_item, double &distinct_ratio, double &top_share)
+{
+    distinct_ratio = 0.0;
+    top_share = 0.0;
+    if (value.diversity_total <= 0)
+    {
+        return;
+    }
+
+    std::vector<long> vecItemNum;
+    vecItemNum.reserve(value.diversityItemNum.size());
+    for (const auto &item_num : value.diversityItemNum)
+    {
+        vecItemNum.push_back(item_num.second);
+    }
+
+    std::size_t use_top = std::min(vecItemNum.size(), static_cast<std::size_t>(top_item));
+    std::partial_sort(vecItemNum.begin(), vecItemNum.begin() + use_top, vecItemNum.end(), std::greater<long>());
+
+    long top_num = 0;
+    for (std::size_t idx = 0; idx < use_top; idx++)
+    {
+        top_num += vecItemNum[idx];
+    }
+
+    distinct_ratio = static_cast<double>(vecItemNum.size()) / value.diversity_total;
+    top_share = static_cast<double>(top_num) / value.diversity_total;
+}
+
+double StatisAggregator::FilterDropRate(const StatisData &data, const StatisKey &filterKey, int type_id)
+{
+    StatisKey mergeKey = filterKey;
+    mergeKey.stage = "After Merge";
+    auto iterMerge = data.find(mergeKey);
+    auto iterFilter = data.find(filterKey);
+    if (iterMerge == data.end() || iterFilter == data.end())
+    {
+        return 0.0;
+    }
+
+    auto iterMergeAll = iterMerge->second.topNTypeNum.find(0);
+    auto iterFilterAll = iterFilter->second.topNTypeNum.find(0);
+    if (iterMergeAll == iterMerge->second.topNTypeNum.end() ||
+        iterFilterAll == iterFilter->second.topNTypeNum.end() ||
+        iterMergeAll->second[type_id] <= 0)
+    {
+        return 0.0;
+    }
+
+    double keep = static_cast<double>(iterFilterAll->second[type_id]) / iterMergeAll->second[type_id];
+    return std::max(0.0, 1.0 - keep);
+}
+
+void StatisAggregator::LogSummary(const StatisSummary &summary) const
+{
+    // 输出格式: {召回类型:占比,...}
+    auto lambda_type_share = [](const TypeCount &typeNum) -> std::string
+    {
+        long total = 0;
+        for (long num : typeNum)
+        {
+            total += num;
+        }
+
+        std::stringstream share_info;
+        share_info << "{";
+        for (int type_id = 0; type_id < Common::RT_ID::RTI_Limit && total > 0; type_id++)
+        {
+            if (typeNum[type_id] > 0)
+            {
+                if (share_info.tellp() > 1)
+                {
+                    share_info << ",";
+                }
+                share_info << Common::GetRecallTypeName(type_id) << ":" << static_cast<double>(typeNum[type_id]) / total;
+            }
+        }
+        share_info << "}";
+        return share_info.str();
+    };
+
+    for (const auto &key_value : summary.data)
+    {
+        const auto &key = key_value.first;
+        const auto &value = key_value.second;
+
+        std::stringstream topN_info;
+        for (const auto &topN_num : value.topNTypeNum)
+        {
+            topN_info << ", " << (topN_num.first > 0 ? "top" + std::to_string(topN_num.first) : "all")
+                      << " = " << lambda_type_share(topN_num.second);
+        }
+
+        // 过滤阶段输出各召回类型丢弃率
+        std::stringstream drop_info;
+        if (key.stage == "After Filter")
+        {
+            drop_info << ", filter_drop = {";
+            bool first = true;
+            for (int type_id = 0; type_id < Common::RT_ID::RTI_Limit; type_id++)
+            {
+                double drop_rate = FilterDropRate(summary.data, key, type_id);
+                if (drop_rate > 0)
+                {
+                    drop_info << (first ? "" : ",") << Common::GetRecallTypeName(type_id) << ":" << drop_rate;
+                    first = false;
+                }
+            }
+            drop_info << "}";
+        }
+
+        double distinct_ratio = 0.0, top_share = 0.0;
+        DiversityInfo(value, m_DiversityTopItem, distinct_ratio, top_share);
+
+        LOG(INFO) << "StatisAggregator Window Summary: " << key.stage
+                  << ", window_start = " << summary.window_start_sec
+                  << ", apiType = " << key.api
+                  << ", recallExpID = " << key.recall_exp
+                  << ", filterExpID = " << key.filter_exp
+                  << ", displayExpID = " << key.display_exp
+                  << ", request = " << value.request_num
+                  << topN_info.str()
+                  << ", spare = " << lambda_type_share(value.spareTypeNum)
+                  << ", exclusive = " << lambda_type_share(value.exclusiveTypeNum)
+                  << drop_info.str()
+                  << ", diversity_distinct = " << distinct_ratio
+                  << ", diversity_top" << m_DiversityTopItem << "_share = " << top_share;
+    }
+}
+
+void StatisAggregator::RegisterMonitor()
+{
+    auto monitor = Monitor::GetInstance();
+    const auto gauge = Monitor::PullType::Gauge;
+
+    auto lambda_labels = [](const StatisKey &key) -> std::map<std::string, std::string>
+    {
+        return {{"api", std::to_string(key.api)},
+                {"stage", key.stage},
+                {"recall_exp", std::to_string(key.recall_exp)},
+                {"filter_exp", std::to_string(key.filter_exp)},
+                {"display_exp", std::to_string(key.display_exp)}};
+    };
+
+    monitor->RegisterStatisFamily(
+        "algocenter_statis_window_start_seconds", "Start time of the latest closed statis window", gauge,
+        [this]()
+        {
+            auto spSummary = GetLatestSummary();
+            std::vector<Monitor::PullSample> vecSample;
+            if (spSummary != nullptr)
+            {
+                vecSample.push_back({{}, (double)spSummary->window_start_sec});
+            }
+            return vecSample;
+        });
+
+    monitor->RegisterStatisFamily(
+        "algocenter_statis_request", "Requests per stage in the latest window", gauge,
+        [this, lambda_labels]()
+        {
+            std::vector<Monitor::PullSample> vecSample;
+            auto spSummary = GetLatestSummary();
+            if (spSummary == nullptr)
+            {
+                return vecSample;
+            }
+            for (const auto &key_value : spSummary->data)
+            {
+                vecSample.push_back({lambda_labels(key_value.first), (double)key_value.second.request_num});
+            }
+            return vecSample;
+        });
+
+    monitor->RegisterStatisFamily(
+        "algocenter_statis_recall_share", "Recall type share at top-N positions in the latest window", gauge,
+        [this, lambda_labels]()
+        {
+            std::vector<Monitor::PullSample> vecSample;
+            auto spSummary = GetLatestSummary();
+            if (spSummary == nullptr)
+            {
+                return vecSample;
+            }
+            for (const auto &key_value : spSummary->data)
+            {
+                for (const auto &topN_num : key_value.second.topNTypeNum)
+                {
+                    long total = 0;
+                    for (long num : topN_num.second)
+                    {
+                        total += num;
+                    }
+
+                    for (int type_id = 0; type_id < Common::RT_ID::RTI_Limit && total > 0; type_id++)
+                    {
+                        if (topN_num.second[type_id] <= 0)
+                        {
+                            continue;
+                        }
+                        auto labels = lambda_labels(key_value.first);
+                        labels["top"] = std::to_string(topN_num.first);
+                        labels["recall_type"] = Common::GetRecallTypeName(type_id);
+                        vecSample.push_back({std::move(labels), (double)topN_num.second[type_id] / total});
+                    }
+                }
+            }
+            return vecSample;
+        });
+
+    monitor->RegisterStatisFamily(
+        "algocenter_statis_filter_drop_rate", "Recall type drop rate from After Merge to After Filter", gauge,
+        [this, lambda_labels]()
+        {
+            std::vector<Monitor::PullSample> vecSample;
+            auto spSummary = GetLatestSummary();
+            if (spSummary == nullptr)
+            {
+                return vecSample;
+            }
+            for (const auto &key_value : spSummary->data)
+            {
+                if (key_value.first.stage != "After Filter")
+                {
+                    continue;
+                }
+
+                StatisKey mergeKey = key_value.first;
+                mergeKey.stage = "After Merge";
+                auto iterMerge = spSummary->data.find(mergeKey);
+                if (iterMerge == spSummary->data.end())
+                {
+                    continue;
+                }
+                auto iterMergeAll = iterMerge->second.topNTypeNum.find(0);
+                if (iterMergeAll == iterMerge->second.topNTypeNum.end())
+                {
+                    continue;
+                }
+
+                for (int type_id = 0; type_id < Common::RT_ID::RTI_Limit; type_id++)
+                {
+                    if (iterMergeAll->second[type_id] <= 0)
+                    {
+                        continue;
+                    }
+                    auto labels = lambda_labels(key_value.first);
+                    labels["recall_type"] = Common::GetRecallTypeName(type_id);
+                    vecSample.push_back({std::move(labels), FilterDropRate(spSummary->data, key_value.first, type_id)});
+                }
+            }
+            return vecSample;
+        });
+
+    monitor->RegisterStatisFamily(
+        "algocenter_statis_diversity", "Distinct ratio and top item share of top positions in the latest window", gauge,
+        [this, lambda_labels]()
+        {
+            std::vector<Monitor::PullSample> vecSample;
+            auto spSummary = GetLatestSummary();
+            if (spSummary == nullptr)
+            {
+                return vecSample;
+            }
+            for (const auto &key_value : spSummary->data)
+            {
+                if (key_value.second.diversity_total <= 0)
+                {
+                    continue;
+                }
+
+                double distinct_ratio = 0.0, top_share = 0.0;
+                DiversityInfo(key_value.second, m_DiversityTopItem, distinct_ratio, top_share);
+
+                auto labels = lambda_labels(key_value.first);
+                labels["metric"] = "distinct_ratio";
+                vecSample.push_back({labels, distinct_ratio});
+                labels["metric"] = "top_item_share";
+                vecSample.push_back({std::move(labels), top_share});
+            }
+            return vecSample;
+        });
+}
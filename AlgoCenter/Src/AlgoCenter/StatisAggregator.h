@@ -0,0 +1,159 @@
+#pragma once
+#include <map>
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+#include "Common/Singleton.h"
+#include "Recall/RecallType.hpp"
+#include "RequestData.h"
+#include "ResponseData.h"
+
+// 统计聚合, 替代 StatisLogData 逐请求输出物料列表
+// 1. 请求线程只更新线程局部分片, 分片锁只与定时线程竞争
+// 2. 线程进入新窗口时将旧分片交给全局合并; 定时线程在窗口结束后收集全部分片, 空闲线程的数据同样计入
+// 3. 窗口关闭后输出一条摘要日志, 并通过监控端口 /statis 查询最近一个窗口
+//    召回类型占比、过滤丢弃率与推荐多样性
+// 4. 窗口关闭后才交付的数据(请求跨越窗口边界)单独输出一条补充摘要, 不丢弃
+class StatisAggregator : public Singleton<StatisAggregator>
+{
+public:
+    using TypeCount = std::array<long, Common::RT_ID::RTI_Limit>;
+
+    // 聚合维度: 接口、阶段与各层实验
+    struct StatisKey
+    {
+        int api = 0;
+        int recall_exp = 0;
+        int filter_exp = 0;
+        int display_exp = 0;
+        std::string stage;
+
+        bool operator==(const StatisKey &other) const noexcept
+        {
+            return api == other.api && recall_exp == other.recall_exp &&
+                   filter_exp == other.filter_exp && display_exp == other.display_exp &&
+                   stage == other.stage;
+        }
+    };
+
+    struct StatisKeyHash
+    {
+        std::size_t operator()(const StatisKey &key) const noexcept
+        {
+            std::size_t seed = std::hash<std::string>()(key.stage);
+            for (int value : {key.api, key.recall_exp, key.filter_exp, key.display_exp})
+            {
+                seed ^= std::hash<int>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            }
+            return seed;
+        }
+    };
+
+    // 聚合值
+    struct StatisValue
+    {
+        long request_num = 0;
+        std::map<int, TypeCount> topNTypeNum; // 截断位置 -> 召回类型 -> 物料数, 0 表示全部
+        TypeCount spareTypeNum = {};          // 备用召回
+        TypeCount exclusiveTypeNum = {};      // 独立召回
+
+        // 多样性: 前 N 位物料出现次数
+        std::unordered_map<uint64_t, long> diversityItemNum;
+        long diversity_total = 0;
+
+        void Merge(const StatisValue &other);
+    };
+
+    using StatisData = std::unordered_map<StatisKey, StatisValue, StatisKeyHash>;
+
+    // 窗口摘要
+    struct StatisSummary
+    {
+        long window_start_sec = 0;
+        StatisData data;
+    };
+
+public:
+    // 初始化
+    // [in] window_sec 聚合窗口(秒)
+    // [in] diversity_pos 多样性统计的推荐位数
+    // [in] diversity_top_item 多样性集中度的头部物料数
+    // [in] legacy_log 是否同时保留逐请求统计日志
+    bool Init(int window_sec, int diversity_pos, int diversity_top_item, bool legacy_log);
+
+    // 停止定时线程, 输出全部未关闭窗口
+    void ShutDown();
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    inline bool IsLegacyLog() const noexcept { return m_LegacyLog; }
+
+    // 记录一次请求在某阶段的物料分布
+    void Record(
+        const RequestData &requestData,
+        const ResponseData &responseData,
+        const std::string &describe,
+        const std::vector<int> &topNList,
+        bool spareSwitch,
+        bool exclusiveSwitch);
+
+    // 最近一个已关闭窗口
+    std::shared_ptr<const StatisSummary> GetLatestSummary() const;
+
+    // 注册 /statis 查询指标
+    void RegisterMonitor();
+
+private:
+    // 线程局部分片, 注册到全局列表供定时线程收集
+    struct StatisShard
+    {
+        std::mutex mtx;
+        long window = -1;
+        StatisData data;
+    };
+
+    StatisShard &GetShard();
+
+    // 分片数据交给全局合并, 调用方持有分片锁
+    void HandOff(long window, StatisData &shardData);
+
+    // 收集早于 close_window 的分片数据, 并关闭这些窗口
+    void Flush(long close_window);
+
+    // 定时关闭窗口
+    void OnTimer();
+
+    // 输出窗口摘要日志
+    void LogSummary(const StatisSummary &summary) const;
+
+    // 召回类型: 阶段 After Filter 相对 After Merge 的丢弃率
+    static double FilterDropRate(const StatisData &data, const StatisKey &filterKey, int type_id);
+
+private:
+    std::atomic<bool> g_Init = false;
+    long m_WindowSec = 60;
+    int m_DiversityPos = 10;
+    int m_DiversityTopItem = 10;
+    bool m_LegacyLog = false;
+
+    std::mutex m_ShardMutex;
+    std::vector<std::shared_ptr<StatisShard>> m_vecShard; // 线程退出后由定时线程收集剩余数据并移除
+
+    mutable std::mutex m_Mutex;
+    std::map<long, StatisData> m_PendingData; // 窗口起始 -> 已交付的数据
+    std::shared_ptr<const StatisSummary> m_spLatest;
+
+    std::shared_ptr<std::thread> g_WorkThreadPtr;
+
+public:
+    StatisAggregator(token) {}
+    ~StatisAggregator() { ShutDown(); }
+    StatisAggregator(StatisAggregator &) = delete;
+    StatisAggregator &operator=(const StatisAggregator &) = delete;
+};
@@ -3,10 +3,13 @@
 
 #include "RequestData.h"
 #include "ResponseData.h"
+#include "Recall/RecallType.hpp"
+#include "StatisAggregator.h"
 
 class StatisLogData
 {
 public:
+    // 开启聚合时只更新聚合计数, 逐请求日志需打开 LegacyLog
     static void OutStatisLog(
         const RequestData &requestData,
         const ResponseData &responseData,
@@ -15,6 +18,16 @@ public:
         bool spareSwitch = false,
         bool exclusiveSwitch = false)
     {
+        auto aggregator = StatisAggregator::GetInstance();
+        if (aggregator->IsInit())
+        {
+            aggregator->Record(requestData, responseData, describe, topNList, spareSwitch, exclusiveSwitch);
+            if (!aggregator->IsLegacyLog())
+            {
+                return;
+            }
+        }
+
         if (!requestData.is_statis_log)
         {
             return;
@@ -55,33 +68,33 @@ public:
 
         for (const int top_n : topNList)
         {
-            std::unordered_map<std::string, std::vector<ItemInfo>> statisMergeItems;
+            std::unordered_map<int, std::vector<ItemInfo>> statisMergeItems;
 
             int item_size = responseData.items_list.size();
             int use_item_size = top_n > 0 ? std::min(top_n, item_size) : item_size;
             for (int idx = 0; idx < use_item_size; idx++)
             {
                 const auto &item_info = responseData.items_list[idx];
-                statisMergeItems[item_info.recall_type].emplace_back(item_info);
+                statisMergeItems[item_info.recall_type_id].emplace_back(item_info);
             }
 
             for (auto iter = statisMergeItems.begin(); iter != statisMergeItems.end(); iter++)
             {
-                lambda_statis_log(top_n, iter->first, iter->second);
+                lambda_statis_log(top_n, Common::GetRecallTypeName(iter->first), iter->second);
             }
         }
 
         if (spareSwitch)
         {
-            std::unordered_map<std::string, std::vector<ItemInfo>> spareStatisMergeItems;
+            std::unordered_map<int, std::vector<ItemInfo>> spareStatisMergeItems;
             for (const auto &item_info : responseData.spare_items_list)
             {
-                spareStatisMergeItems[item_info.recall_type].emplace_back(item_info);
+                spareStatisMergeItems[item_info.recall_type_id].emplace_back(item_info);
             }
 
             for (auto iter = spareStatisMergeItems.begin(); iter != spareStatisMergeItems.end(); iter++)
             {
-                lambda_statis_log(0, iter->first, iter->second);
+                lambda_statis_log(0, Common::GetRecallTypeName(iter->first), iter->second);
             }
         }
 
@@ -3,24 +3,18 @@
 #include "glog/logging.h"
 
 #include "ScattersStrategy.h"
+#include "Trace/Tracer.h"
 
 static std::unordered_map<std::string, std::shared_ptr<Display_Interface>> TypeToStrategyList = {
     {Common::DisplayType_Scatter, ScattersStrategy::GetInstance()},
 };
 
-const DisplayParamData *Display::GetDisplayParamData(
-    const RequestData &requestData,
-    ResponseData &responseData)
-{
-    return DisplayConfig::GetInstance()->GetDisplayParamData(
-        requestData.userGroupList, requestData.apiType, requestData.displayExpID);
-}
-
 int Display::CallDisplay(
     const DisplayParamData *pDisplayParamData,
     const RequestData &requestData,
     ResponseData &responseData)
 {
+    TraceSpan displaySpan("CallDisplay");
 
     // 遍历展控参数列表, 调用展控策略
     for (const auto &scParams : pDisplayParamData->vecDisplayParams)
@@ -34,6 +28,12 @@ int Display::CallDisplay(
             return Common::Error::Display_Error;
         }
 
+        // 前序阶段超出预算, 跳过打散
+        if (scType == Common::DisplayType_Scatter && (responseData.degrade_flags & Degrade_ScatterSkip))
+        {
+            continue;
+        }
+
         auto strategyInst = GetDisplayStrategyInst(scType);
         if (strategyInst == nullptr || strategyInst.get() == nullptr)
         {
@@ -45,7 +45,9 @@ int Display::CallDisplay(
         }
 
         // 调用策略
+        TraceSpan strategySpan("DisplayStrategy", scType);
         int err = strategyInst->CallStrategy(requestData, scParams, responseData);
+        strategySpan.End();
         if (Common::Error::OK != err)
         {
             LOG(WARNING) << "Display::CallDisplay(), Call Strategy Failed"
@@ -14,10 +14,6 @@ class Display_Interface;
 class Display : public Singleton<Display>
 {
 public:
-    const DisplayParamData *GetDisplayParamData(
-        const RequestData &requestData,
-        ResponseData &responseData);
-
     int CallDisplay(
         const DisplayParamData *pDisplayParamData,
         const RequestData &requestData,
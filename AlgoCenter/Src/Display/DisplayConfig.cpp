@@ -17,64 +17,6 @@ bool DisplayConfig::UpdateJson(const std::string &jsonData)
     return DecodeJsonData(jsonData) == DisplayConfig::Error::OK;
 }
 
-const int DisplayConfig::MatchDisplayExpID(
-    Common::APIType apiType,
-    const std::vector<int> &vecExpIDList) const
-{
-    int dataIdx = m_dataIdx;
-    int type = static_cast<int>(apiType);
-    auto itType = m_data[dataIdx].m_DisplayParamData.find(type);
-    if (itType != m_data[dataIdx].m_DisplayParamData.end())
-    {
-        for (auto exp_id : vecExpIDList)
-        {
-            if (exp_id != 0)
-            {
-                auto itExp = itType->second.find(exp_id);
-                if (itExp != itType->second.end())
-                {
-                    return exp_id;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-const DisplayParamData *DisplayConfig::GetDisplayParamData(
-    const std::unordered_set<std::string> &userGroupList, Common::APIType apiType, int exp_id) const
-{
-    int dataIdx = m_dataIdx;
-    int type = static_cast<int>(apiType);
-
-    const DisplayParamData *pDisplayParamData = nullptr;
-    auto itType = m_data[dataIdx].m_DisplayParamData.find(type);
-    if (itType != m_data[dataIdx].m_DisplayParamData.end())
-    {
-        auto itExp = itType->second.find(exp_id);
-        if (itExp == itType->second.end())
-        {
-            // 如果没有这个exp_id, 则使用默认exp_id -> 0
-            itExp = itType->second.find(0);
-        }
-        if (itExp != itType->second.end())
-        {
-            for (const auto &itemGroup : itExp->second)
-            {
-                // 默认组用户配置优先级最低，必须放列表最后
-                // 先匹配其他用户组配置，命中其他用户组配置或者遇到最后的默认用户组配置，即完成匹配并退出循环
-                if (userGroupList.find(itemGroup.user_group) != userGroupList.end() ||
-                    itemGroup.user_group == Common::DefaultUserGroup)
-                {
-                    pDisplayParamData = &itemGroup;
-                    break;
-                }
-            }
-        }
-    }
-    return pDisplayParamData;
-}
-
 DisplayConfig::Error DisplayConfig::DecodeJsonData(const std::string &jsonData)
 {
     rapidjson::Document doc;
@@ -84,23 +26,23 @@ DisplayConfig::Error DisplayConfig::DecodeJsonData(const std::string &jsonData)
         return DisplayConfig::Error::ParseError;
     }
 
-    // 缓存下标
-    int idx = (m_dataIdx + 1) % 2;
+    // 在新对象上解析, 完成后整体替换, 已持有旧数据的请求不受影响
+    auto spData = std::make_shared<DisplayConfigData>();
 
     // 解析展控层配置
-    auto cfgErr = DecodeDisplayParamData(doc, idx);
+    auto cfgErr = DecodeDisplayParamData(doc, *spData);
     if (cfgErr != DisplayConfig::Error::OK)
     {
         return cfgErr;
     }
 
-    m_dataIdx = idx;
+    std::atomic_store(&m_spData, std::shared_ptr<const DisplayConfigData>(std::move(spData)));
 
     return DisplayConfig::Error::OK;
 }
 
 // 展控层配置
-DisplayConfig::Error DisplayConfig::DecodeDisplayParamData(rapidjson::Document &doc, int dataIdx)
+DisplayConfig::Error DisplayConfig::DecodeDisplayParamData(rapidjson::Document &doc, DisplayConfigData &data)
 {
     if (!doc.HasMember("Display") || !doc["Display"].IsObject())
     {
@@ -157,7 +99,7 @@ DisplayConfig::Error DisplayConfig::DecodeDisplayParamData(rapidjson::Document &
             rapidjson::SizeType UserGroupListSize = userGroupList.Size();
 
             bool def_group_user_conf = false;
-            auto &configItemList = m_data[dataIdx].m_DisplayParamData[apiType][exp_id];
+            auto &configItemList = data.m_DisplayParamData[apiType][exp_id];
             configItemList.resize(UserGroupListSize);
             for (rapidjson::SizeType UserGroupListIdx = 0; UserGroupListIdx < UserGroupListSize; ++UserGroupListIdx)
             {
@@ -174,10 +174,10 @@ public:
 public:
     bool UpdateJson(const std::string &jsonData);
 
-    const int MatchDisplayExpID(const Common::APIType apiType, const std::vector<int> &vecExpIDList) const;
-    const DisplayParamData *GetDisplayParamData(const std::unordered_set<std::string> &userGroupList, Common::APIType apiType, int exp_id) const;
+    // 当前配置, 请求开始时经 ConfigSnapshot 取一次, 之后只读
+    inline std::shared_ptr<const DisplayConfigData> GetConfigData() const { return std::atomic_load(&m_spData); }
 
-    DisplayConfig(token) { m_dataIdx = 0; }
+    DisplayConfig(token) : m_spData(std::make_shared<DisplayConfigData>()) {}
     ~DisplayConfig() {}
     DisplayConfig(DisplayConfig &) = delete;
     DisplayConfig &operator=(const DisplayConfig &) = delete;
@@ -185,11 +185,10 @@ public:
 protected:
     DisplayConfig::Error DecodeJsonData(const std::string &jsonData);
 
-    DisplayConfig::Error DecodeDisplayParamData(rapidjson::Document &doc, int dataIdx);
+    DisplayConfig::Error DecodeDisplayParamData(rapidjson::Document &doc, DisplayConfigData &data);
 
 private:
-    std::atomic<int> m_dataIdx = 0;
-    DisplayConfigData m_data[2];
+    std::shared_ptr<const DisplayConfigData> m_spData; // 当前配置, 通过 std::atomic_load/atomic_store 读写
 
     std::mutex m_update_lock; // 更新锁
 };
@@ -3,6 +3,7 @@
 #include "glog/logging.h"
 
 #include "Common/Function.h"
+#include "Recall/RecallType.hpp"
 
 #include "rapidjson/document.h"
 #include "rapidjson/writer.h"
@@ -93,7 +94,15 @@ int ScattersStrategy::CallStrategy(
             return Common::Error::Display_GetParamsError;
         }
 
-        control_info.element_set.insert(vec_element.begin(), vec_element.end());
+        // 元素为召回类型名称, 转换为召回类型ID位集合
+        for (const auto &element : vec_element)
+        {
+            int recallTypeId = Common::GetRecallTypeID(element);
+            if (recallTypeId > 0 && recallTypeId < Common::RT_ID::RTI_Limit)
+            {
+                control_info.element_set.set(recallTypeId);
+            }
+        }
 
         // 控制数量
         control_info.control_count = secondary_param.GetControlCount();
@@ -137,7 +146,8 @@ int ScattersStrategy::CallStrategy(
             logWriter.Key("res_type");
             logWriter.Int(item_info.res_type);
             logWriter.Key("recall_type");
-            logWriter.String(item_info.recall_type.c_str(), item_info.recall_type.size());
+            const auto &recall_type = Common::GetRecallTypeName(item_info.recall_type_id);
+            logWriter.String(recall_type.c_str(), recall_type.size());
             logWriter.EndObject();
         }
         logWriter.EndArray();
@@ -195,8 +205,7 @@ int ScattersStrategy::CallStrategy(
             int sum_now_count = 0;
             for (auto &control_info : page_control_info)
             {
-                auto &element = item_info.recall_type;
-                if (control_info.element_set.find(element) != control_info.element_set.end())
+                if (control_info.element_set.test(item_info.recall_type_id))
                 {
                     control_info.now_count += 1;
                 }
@@ -223,8 +232,7 @@ int ScattersStrategy::CallStrategy(
             {
                 for (auto &control_info : page_control_info)
                 {
-                    auto &element = item_info.recall_type;
-                    if (control_info.element_set.find(element) != control_info.element_set.end())
+                    if (control_info.element_set.test(item_info.recall_type_id))
                     {
                         control_info.now_count -= 1;
                     }
@@ -309,7 +317,8 @@ int ScattersStrategy::CallStrategy(
             logWriter.Key("res_type");
             logWriter.Int(item_info.res_type);
             logWriter.Key("recall_type");
-            logWriter.String(item_info.recall_type.c_str(), item_info.recall_type.size());
+            const auto &recall_type = Common::GetRecallTypeName(item_info.recall_type_id);
+            logWriter.String(recall_type.c_str(), recall_type.size());
             logWriter.EndObject();
         }
         logWriter.EndArray();
@@ -1,5 +1,7 @@
 #pragma once
+#include <bitset>
 #include "Common/Singleton.h"
+#include "Recall/RecallType.hpp"
 #include "Display_Interface.h"
 
 // 打散策略
@@ -9,7 +11,7 @@ class ScattersStrategy
 {
     struct ControlInfo
     {
-        std::unordered_set<std::string> element_set;
+        std::bitset<Common::RT_ID::RTI_Limit> element_set; // 召回类型ID
         std::string control_method = "";
         int control_count = 0;
         int now_count = 0;
@@ -1,10 +1,10 @@
 #pragma once
 #include "TDPredict/Interface/ModelInterface.h"
-#include "TFFeature_Interface.h"
+#include "TFFeature_ContextAdapter.h"
 #include "UserFeature.h"
 #include "ItemFeature.h"
 
-class TFFeature : public TFFeature_Interface
+class TFFeature : public TFFeature_ContextAdapter<TFFeature>
 {
 public:
     RegisterFeature(TFFeature);
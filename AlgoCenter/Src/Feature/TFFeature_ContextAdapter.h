@@ -0,0 +1,146 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "TFFeature_Interface.h"
+
+// 列式排序上下文的 RankItem 参数, 值为物料在 RankContext::vecItem 中的下标
+static const std::string RankParam_ContextIdx = "ctx_idx";
+
+// 请求级排序上下文
+struct RankRequestContext
+{
+    long user_id = 0;
+    long context_item_id = 0;
+    int context_res_type = 0;
+
+    InitStructPtr spInitStruct; // 本请求的用户/物料特征
+};
+
+// 物料级排序上下文
+struct RankItemContext
+{
+    long item_id = 0;
+    int res_type = 0;
+};
+
+// 列式排序上下文, 服务内部使用, 不属于 TFFeature_Interface 的约定
+// 业务字段按列存放, RankItem 只携带 ctx_idx, 不再为每个物料写入字符串参数表
+// 只包含一个请求: TDPredict 未约定对每个物料以其所属请求的上下文调用 AddCommonFeature,
+// 公共特征可能只按首个物料拼接一次, 因此不同请求的物料不能放入同一个上下文
+struct RankContext
+{
+    RankRequestContext request;
+    std::vector<RankItemContext> vecItem;
+};
+using RankContextPtr = std::shared_ptr<RankContext>;
+
+// 排序上下文适配层, 位于 TFFeature_Interface 与业务特征类之间, 不改变业务接口
+// 1. 初始化数据为 InitStructPtr 时, 行为与 TFFeature_Interface 完全一致
+// 2. 初始化数据为 RankContextPtr 时, 以请求的 InitStruct 初始化业务特征实例,
+//    再按 ctx_idx 取出列式上下文, 直接调用该实例的 AddCommonFeature / AddRankFeature
+// 用法: class TFFeature : public TFFeature_ContextAdapter<TFFeature>
+template <typename FeatureT>
+class TFFeature_ContextAdapter
+    : public TFFeature_Interface
+{
+public:
+    virtual bool SetInitData(const std::any init_data) noexcept override
+    {
+        spRankContext = nullptr;
+        m_spRequestFeature = nullptr;
+        if (init_data.type() != typeid(RankContextPtr))
+        {
+            return TFFeature_Interface::SetInitData(init_data);
+        }
+
+        auto spContext = std::any_cast<RankContextPtr>(init_data);
+        if (spContext == nullptr)
+        {
+            return false;
+        }
+
+        auto spFeature = std::make_shared<FeatureT>();
+        if (!spFeature->SetInitData(spContext->request.spInitStruct))
+        {
+            return false;
+        }
+        m_spRequestFeature = std::move(spFeature);
+        spRankContext = std::move(spContext);
+        return true;
+    }
+
+    virtual bool AnalyseCommonFeature(TDPredict::RankItem &rank_item) const noexcept override
+    {
+        if (spRankContext == nullptr)
+        {
+            return TFFeature_Interface::AnalyseCommonFeature(rank_item);
+        }
+
+        const RankItemContext *item_context = nullptr;
+        if (!GetItemContext(rank_item, item_context))
+        {
+            return false;
+        }
+
+        const auto &request_context = spRankContext->request;
+        if (request_context.user_id == 0 ||
+            request_context.context_item_id == 0 ||
+            request_context.context_res_type == 0)
+        {
+            return false;
+        }
+
+        return m_spRequestFeature->AddCommonFeature(
+            request_context.user_id,
+            request_context.context_item_id,
+            request_context.context_res_type,
+            rank_item.spFeatureData->common_feature);
+    }
+
+    virtual bool AnalyseRankFeature(TDPredict::RankItem &rank_item) const noexcept override
+    {
+        if (spRankContext == nullptr)
+        {
+            return TFFeature_Interface::AnalyseRankFeature(rank_item);
+        }
+
+        const RankItemContext *item_context = nullptr;
+        if (!GetItemContext(rank_item, item_context))
+        {
+            return false;
+        }
+
+        const auto &request_context = spRankContext->request;
+        if (request_context.user_id == 0 ||
+            item_context->item_id == 0 ||
+            item_context->res_type == 0)
+        {
+            return false;
+        }
+
+        return m_spRequestFeature->AddRankFeature(
+            request_context.user_id,
+            item_context->item_id,
+            item_context->res_type,
+            rank_item.spFeatureData->rank_feature);
+    }
+
+private:
+    bool GetItemContext(const TDPredict::RankItem &rank_item, const RankItemContext *&item_context) const noexcept
+    {
+        long ctx_idx = 0;
+        if (!rank_item.getParam(RankParam_ContextIdx, ctx_idx) ||
+            ctx_idx < 0 || ctx_idx >= (long)spRankContext->vecItem.size())
+        {
+            return false;
+        }
+
+        item_context = &spRankContext->vecItem[ctx_idx];
+        return true;
+    }
+
+private:
+    // 列式上下文及请求的业务特征实例, 初始化数据为 InitStructPtr 时为空
+    RankContextPtr spRankContext = nullptr;
+    std::shared_ptr<FeatureT> m_spRequestFeature = nullptr;
+};
@@ -26,13 +26,15 @@ class UserFeature final
 
 public:
     // 初始化用户特征
-    int32_t InitUserFeature(const long user_id, const long ll_id, const int res_type) noexcept
+    int32_t InitUserFeature(
+        const long user_id, const long ll_id, const int res_type,
+        const std::shared_ptr<google::protobuf::Arena> &spArena = nullptr) noexcept
     {
         // 请求用户数据
         this->user_id = user_id;
         this->context_item_id = ll_id;
         this->context_res_type = res_type;
-        return RedisProtoData::GetUserFeatureProto(this->user_id, gs_vec_type, type2proto);
+        return RedisProtoData::GetUserFeatureProto(this->user_id, gs_vec_type, type2proto, spArena);
     }
 
 public:
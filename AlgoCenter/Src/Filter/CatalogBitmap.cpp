@@ -0,0 +1,294 @@
+#include "CatalogBitmap.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include "glog/logging.h"
+#include "TDRedis/TDRedis.h"
+#include "TDRedis/TDRedisConnPool.h"
+
+#include "Common/Function.h"
+#include "AlgoCenter/RequestData.h"
+#include "AlgoCenter/ResponseData.h"
+
+bool CatalogBitmapData::Decode(const std::string &data)
+{
+    size_t offset = 0;
+    auto lambda_read = [&](void *dst, size_t len) -> bool
+    {
+        if (offset + len > data.size())
+        {
+            return false;
+        }
+        memcpy(dst, data.data() + offset, len);
+        offset += len;
+        return true;
+    };
+
+    char magic[4] = {0};
+    uint32_t res_type_num = 0;
+    if (!lambda_read(magic, sizeof(magic)) || memcmp(magic, "CBM1", 4) != 0 ||
+        !lambda_read(&res_type_num, sizeof(res_type_num)))
+    {
+        LOG(ERROR) << "CatalogBitmapData::Decode() header error, size = " << data.size();
+        return false;
+    }
+
+    for (uint32_t idx = 0; idx < res_type_num; idx++)
+    {
+        int32_t res_type = 0;
+        uint64_t bit_num = 0;
+        if (!lambda_read(&res_type, sizeof(res_type)) || !lambda_read(&bit_num, sizeof(bit_num)))
+        {
+            LOG(ERROR) << "CatalogBitmapData::Decode() res_type header error, idx = " << idx;
+            return false;
+        }
+
+        // 先以剩余字节数限制 bit_num, 避免 word_num 计算溢出回绕
+        if (bit_num > (data.size() - offset) * 8)
+        {
+            LOG(ERROR) << "CatalogBitmapData::Decode() bit_num exceeds data"
+                       << ", res_type = " << res_type
+                       << ", bit_num = " << bit_num;
+            return false;
+        }
+
+        uint64_t word_num = (bit_num + 63) / 64;
+        if (word_num * sizeof(uint64_t) > data.size() - offset)
+        {
+            LOG(ERROR) << "CatalogBitmapData::Decode() bitmap truncated"
+                       << ", res_type = " << res_type
+                       << ", bit_num = " << bit_num;
+            return false;
+        }
+
+        auto &bitmap = mapResTypeBitmap[res_type];
+        bitmap.bit_num = bit_num;
+        bitmap.vecWord.resize(word_num);
+        lambda_read(bitmap.vecWord.data(), word_num * sizeof(uint64_t));
+    }
+
+    return true;
+}
+
+bool CatalogBitmap::Init(
+    const std::string &redis_name,
+    const std::string &redis_key,
+    const std::string &snapshot_path,
+    const int refresh_sec)
+{
+    m_RedisName = redis_name;
+    m_RedisKey = redis_key;
+    m_SnapshotPath = snapshot_path;
+    m_RefreshSec = refresh_sec;
+    if ((m_RedisKey.empty() && m_SnapshotPath.empty()) || m_RefreshSec <= 0)
+    {
+        LOG(ERROR) << "CatalogBitmap::Init() param error"
+                   << ", redis_key = " << redis_key
+                   << ", snapshot_path = " << snapshot_path
+                   << ", refresh_sec = " << refresh_sec;
+        return false;
+    }
+
+    // 加载失败不影响启动, 位图为空时不做剔除
+    if (!Refresh())
+    {
+        LOG(WARNING) << "CatalogBitmap::Init() first Refresh failed, prune disabled until next refresh";
+    }
+
+    g_Init = true;
+    g_WorkThreadPtr = std::make_shared<std::thread>(std::bind(&CatalogBitmap::OnTimer, this));
+
+    LOG(INFO) << "CatalogBitmap::Init() g_WorkThreadPtr start success.";
+    return true;
+}
+
+void CatalogBitmap::ShutDown()
+{
+    if (g_Init)
+    {
+        g_Init = false;
+        if (g_WorkThreadPtr->joinable())
+        {
+            g_WorkThreadPtr->join();
+            LOG(INFO) << "CatalogBitmap::ShutDown() g_WorkThreadPtr.join() finish.";
+        }
+    }
+}
+
+int CatalogBitmap::PruneItems(const RequestData &requestData, ResponseData &responseData) const
+{
+    auto spData = std::atomic_load(&m_spData);
+    if (spData == nullptr)
+    {
+        return 0;
+    }
+
+    int prune_num = 0;
+    auto lambda_prune = [&](std::vector<ItemInfo> &vecItemList) -> void
+    {
+        size_t keep_idx = 0;
+        for (size_t idx = 0; idx < vecItemList.size(); idx++)
+        {
+            auto &item_info = vecItemList[idx];
+            if (!spData->IsAvailable(item_info.item_id, item_info.res_type))
+            {
+                prune_num++;
+                continue;
+            }
+
+            if (keep_idx != idx)
+            {
+                vecItemList[keep_idx] = std::move(item_info);
+            }
+            keep_idx++;
+        }
+        vecItemList.erase(vecItemList.begin() + keep_idx, vecItemList.end());
+    };
+
+    lambda_prune(responseData.items_list);
+    lambda_prune(responseData.spare_items_list);
+    for (auto iter = responseData.exclusive_items_list.begin();
+         iter != responseData.exclusive_items_list.end(); iter++)
+    {
+        lambda_prune(iter->second);
+    }
+
+#ifdef DEBUG
+    LOG(INFO) << "[DEBUG] CatalogBitmap::PruneItems()"
+              << ", apiType" << requestData.apiType
+              << ", uuid = " << requestData.uuid
+              << ", user_id = " << requestData.user_id
+              << ", version = " << spData->version
+              << ", prune_num = " << prune_num;
+#endif
+
+    return prune_num;
+}
+
+bool CatalogBitmap::Refresh()
+{
+    std::string data;
+    bool from_redis = !m_RedisKey.empty() && LoadFromRedis(data);
+    if (!from_redis && !LoadFromSnapshot(data))
+    {
+        return false;
+    }
+
+    auto spData = std::make_shared<CatalogBitmapData>();
+    if (!spData->Decode(data))
+    {
+        LOG(ERROR) << "CatalogBitmap::Refresh() Decode failed, from_redis = " << from_redis;
+        return false;
+    }
+    spData->version = Common::get_timestamp();
+
+    size_t bitmap_bytes = 0;
+    for (const auto &res_type_bitmap : spData->mapResTypeBitmap)
+    {
+        bitmap_bytes += res_type_bitmap.second.vecWord.size() * sizeof(uint64_t);
+    }
+
+    std::atomic_store(&m_spData, std::shared_ptr<const CatalogBitmapData>(std::move(spData)));
+
+    if (from_redis && !m_SnapshotPath.empty())
+    {
+        SaveSnapshot(data);
+    }
+
+    LOG(INFO) << "CatalogBitmap::Refresh() succ"
+              << ", from_redis = " << from_redis
+              << ", bitmap_bytes = " << bitmap_bytes;
+    return true;
+}
+
+bool CatalogBitmap::LoadFromRedis(std::string &data) const
+{
+    auto tdRedisPtr = TDRedisConnPool::GetInstance()->GetConnect(m_RedisName);
+    if (tdRedisPtr == nullptr)
+    {
+        LOG(ERROR) << "CatalogBitmap::LoadFromRedis() GetConnect Failed"
+                   << ", RedisName = " << m_RedisName;
+        return false;
+    }
+
+    TDRedis::Error err = tdRedisPtr->GET(m_RedisKey, data);
+    if (err != TDRedis::Error::OK || data.empty())
+    {
+        LOG(ERROR) << "CatalogBitmap::LoadFromRedis() GET Failed"
+                   << ", key = " << m_RedisKey
+                   << ", err = " << err;
+        return false;
+    }
+
+    return true;
+}
+
+bool CatalogBitmap::LoadFromSnapshot(std::string &data) const
+{
+    if (m_SnapshotPath.empty())
+    {
+        return false;
+    }
+
+    if (!Common::FastReadFile(m_SnapshotPath, data, false) || data.empty())
+    {
+        LOG(ERROR) << "CatalogBitmap::LoadFromSnapshot() read failed, path = " << m_SnapshotPath;
+        return false;
+    }
+
+    return true;
+}
+
+void CatalogBitmap::SaveSnapshot(const std::string &data) const
+{
+    // 先写临时文件再重命名, 避免读到写了一半的快照
+    std::string tmp_path = m_SnapshotPath + ".tmp";
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!ofs.is_open())
+        {
+            LOG(ERROR) << "CatalogBitmap::SaveSnapshot() open failed, path = " << tmp_path;
+            return;
+        }
+        ofs.write(data.data(), data.size());
+        if (!ofs.good())
+        {
+            LOG(ERROR) << "CatalogBitmap::SaveSnapshot() write failed, path = " << tmp_path;
+            return;
+        }
+    }
+
+    if (std::rename(tmp_path.c_str(), m_SnapshotPath.c_str()) != 0)
+    {
+        LOG(ERROR) << "CatalogBitmap::SaveSnapshot() rename failed, path = " << m_SnapshotPath;
+    }
+}
+
+void CatalogBitmap::OnTimer()
+{
+    static const long sleep_ms = 100; // 每次睡 100 (ms)
+    const long interval_loop_count = m_RefreshSec * 1000 / sleep_ms;
+
+    long loop_count = 0;
+    while (g_Init)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
+        if (++loop_count < interval_loop_count)
+        {
+            continue;
+        }
+        loop_count = 0;
+
+        if (!g_Init)
+        {
+            break;
+        }
+
+        if (!Refresh())
+        {
+            LOG(ERROR) << "CatalogBitmap::OnTimer() Refresh failed, keep previous bitmap";
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Common/Singleton.h"
+
+class RequestData;
+class ResponseData;
+
+// 物料上架位图, 按 res_type 分别以 item_id 为下标
+// 位图数据格式(小端):
+//   char[4]  magic "CBM1"
+//   uint32   res_type 数量
+//   重复 res_type 数量次:
+//     int32    res_type
+//     uint64   位数 bit_num, 即 max_item_id + 1
+//     uint64[] (bit_num + 63) / 64 个字, 第 item_id 位为 1 表示在架
+struct CatalogBitmapData
+{
+    struct ResTypeBitmap
+    {
+        uint64_t bit_num = 0;
+        std::vector<uint64_t> vecWord;
+    };
+
+    std::unordered_map<int, ResTypeBitmap> mapResTypeBitmap;
+    long version = 0; // 加载时间
+
+    // 解析位图数据
+    bool Decode(const std::string &data);
+
+    // 查询物料是否可用
+    // 未知 res_type 或 item_id 超出位图范围(新上架物料)均视为可用
+    inline bool IsAvailable(long item_id, int res_type) const noexcept
+    {
+        auto iter = mapResTypeBitmap.find(res_type);
+        if (iter == mapResTypeBitmap.end())
+        {
+            return true;
+        }
+
+        uint64_t pos = static_cast<uint64_t>(item_id);
+        if (item_id < 0 || pos >= iter->second.bit_num)
+        {
+            return true;
+        }
+        return (iter->second.vecWord[pos >> 6] >> (pos & 63)) & 1;
+    }
+};
+
+class CatalogBitmap : public Singleton<CatalogBitmap>
+{
+public:
+    // 初始化, 优先从 Redis 加载, 失败时使用本地快照
+    // [in] redis_name Redis 连接名
+    // [in] redis_key 位图 Redis Key, 为空时仅使用本地快照
+    // [in] snapshot_path 本地快照文件路径, Redis 加载成功后同步写入
+    // [in] refresh_sec 刷新间隔(秒)
+    bool Init(
+        const std::string &redis_name,
+        const std::string &redis_key,
+        const std::string &snapshot_path,
+        const int refresh_sec);
+
+    void ShutDown();
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 剔除下架物料, 作用于召回、备用召回及独立召回列表
+    // [return] 剔除数量
+    int PruneItems(const RequestData &requestData, ResponseData &responseData) const;
+
+private:
+    // 加载位图, 成功后原子替换
+    bool Refresh();
+    bool LoadFromRedis(std::string &data) const;
+    bool LoadFromSnapshot(std::string &data) const;
+    void SaveSnapshot(const std::string &data) const;
+
+    void OnTimer();
+
+private:
+    std::string m_RedisName;
+    std::string m_RedisKey;
+    std::string m_SnapshotPath;
+    int m_RefreshSec = 0;
+
+    std::shared_ptr<const CatalogBitmapData> m_spData = nullptr;
+
+    std::atomic<bool> g_Init = false;
+    std::shared_ptr<std::thread> g_WorkThreadPtr;
+
+public:
+    CatalogBitmap(token) {}
+    ~CatalogBitmap() {}
+    CatalogBitmap(CatalogBitmap &) = delete;
+    CatalogBitmap &operator=(const CatalogBitmap &) = delete;
+};
@@ -2,166 +2,112 @@
 #include "glog/logging.h"
 
 #include "Common/Function.h"
+#include "DownloadSetCache.h"
 
-int DownloadFilter::CallStrategy(
+int DownloadFilter::InitPredicate(
     const RequestData &requestData,
     const FilterParam &filterParams,
-    ResponseData &responseData)
+    FilterPredicate &predicate)
 {
-    if (responseData.items_list.size() <= 0 &&
-        responseData.spare_items_list.size() <= 0)
-    {
-        LOG(WARNING) << "DownloadFilter::CallStrategy() item is empty"
-                     << ", apiType" << requestData.apiType
-                     << ", filterExpID = " << requestData.filterExpID
-                     << ", uuid = " << requestData.uuid
-                     << ", user_id = " << requestData.user_id;
-        return Common::Error::OK;
-    }
-
     // 有效时间
     int validity_time = filterParams.GetValidityTime();
     if (validity_time <= 0)
     {
-        LOG(ERROR) << "DownloadFilter::CallStrategy() ValidityTime is zero."
+        LOG(ERROR) << "DownloadFilter::InitPredicate() ValidityTime is zero."
                    << ", apiType" << requestData.apiType
                    << ", exp_id = " << requestData.displayExpID;
         return Common::Error::Filter_GetParamsError;
     }
 
-    auto ufd = requestData.GetUserFeature().GetUserFeatureDownload();
-    if (ufd == nullptr)
-    {
-#ifdef DEBUG
-        LOG(INFO) << "[DEBUG] DownloadFilter::CallStrategy() UserFeatureDownload is nullptr"
-                  << ", apiType" << requestData.apiType
-                  << ", filterExpID = " << requestData.filterExpID
-                  << ", uuid = " << requestData.uuid
-                  << ", user_id = " << requestData.user_id;
-#endif
-        return Common::Error::OK;
-    }
+    // 1. 优先查询缓存
+    auto cache = DownloadSetCache::GetInstance();
+    bool use_cache = cache->IsInit() && requestData.user_id > 0;
+    DownloadSetCache::CacheKey cache_key;
+    cache_key.user_id = requestData.user_id;
+    cache_key.res_type = requestData.context_res_type;
+    cache_key.validity_time = validity_time;
 
-    const auto &ufd_download_item = ufd->download_item();
-    auto iter = ufd_download_item.find(requestData.context_res_type);
-    if (iter == ufd_download_item.end())
+    std::shared_ptr<const UserDownloadSet> spDownloadSet = nullptr;
+    if (use_cache)
     {
-#ifdef DEBUG
-        LOG(INFO) << "[DEBUG] DownloadFilter::CallStrategy() ResType Download is empty"
-                  << ", apiType" << requestData.apiType
-                  << ", filterExpID = " << requestData.filterExpID
-                  << ", uuid = " << requestData.uuid
-                  << ", user_id = " << requestData.user_id;
-#endif
-        return Common::Error::OK;
+        spDownloadSet = cache->Get(cache_key);
     }
 
-    auto &download_list = iter->second.id_list();
-    if (download_list.size() == 0)
+    // 2. 未命中则构建, 空集合同样缓存
+    if (spDownloadSet == nullptr)
     {
-#ifdef DEBUG
-        LOG(INFO) << "[DEBUG] DownloadFilter::CallStrategy() Download List is empty"
-                  << ", apiType" << requestData.apiType
-                  << ", filterExpID = " << requestData.filterExpID
-                  << ", uuid = " << requestData.uuid
-                  << ", user_id = " << requestData.user_id;
-#endif
-        return Common::Error::OK;
-    }
-
-#ifdef DEBUG
-    std::stringstream downloadDataInfo;
-#endif
-    long now_time = Common::get_timestamp();
-    std::unordered_set<std::string> download_items_set;
-    for (const auto &id_time : download_list)
-    {
-        if (now_time - id_time.timestamp() < validity_time)
+        spDownloadSet = BuildDownloadSet(requestData, validity_time);
+        if (use_cache)
         {
-            std::string item_key = std::to_string(id_time.id()) + "_" + std::to_string(requestData.context_res_type);
-            download_items_set.insert(item_key);
-
-#ifdef DEBUG
-            if (!downloadDataInfo.str().empty())
-            {
-                downloadDataInfo << ", ";
-            }
-            downloadDataInfo << item_key;
-#endif
+            cache->Put(cache_key, spDownloadSet);
         }
     }
+
 #ifdef DEBUG
-    LOG(INFO) << "[DEBUG] DownloadFilter::CallStrategy() Download List"
+    LOG(INFO) << "[DEBUG] DownloadFilter::InitPredicate() Download Set"
               << ", apiType" << requestData.apiType
               << ", filterExpID = " << requestData.filterExpID
               << ", uuid = " << requestData.uuid
               << ", user_id = " << requestData.user_id
-              << ", List = [" << downloadDataInfo.str() << "]";
+              << ", size = " << spDownloadSet->Size();
 #endif
 
-    auto lambda_filter =
-        [&](std::vector<ItemInfo> &vecItemList,
-            std::stringstream &filterInfo,
-            int &filterNum) -> void
+    if (spDownloadSet->Empty())
     {
-        auto originalItemList = std::move(vecItemList);
-
-        vecItemList.clear();
-        vecItemList.reserve(originalItemList.size());
-        for (auto &item_info : originalItemList)
-        {
-            std::string item_key = std::to_string(item_info.item_id) + "_" + std::to_string(item_info.res_type);
-            if (download_items_set.find(item_key) != download_items_set.end())
-            {
-                if (!filterInfo.str().empty())
-                {
-                    filterInfo << ", ";
-                }
-                filterInfo << item_key;
-
-                filterNum++;
-                continue;
-            }
+        return Common::Error::OK;
+    }
 
-            vecItemList.emplace_back(std::move(item_info));
-        }
+    predicate = [spDownloadSet](const ItemInfo &item_info) -> bool
+    {
+        return spDownloadSet->Contains(UserDownloadSet::MakeKey(item_info.item_id, item_info.res_type));
     };
 
-    // 1. 过滤召回数据
-    int filter_num = 0;
-    std::stringstream filter_info;
-    lambda_filter(responseData.items_list, filter_info, filter_num);
+    return Common::Error::OK;
+}
 
-    // 2. 过滤备用召回数据
-    lambda_filter(responseData.spare_items_list, filter_info, filter_num);
+std::shared_ptr<const UserDownloadSet> DownloadFilter::BuildDownloadSet(
+    const RequestData &requestData,
+    int validity_time)
+{
+    long now_time = Common::get_timestamp();
+    int context_res_type = requestData.context_res_type;
+    std::vector<uint64_t> keys;
 
-    // 3. 过滤独立召回数据
-    std::stringstream exclusive_size_info;
-    for (auto iter = responseData.exclusive_items_list.begin();
-         iter != responseData.exclusive_items_list.end(); iter++)
+    auto lambda_add = [&](const auto &download_item) -> void
     {
-        lambda_filter(iter->second, filter_info, filter_num);
+        auto iter = download_item.find(context_res_type);
+        if (iter == download_item.end())
+        {
+            return;
+        }
 
-        if (!exclusive_size_info.str().empty())
+        const auto &download_list = iter->second.id_list();
+        keys.reserve(keys.size() + download_list.size());
+        for (const auto &id_time : download_list)
         {
-            exclusive_size_info << ", ";
+            if (now_time - id_time.timestamp() < validity_time)
+            {
+                keys.push_back(UserDownloadSet::MakeKey(id_time.id(), context_res_type));
+            }
         }
-        exclusive_size_info << iter->first << ":" << iter->second.size();
+    };
+
+    // 历史下载
+    const auto &userFeature = requestData.GetUserFeature();
+    auto ufd = userFeature.GetUserFeatureDownload();
+    if (ufd != nullptr)
+    {
+        lambda_add(ufd->download_item());
     }
 
-    if (!filter_info.str().empty() && filterParams.GetFilterLogSwitch() > 0)
+    // 实时下载
+    auto ulfd = userFeature.GetUserLiveFeatureDownload();
+    if (ulfd != nullptr)
     {
-        LOG(INFO) << "DownloadFilter::CallStrategy() Download Filter List"
-                  << ", apiType" << requestData.apiType
-                  << ", filterExpID = " << requestData.filterExpID
-                  << ", uuid = " << requestData.uuid
-                  << ", user_id = " << requestData.user_id
-                  << ", filter_num = " << filter_num
-                  << ", item size = " << responseData.items_list.size()
-                  << ", spare item size = " << responseData.spare_items_list.size()
-                  << ", exclusive item size = [" << exclusive_size_info.str()
-                  << "], Filter Info = {" << filter_info.str() << "}";
+        lambda_add(ulfd->download_item());
     }
 
-    return Common::Error::OK;
+    auto spDownloadSet = std::make_shared<UserDownloadSet>();
+    spDownloadSet->Build(std::move(keys));
+    return spDownloadSet;
 }
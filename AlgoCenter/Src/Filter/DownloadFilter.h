@@ -2,17 +2,25 @@
 #include "Common/Singleton.h"
 #include "Filter_Interface.h"
 
+class UserDownloadSet;
+
 // 历史曝光过滤策略
 class DownloadFilter
     : public Singleton<DownloadFilter>,
       public Filter_Interface
 {
 public:
-    // CallStrategy 调用过滤策略接口
-    virtual int CallStrategy(
+    // InitPredicate 构造过滤谓词
+    virtual int InitPredicate(
         const RequestData &requestData,
         const FilterParam &filterParams,
-        ResponseData &responseData) override;
+        FilterPredicate &predicate) override;
+
+protected:
+    // BuildDownloadSet 由历史下载与实时下载构建有效期内的已下载集合
+    std::shared_ptr<const UserDownloadSet> BuildDownloadSet(
+        const RequestData &requestData,
+        int validity_time);
 
 public:
     DownloadFilter(token) {}
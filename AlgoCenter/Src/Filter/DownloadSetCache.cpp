@@ -0,0 +1,96 @@
+#include "DownloadSetCache.h"
+#include <chrono>
+#include <algorithm>
+#include "glog/logging.h"
+
+void UserDownloadSet::Build(std::vector<uint64_t> &&keys)
+{
+    vecKey = std::move(keys);
+    std::sort(vecKey.begin(), vecKey.end());
+    vecKey.erase(std::unique(vecKey.begin(), vecKey.end()), vecKey.end());
+    vecKey.shrink_to_fit();
+}
+
+bool DownloadSetCache::Init(int capacity, int ttl_ms)
+{
+    if (capacity <= 0 || ttl_ms <= 0)
+    {
+        LOG(ERROR) << "DownloadSetCache::Init() params error"
+                   << ", capacity = " << capacity
+                   << ", ttl_ms = " << ttl_ms;
+        return false;
+    }
+
+    m_ShardCapacity = std::max(1, capacity / ShardNum);
+    m_TTLMs = ttl_ms;
+    g_Init = true;
+
+    LOG(INFO) << "DownloadSetCache::Init() succ"
+              << ", capacity = " << capacity
+              << ", shard_capacity = " << m_ShardCapacity
+              << ", ttl_ms = " << ttl_ms;
+    return true;
+}
+
+std::shared_ptr<const UserDownloadSet> DownloadSetCache::Get(const CacheKey &key)
+{
+    long now_ms = GetNowMs();
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    auto iter = shard.data.find(key);
+    if (iter == shard.data.end())
+    {
+        m_MissCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    if (iter->second.expire_ms <= now_ms)
+    {
+        // 过期淘汰
+        shard.lru.erase(iter->second.lru_iter);
+        shard.data.erase(iter);
+        m_MissCount.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    shard.lru.splice(shard.lru.begin(), shard.lru, iter->second.lru_iter);
+    m_HitCount.fetch_add(1, std::memory_order_relaxed);
+    return iter->second.spSet;
+}
+
+void DownloadSetCache::Put(const CacheKey &key, std::shared_ptr<const UserDownloadSet> spSet)
+{
+    long expire_ms = GetNowMs() + m_TTLMs;
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    auto iter = shard.data.find(key);
+    if (iter != shard.data.end())
+    {
+        iter->second.spSet = std::move(spSet);
+        iter->second.expire_ms = expire_ms;
+        shard.lru.splice(shard.lru.begin(), shard.lru, iter->second.lru_iter);
+        return;
+    }
+
+    // 超出容量, 淘汰最久未使用
+    while (shard.data.size() >= m_ShardCapacity && !shard.lru.empty())
+    {
+        shard.data.erase(shard.lru.back());
+        shard.lru.pop_back();
+    }
+
+    shard.lru.push_front(key);
+    auto &node = shard.data[key];
+    node.spSet = std::move(spSet);
+    node.expire_ms = expire_ms;
+    node.lru_iter = shard.lru.begin();
+}
+
+long DownloadSetCache::GetNowMs() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
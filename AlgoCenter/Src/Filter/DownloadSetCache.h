@@ -0,0 +1,139 @@
+#pragma once
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Common/Singleton.h"
+
+// 用户物料集合(已下载/已曝光), 有序 uint64 数组, 构建后只读
+class UserDownloadSet
+{
+public:
+    // 物料键, 高位 item_id, 低 16 位 res_type
+    static inline uint64_t MakeKey(long item_id, int res_type) noexcept
+    {
+        return (static_cast<uint64_t>(item_id) << 16) | (static_cast<uint64_t>(res_type) & 0xFFFF);
+    }
+
+    // 构建集合, 排序去重
+    void Build(std::vector<uint64_t> &&keys);
+
+    // 无分支二分查找
+    inline bool Contains(uint64_t key) const noexcept
+    {
+        size_t n = vecKey.size();
+        if (n == 0)
+        {
+            return false;
+        }
+
+        const uint64_t *base = vecKey.data();
+        while (n > 1)
+        {
+            size_t half = n >> 1;
+            base = (base[half] <= key) ? base + half : base;
+            n -= half;
+        }
+        return *base == key;
+    }
+
+    inline size_t Size() const noexcept { return vecKey.size(); }
+    inline bool Empty() const noexcept { return vecKey.empty(); }
+
+private:
+    std::vector<uint64_t> vecKey;
+};
+
+// 用户已下载集合缓存, 分片 LRU + TTL
+// 同一用户连续翻页时复用, 避免每次请求重建
+class DownloadSetCache : public Singleton<DownloadSetCache>
+{
+public:
+    // 缓存键, 有效期参数不同的实验各自缓存
+    struct CacheKey
+    {
+        long user_id = 0;
+        int res_type = 0;
+        int validity_time = 0;
+
+        bool operator==(const CacheKey &other) const noexcept
+        {
+            return user_id == other.user_id &&
+                   res_type == other.res_type &&
+                   validity_time == other.validity_time;
+        }
+    };
+
+public:
+    // 初始化
+    // [in] capacity 缓存用户集合总数
+    // [in] ttl_ms 缓存有效期(毫秒)
+    bool Init(int capacity, int ttl_ms);
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 查询缓存, 未命中或过期返回 nullptr
+    std::shared_ptr<const UserDownloadSet> Get(const CacheKey &key);
+
+    // 写入缓存
+    void Put(const CacheKey &key, std::shared_ptr<const UserDownloadSet> spSet);
+
+    inline long GetHitCount() const noexcept { return m_HitCount.load(std::memory_order_relaxed); }
+    inline long GetMissCount() const noexcept { return m_MissCount.load(std::memory_order_relaxed); }
+
+private:
+    struct CacheKeyHash
+    {
+        size_t operator()(const CacheKey &key) const noexcept
+        {
+            uint64_t h = static_cast<uint64_t>(key.user_id);
+            h ^= (static_cast<uint64_t>(key.res_type) << 40) ^ (static_cast<uint64_t>(key.validity_time) << 20);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            return static_cast<size_t>(h);
+        }
+    };
+
+    struct CacheNode
+    {
+        std::shared_ptr<const UserDownloadSet> spSet;
+        long expire_ms = 0;
+        std::list<CacheKey>::iterator lru_iter;
+    };
+
+    struct CacheShard
+    {
+        std::mutex mtx;
+        std::list<CacheKey> lru; // 头部最近使用
+        std::unordered_map<CacheKey, CacheNode, CacheKeyHash> data;
+    };
+
+    static constexpr int ShardNum = 32;
+
+    inline CacheShard &GetShard(const CacheKey &key) noexcept
+    {
+        return m_Shard[CacheKeyHash()(key) % ShardNum];
+    }
+
+    static long GetNowMs() noexcept;
+
+private:
+    std::atomic<bool> g_Init = false;
+    size_t m_ShardCapacity = 0;
+    long m_TTLMs = 0;
+    CacheShard m_Shard[ShardNum];
+
+    std::atomic<long> m_HitCount = 0;
+    std::atomic<long> m_MissCount = 0;
+
+public:
+    DownloadSetCache(token) {}
+    ~DownloadSetCache() {}
+    DownloadSetCache(DownloadSetCache &) = delete;
+    DownloadSetCache &operator=(const DownloadSetCache &) = delete;
+};
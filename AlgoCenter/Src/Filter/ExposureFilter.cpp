@@ -0,0 +1,51 @@
+#include "ExposureFilter.h"
+#include "glog/logging.h"
+
+#include "ExposureStore.h"
+#include "DownloadSetCache.h"
+
+int ExposureFilter::InitPredicate(
+    const RequestData &requestData,
+    const FilterParam &filterParams,
+    FilterPredicate &predicate)
+{
+    auto store = ExposureStore::GetInstance();
+    if (!store->IsInit() || requestData.user_id <= 0)
+    {
+        return Common::Error::OK;
+    }
+
+    // 窗口期, 未配置时使用存储有效期
+    int window_sec = filterParams.GetValidityTime();
+
+    ExposureStore::ExposureKey key;
+    key.user_id = requestData.user_id;
+    key.context_item_id = requestData.context_item_id;
+    key.context_res_type = requestData.context_res_type;
+
+    std::vector<uint64_t> vecItemKey;
+    store->GetExposed(key, window_sec, vecItemKey);
+    if (vecItemKey.empty())
+    {
+        return Common::Error::OK;
+    }
+
+    auto spExposedSet = std::make_shared<UserDownloadSet>();
+    spExposedSet->Build(std::move(vecItemKey));
+
+#ifdef DEBUG
+    LOG(INFO) << "[DEBUG] ExposureFilter::InitPredicate() Exposed Set"
+              << ", apiType" << requestData.apiType
+              << ", filterExpID = " << requestData.filterExpID
+              << ", uuid = " << requestData.uuid
+              << ", user_id = " << requestData.user_id
+              << ", size = " << spExposedSet->Size();
+#endif
+
+    predicate = [spExposedSet](const ItemInfo &item_info) -> bool
+    {
+        return spExposedSet->Contains(UserDownloadSet::MakeKey(item_info.item_id, item_info.res_type));
+    };
+
+    return Common::Error::OK;
+}
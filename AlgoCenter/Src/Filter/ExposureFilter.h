@@ -0,0 +1,22 @@
+#pragma once
+#include "Common/Singleton.h"
+#include "Filter_Interface.h"
+
+// 近期曝光过滤策略, 过滤同一用户同一上下文下近期已返回的物料
+class ExposureFilter
+    : public Singleton<ExposureFilter>,
+      public Filter_Interface
+{
+public:
+    // InitPredicate 构造过滤谓词
+    virtual int InitPredicate(
+        const RequestData &requestData,
+        const FilterParam &filterParams,
+        FilterPredicate &predicate) override;
+
+public:
+    ExposureFilter(token) {}
+    ~ExposureFilter() {}
+    ExposureFilter(ExposureFilter &) = delete;
+    ExposureFilter &operator=(const ExposureFilter &) = delete;
+};
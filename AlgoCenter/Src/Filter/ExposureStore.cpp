@@ -0,0 +1,117 @@
+#include "ExposureStore.h"
+#include <algorithm>
+#include "glog/logging.h"
+
+#include "Common/Function.h"
+
+bool ExposureStore::Init(int ring_size, int ttl_sec, int memory_budget_mb)
+{
+    if (ring_size <= 0 || ttl_sec <= 0 || memory_budget_mb <= 0)
+    {
+        LOG(ERROR) << "ExposureStore::Init() params error"
+                   << ", ring_size = " << ring_size
+                   << ", ttl_sec = " << ttl_sec
+                   << ", memory_budget_mb = " << memory_budget_mb;
+        return false;
+    }
+
+    // 单用户内存: 环形缓冲 + 哈希节点 + LRU 节点的估算值
+    size_t user_bytes = sizeof(ExposureRing) + sizeof(ExposureKey) * 2 + 64 +
+                        static_cast<size_t>(ring_size) * (sizeof(uint64_t) + sizeof(long));
+    size_t total_user_limit = static_cast<size_t>(memory_budget_mb) * 1024 * 1024 / user_bytes;
+
+    m_RingSize = ring_size;
+    m_TTLSec = ttl_sec;
+    m_ShardUserLimit = std::max<size_t>(1, total_user_limit / ShardNum);
+    g_Init = true;
+
+    LOG(INFO) << "ExposureStore::Init() succ"
+              << ", ring_size = " << ring_size
+              << ", ttl_sec = " << ttl_sec
+              << ", memory_budget_mb = " << memory_budget_mb
+              << ", user_bytes = " << user_bytes
+              << ", shard_user_limit = " << m_ShardUserLimit;
+    return true;
+}
+
+void ExposureStore::Record(const ExposureKey &key, const std::vector<uint64_t> &vecItemKey)
+{
+    if (vecItemKey.empty())
+    {
+        return;
+    }
+
+    long now_time = Common::get_timestamp();
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    auto iter = shard.data.find(key);
+    if (iter == shard.data.end())
+    {
+        // 淘汰: 先淘汰过期, 再按内存预算淘汰最久未更新
+        while (!shard.lru.empty())
+        {
+            auto tail = shard.data.find(shard.lru.back());
+            if (shard.data.size() < m_ShardUserLimit && now_time - tail->second.update_time < m_TTLSec)
+            {
+                break;
+            }
+            shard.data.erase(tail);
+            shard.lru.pop_back();
+            m_UserNum.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        shard.lru.push_front(key);
+        iter = shard.data.emplace(key, ExposureRing()).first;
+        iter->second.vecItemKey.resize(m_RingSize);
+        iter->second.vecTime.resize(m_RingSize);
+        iter->second.lru_iter = shard.lru.begin();
+        m_UserNum.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        shard.lru.splice(shard.lru.begin(), shard.lru, iter->second.lru_iter);
+    }
+
+    auto &ring = iter->second;
+    for (const auto item_key : vecItemKey)
+    {
+        ring.vecItemKey[ring.head] = item_key;
+        ring.vecTime[ring.head] = now_time;
+        ring.head = (ring.head + 1) % m_RingSize;
+        ring.size = std::min(ring.size + 1, m_RingSize);
+    }
+    ring.update_time = now_time;
+}
+
+void ExposureStore::GetExposed(const ExposureKey &key, int window_sec, std::vector<uint64_t> &vecItemKey)
+{
+    long now_time = Common::get_timestamp();
+    long window = (window_sec > 0) ? std::min<long>(window_sec, m_TTLSec) : m_TTLSec;
+    auto &shard = GetShard(key);
+
+    std::lock_guard<std::mutex> lg(shard.mtx);
+    auto iter = shard.data.find(key);
+    if (iter == shard.data.end())
+    {
+        return;
+    }
+
+    const auto &ring = iter->second;
+    if (now_time - ring.update_time >= window)
+    {
+        return;
+    }
+
+    // 从最新往前遍历, 遇到窗口外即停止
+    vecItemKey.reserve(ring.size);
+    for (int idx = 0; idx < ring.size; idx++)
+    {
+        int pos = (ring.head - 1 - idx + m_RingSize) % m_RingSize;
+        if (now_time - ring.vecTime[pos] >= window)
+        {
+            break;
+        }
+        vecItemKey.push_back(ring.vecItemKey[pos]);
+    }
+}
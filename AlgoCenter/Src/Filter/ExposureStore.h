@@ -0,0 +1,101 @@
+#pragma once
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Common/Singleton.h"
+
+// 近期曝光存储, 记录每个用户在同一上下文下最近返回的物料
+// 分片加锁哈希, 每个用户一个定长环形缓冲, 过期时间 + 内存预算淘汰
+class ExposureStore : public Singleton<ExposureStore>
+{
+public:
+    // 曝光键, 用户 + 上下文
+    struct ExposureKey
+    {
+        long user_id = 0;
+        long context_item_id = 0;
+        int context_res_type = 0;
+
+        bool operator==(const ExposureKey &other) const noexcept
+        {
+            return user_id == other.user_id &&
+                   context_item_id == other.context_item_id &&
+                   context_res_type == other.context_res_type;
+        }
+    };
+
+public:
+    // 初始化
+    // [in] ring_size 每个用户保留的最近曝光数量
+    // [in] ttl_sec 曝光有效期(秒)
+    // [in] memory_budget_mb 内存预算(MB)
+    bool Init(int ring_size, int ttl_sec, int memory_budget_mb);
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 记录本次返回的物料键
+    void Record(const ExposureKey &key, const std::vector<uint64_t> &vecItemKey);
+
+    // 获取窗口期内的曝光物料键
+    // [in] window_sec 窗口期(秒), 不超过 ttl_sec
+    // [out] vecItemKey 曝光物料键
+    void GetExposed(const ExposureKey &key, int window_sec, std::vector<uint64_t> &vecItemKey);
+
+    inline long GetUserNum() const noexcept { return m_UserNum.load(std::memory_order_relaxed); }
+
+private:
+    struct ExposureKeyHash
+    {
+        size_t operator()(const ExposureKey &key) const noexcept
+        {
+            uint64_t h = static_cast<uint64_t>(key.user_id) * 0x9E3779B97F4A7C15ULL;
+            h ^= static_cast<uint64_t>(key.context_item_id) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            h ^= static_cast<uint64_t>(key.context_res_type) + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+            return static_cast<size_t>(h);
+        }
+    };
+
+    // 环形缓冲, 满后覆盖最早的曝光
+    struct ExposureRing
+    {
+        std::vector<uint64_t> vecItemKey;
+        std::vector<long> vecTime;
+        int head = 0; // 下一个写入位置
+        int size = 0;
+        long update_time = 0;
+        std::list<ExposureKey>::iterator lru_iter;
+    };
+
+    struct ExposureShard
+    {
+        std::mutex mtx;
+        std::list<ExposureKey> lru; // 头部最近更新
+        std::unordered_map<ExposureKey, ExposureRing, ExposureKeyHash> data;
+    };
+
+    static constexpr int ShardNum = 64;
+
+    inline ExposureShard &GetShard(const ExposureKey &key) noexcept
+    {
+        return m_Shard[ExposureKeyHash()(key) % ShardNum];
+    }
+
+private:
+    std::atomic<bool> g_Init = false;
+    int m_RingSize = 0;
+    long m_TTLSec = 0;
+    size_t m_ShardUserLimit = 0; // 由内存预算换算的单分片用户上限
+    ExposureShard m_Shard[ShardNum];
+
+    std::atomic<long> m_UserNum = 0;
+
+public:
+    ExposureStore(token) {}
+    ~ExposureStore() {}
+    ExposureStore(ExposureStore &) = delete;
+    ExposureStore &operator=(const ExposureStore &) = delete;
+};
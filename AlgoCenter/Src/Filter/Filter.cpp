@@ -1,29 +1,81 @@
 #include "Filter.h"
+#include <array>
+#include <sstream>
 #include <unordered_map>
 #include "glog/logging.h"
+#include "Monitor/Monitor.h"
 
 #include "UnfeaturedFilter.h"
 #include "DownloadFilter.h"
+#include "ExposureFilter.h"
 
 static std::unordered_map<std::string, std::shared_ptr<Filter_Interface>> TypeToStrategyList = {
     {Common::FilterType_Unfeatured, UnfeaturedFilter::GetInstance()},
     {Common::FilterType_Download, DownloadFilter::GetInstance()},
+    {Common::FilterType_Exposure, ExposureFilter::GetInstance()},
 };
 
-const FilterParamData *Filter::GetFilterParamData(
+int Filter::CallFilter(
+    const FilterParamData *pFilterParamData,
     const RequestData &requestData,
     ResponseData &responseData)
 {
-    return FilterConfig::GetInstance()->GetFilterParamData(
-        requestData.userGroupList, requestData.apiType, requestData.filterExpID);
+    int err = FilterItems(pFilterParamData, requestData, responseData, false);
+    if (err != Common::Error::OK)
+    {
+        return err;
+    }
+
+    // 判断是否使用备用Item
+    int items_size = responseData.items_list.size();
+    if (items_size < pFilterParamData->KeepItemNum)
+    {
+        for (const auto &item_info : responseData.spare_items_list)
+        {
+            responseData.items_list.emplace_back(item_info);
+        }
+
+        // 数据不足，补充备用Item
+        LOG(WARNING) << "Filter::CallFilter() data not enough after filter"
+                     << ", apiType" << requestData.apiType
+                     << ", uuid = " << requestData.uuid
+                     << ", user_id = " << requestData.user_id
+                     << ", recallExpID = " << requestData.recallExpID
+                     << ", filterExpID = " << requestData.filterExpID
+                     << ", displayExpID = " << requestData.displayExpID
+                     << ", before = " << items_size
+                     << ", after = " << responseData.items_list.size();
+    }
+
+    StatisLogData::OutStatisLog(requestData, responseData, "After Filter", {0}, false, true);
+
+    return Common::Error::OK;
 }
 
-int Filter::CallFilter(
+int Filter::CallDegradeFilter(
     const FilterParamData *pFilterParamData,
     const RequestData &requestData,
     ResponseData &responseData)
 {
-    // 遍历过滤参数列表, 调用过滤策略
+    return FilterItems(pFilterParamData, requestData, responseData, true);
+}
+
+bool Filter::IsDegradeFilterType(const std::string &filterType)
+{
+    // 只依赖用户特征与进程内状态, 不需要物料特征
+    return filterType == Common::FilterType_Download ||
+           filterType == Common::FilterType_Exposure;
+}
+
+int Filter::FilterItems(
+    const FilterParamData *pFilterParamData,
+    const RequestData &requestData,
+    ResponseData &responseData,
+    bool degrade)
+{
+    // 1. 遍历过滤参数列表, 构造过滤谓词链
+    int stage_num = 0;
+    std::array<FilterStage, MaxFilterStageNum> stages;
     for (const auto &filterParams : pFilterParamData->vecFilterParams)
     {
         std::string filterType = filterParams.GetFilterType();
@@ -35,6 +87,11 @@ int Filter::CallFilter(
             return Common::Error::Filter_Error;
         }
 
+        if (degrade && !IsDegradeFilterType(filterType))
+        {
+            continue;
+        }
+
         auto filterInst = GetFilterInstance(filterType);
         if (filterInst == nullptr || filterInst.get() == nullptr)
         {
@@ -45,53 +102,149 @@ int Filter::CallFilter(
             return Common::Error::Filter_GetStrategyInstError;
         }
 
-        // 调用策略
-        int err = filterInst->CallStrategy(requestData, filterParams, responseData);
+        // 配置解析已限制策略数, 这里只防御越界
+        if (stage_num >= MaxFilterStageNum)
+        {
+            LOG(ERROR) << "Filter::CallFilter() Filter Stage exceed limit"
+                       << ", apiType" << requestData.apiType
+                       << ", filterExpID = " << requestData.filterExpID
+                       << ", filterType = " << filterType
+                       << ", limit = " << MaxFilterStageNum;
+            break;
+        }
+
+        // 构造谓词
+        FilterStage &stage = stages[stage_num];
+        int err = filterInst->InitPredicate(requestData, filterParams, stage.predicate);
         if (Common::Error::OK != err)
         {
-            LOG(WARNING) << "Filter::CallFilter(), Call Strategy Failed"
+            LOG(WARNING) << "Filter::CallFilter(), Init Predicate Failed"
                          << ", apiType" << requestData.apiType
                          << ", uuid = " << requestData.uuid
                          << ", user_id = " << requestData.user_id
                          << ", filterExpID = " << requestData.filterExpID
                          << ", filterType = " << filterType
                          << ", err = " << err;
+            continue;
         }
-#ifdef DEBUG
-        else
+        if (!stage.predicate)
         {
-            LOG(INFO) << "[DEBUG] Filter::CallFilter() Call Strategy success"
-                      << ", apiType" << requestData.apiType
-                      << ", uuid = " << requestData.uuid
-                      << ", user_id = " << requestData.user_id
-                      << ", filterExpID = " << requestData.filterExpID
-                      << ", filterType = " << filterType;
+            // 本次请求无需过滤
+            continue;
         }
-#endif
+
+        stage.filterType = filterType;
+        stage.logSwitch = filterParams.GetFilterLogSwitch() > 0;
+        stage_num++;
     }
 
-    // 判断是否使用备用Item
-    int items_size = responseData.items_list.size();
-    if (items_size < pFilterParamData->KeepItemNum)
+    // 2. 各列表单次遍历, 原地压缩
+    std::array<int, MaxFilterStageNum> filter_num{};
+    std::array<std::string, MaxFilterStageNum> filter_info;
+    auto lambda_filter = [&](std::vector<ItemInfo> &vecItemList) -> void
     {
-        for (const auto &item_info : responseData.spare_items_list)
+        size_t keep_idx = 0;
+        for (size_t idx = 0; idx < vecItemList.size(); idx++)
         {
-            responseData.items_list.emplace_back(item_info);
+            auto &item_info = vecItemList[idx];
+
+            int hit_stage = -1;
+            for (int stage_idx = 0; stage_idx < stage_num; stage_idx++)
+            {
+                if (stages[stage_idx].predicate(item_info))
+                {
+                    hit_stage = stage_idx;
+                    break;
+                }
+            }
+
+            if (hit_stage >= 0)
+            {
+                filter_num[hit_stage]++;
+                if (stages[hit_stage].logSwitch)
+                {
+                    auto &info = filter_info[hit_stage];
+                    if (!info.empty())
+                    {
+                        info.append(", ");
+                    }
+                    info.append(std::to_string(item_info.item_id)).append("_").append(std::to_string(item_info.res_type));
+                }
+                continue;
+            }
+
+            if (keep_idx != idx)
+            {
+                vecItemList[keep_idx] = std::move(item_info);
+            }
+            keep_idx++;
         }
+        vecItemList.erase(vecItemList.begin() + keep_idx, vecItemList.end());
+    };
 
-        // 数据不足，补充备用Item
-        LOG(WARNING) << "Filter::CallFilter() data not enough after filter"
-                     << ", apiType" << requestData.apiType
-                     << ", uuid = " << requestData.uuid
-                     << ", user_id = " << requestData.user_id
-                     << ", recallExpID = " << requestData.recallExpID
-                     << ", filterExpID = " << requestData.filterExpID
-                     << ", displayExpID = " << requestData.displayExpID
-                     << ", before = " << items_size
-                     << ", after = " << responseData.items_list.size();
+    if (stage_num > 0)
+    {
+        lambda_filter(responseData.items_list);
+        lambda_filter(responseData.spare_items_list);
+        for (auto iter = responseData.exclusive_items_list.begin();
+             iter != responseData.exclusive_items_list.end(); iter++)
+        {
+            lambda_filter(iter->second);
+        }
     }
 
-    StatisLogData::OutStatisLog(requestData, responseData, "After Filter", {0}, false, true);
+    // 3. 各策略过滤数量计入监控, 不受日志开关影响
+    auto monitor = Monitor::GetInstance();
+    if (monitor->IsInit() && stage_num > 0)
+    {
+        const std::string api = std::to_string(static_cast<int>(requestData.apiType));
+        for (int stage_idx = 0; stage_idx < stage_num; stage_idx++)
+        {
+            monitor->ObserveFilterDrop(api, stages[stage_idx].filterType, filter_num[stage_idx]);
+        }
+    }
+
+    // 4. 过滤日志, 仅在开关打开且有过滤时输出
+    for (int stage_idx = 0; stage_idx < stage_num; stage_idx++)
+    {
+        const auto &stage = stages[stage_idx];
+        if (!stage.logSwitch || filter_num[stage_idx] == 0)
+        {
+            continue;
+        }
+
+        std::stringstream exclusive_size_info;
+        for (auto iter = responseData.exclusive_items_list.begin();
+             iter != responseData.exclusive_items_list.end(); iter++)
+        {
+            if (!exclusive_size_info.str().empty())
+            {
+                exclusive_size_info << ", ";
+            }
+            exclusive_size_info << iter->first << ":" << iter->second.size();
+        }
+
+        LOG(INFO) << "Filter::CallFilter() Filter List"
+                  << ", apiType" << requestData.apiType
+                  << ", filterExpID = " << requestData.filterExpID
+                  << ", uuid = " << requestData.uuid
+                  << ", user_id = " << requestData.user_id
+                  << ", filterType = " << stage.filterType
+                  << ", filter_num = " << filter_num[stage_idx]
+                  << ", item size = " << responseData.items_list.size()
+                  << ", spare item size = " << responseData.spare_items_list.size()
+                  << ", exclusive item size = [" << exclusive_size_info.str()
+                  << "], Filter Info = {" << filter_info[stage_idx] << "}";
+    }
+#ifdef DEBUG
+    LOG(INFO) << "[DEBUG] Filter::FilterItems() Call Filter success"
+              << ", apiType" << requestData.apiType
+              << ", degrade = " << degrade
+              << ", uuid = " << requestData.uuid
+              << ", user_id = " << requestData.user_id
+              << ", filterExpID = " << requestData.filterExpID
+              << ", stage_num = " << stage_num;
+#endif
 
     return Common::Error::OK;
 }
@@ -5,27 +5,53 @@
 #include "Common/Singleton.h"
 
 #include "FilterConfig.h"
+#include "Filter_Interface.h"
 
 class RequestData;
 class ResponseData;
-class Filter_Interface;
 
 class Filter : public Singleton<Filter>
 {
 public:
-    const FilterParamData *GetFilterParamData(
+    // 过滤统一入口
+    // [in] requestData 请求数据
+    // [out] responseData 返回数据
+    int CallFilter(
+        const FilterParamData *pFilterParamData,
         const RequestData &requestData,
         ResponseData &responseData);
 
-    // 过滤统一入口
+    // 降级链路过滤入口, 物料特征未初始化, 只执行不依赖物料特征的策略(下载、曝光), 不补充备用物料
     // [in] requestData 请求数据
     // [out] responseData 返回数据
-    int CallFilter(
+    int CallDegradeFilter(
         const FilterParamData *pFilterParamData,
         const RequestData &requestData,
         ResponseData &responseData);
 
 protected:
+    // 构造谓词链并对各列表单次遍历过滤
+    // [in] degrade 降级链路, 跳过依赖物料特征的策略
+    int FilterItems(
+        const FilterParamData *pFilterParamData,
+        const RequestData &requestData,
+        ResponseData &responseData,
+        bool degrade);
+
+    // 降级链路可执行的过滤策略
+    static bool IsDegradeFilterType(const std::string &filterType);
+
+    // 单次请求最多执行的过滤策略数, 与配置解析的上限一致
+    static constexpr int MaxFilterStageNum = FilterParamData::MaxFilterParamNum;
+
+    // 过滤阶段, 谓词按配置顺序执行, 命中第一个即过滤
+    struct FilterStage
+    {
+        std::string filterType;
+        bool logSwitch = false;
+        FilterPredicate predicate;
+    };
+
     static std::shared_ptr<Filter_Interface> GetFilterInstance(
         const std::string &filterType);
 
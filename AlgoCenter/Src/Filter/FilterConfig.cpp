@@ -17,64 +17,6 @@ bool FilterConfig::UpdateJson(const std::string &json_data)
     return FilterConfig::Error::OK == DecodeJsonData(json_data);
 }
 
-const int FilterConfig::MatchFilterExpID(
-    const Common::APIType apiType,
-    const std::vector<int> &vecExpIDList) const
-{
-    int dataIdx = m_dataIdx;
-    int type = static_cast<int>(apiType);
-    auto itType = m_data[dataIdx].m_FilterParamData.find(type);
-    if (itType != m_data[dataIdx].m_FilterParamData.end())
-    {
-        for (auto exp_id : vecExpIDList)
-        {
-            if (exp_id != 0)
-            {
-                auto itExp = itType->second.find(exp_id);
-                if (itExp != itType->second.end())
-                {
-                    return exp_id;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-const FilterParamData *FilterConfig::GetFilterParamData(
-    const std::unordered_set<std::string> &userGroupList, Common::APIType apiType, int exp_id) const
-{
-    int dataIdx = m_dataIdx;
-    int type = static_cast<int>(apiType);
-
-    const FilterParamData *pFilterParamData = nullptr;
-    auto itType = m_data[dataIdx].m_FilterParamData.find(type);
-    if (itType != m_data[dataIdx].m_FilterParamData.end())
-    {
-        auto itExp = itType->second.find(exp_id);
-        if (itExp == itType->second.end())
-        {
-            // 如果没有这个exp_id, 则使用默认exp_id -> 0
-            itExp = itType->second.find(0);
-        }
-        if (itExp != itType->second.end())
-        {
-            for (const auto &itemGroup : itExp->second)
-            {
-                // 默认组用户配置优先级最低，必须放列表最后
-                // 先匹配其他用户组配置，命中其他用户组配置或者遇到最后的默认用户组配置，即完成匹配并退出循环
-                if (userGroupList.find(itemGroup.user_group) != userGroupList.end() ||
-                    itemGroup.user_group == Common::DefaultUserGroup)
-                {
-                    pFilterParamData = &itemGroup;
-                    break;
-                }
-            }
-        }
-    }
-    return pFilterParamData;
-}
-
 FilterConfig::Error FilterConfig::DecodeJsonData(const std::string &jsonData)
 {
     rapidjson::Document doc;
@@ -84,22 +26,22 @@ FilterConfig::Error FilterConfig::DecodeJsonData(const std::string &jsonData)
         return FilterConfig::Error::ParseError;
     }
 
-    // 缓存下标
-    int idx = (m_dataIdx + 1) % 2;
+    // 在新对象上解析, 完成后整体替换, 已持有旧数据的请求不受影响
+    auto spData = std::make_shared<FilterConfigData>();
 
     // 解析召回融合配置
-    auto cfgErr = DecodeFilterParamData(doc, idx);
+    auto cfgErr = DecodeFilterParamData(doc, *spData);
     if (cfgErr != FilterConfig::Error::OK)
     {
         return cfgErr;
     }
 
-    m_dataIdx = idx;
+    std::atomic_store(&m_spData, std::shared_ptr<const FilterConfigData>(std::move(spData)));
 
     return FilterConfig::Error::OK;
 }
 
-FilterConfig::Error FilterConfig::DecodeFilterParamData(rapidjson::Document &doc, int dataIdx)
+FilterConfig::Error FilterConfig::DecodeFilterParamData(rapidjson::Document &doc, FilterConfigData &data)
 {
     if (!doc.HasMember("Filter") || !doc["Filter"].IsObject())
     {
@@ -157,7 +99,7 @@ FilterConfig::Error FilterConfig::DecodeFilterParamData(rapidjson::Document &doc
             rapidjson::SizeType UserGroupListSize = userGroupList.Size();
 
             bool def_group_user_conf = false;
-            auto &configItemList = m_data[dataIdx].m_FilterParamData[apiType][exp_id];
+            auto &configItemList = data.m_FilterParamData[apiType][exp_id];
             configItemList.resize(UserGroupListSize);
             for (rapidjson::SizeType UserGroupListIdx = 0; UserGroupListIdx < UserGroupListSize; ++UserGroupListIdx)
             {
@@ -211,6 +153,16 @@ FilterConfig::Error FilterConfig::DecodeFilterParamData(rapidjson::Document &doc
                 }
                 auto FilterStrategyArray = UserGroupListItem["FilterStrategyList"].GetArray();
                 rapidjson::SizeType FilterStrategyArraySize = FilterStrategyArray.Size();
+                if (FilterStrategyArraySize > FilterParamData::MaxFilterParamNum)
+                {
+                    LOG(ERROR) << "DecodeFilterParamData() Parse " << apiName
+                               << ", UserGroup List index = " << UserGroupListIdx
+                               << ", user_group = " << configItem.user_group
+                               << ", exp_id = " << exp_id
+                               << ", FilterStrategyList size = " << FilterStrategyArraySize
+                               << ", exceed limit = " << FilterParamData::MaxFilterParamNum;
+                    return FilterConfig::Error::DecodeFilterParamDataError;
+                }
                 configItem.vecFilterParams.resize(FilterStrategyArraySize);
                 for (rapidjson::SizeType FilterStrategyArrayIdx = 0; FilterStrategyArrayIdx < FilterStrategyArraySize; ++FilterStrategyArrayIdx)
                 {
@@ -60,6 +60,9 @@ private:
 
 struct FilterParamData
 {
+    // 单个用户组最多配置的过滤策略数, 请求内的过滤阶段使用定长数组, 超出的配置解析时拒绝
+    static constexpr int MaxFilterParamNum = 16;
+
     std::string user_group = ""; // 用户分组
 
     int KeepItemNum = 0;                      // 保持Item数量
@@ -85,10 +88,10 @@ public:
 public:
     bool UpdateJson(const std::string &jsonData);
 
-    const int MatchFilterExpID(const Common::APIType apiType, const std::vector<int> &vecExpIDList) const;
-    const FilterParamData *GetFilterParamData(const std::unordered_set<std::string> &userGroupList, Common::APIType apiType, int exp_id) const;
+    // 当前配置, 请求开始时经 ConfigSnapshot 取一次, 之后只读
+    inline std::shared_ptr<const FilterConfigData> GetConfigData() const { return std::atomic_load(&m_spData); }
 
-    FilterConfig(token) { m_dataIdx = 0; }
+    FilterConfig(token) : m_spData(std::make_shared<FilterConfigData>()) {}
     ~FilterConfig() {}
     FilterConfig(FilterConfig &) = delete;
     FilterConfig &operator=(const FilterConfig &) = delete;
@@ -96,11 +99,10 @@ public:
 protected:
     FilterConfig::Error DecodeJsonData(const std::string &jsonData);
 
-    FilterConfig::Error DecodeFilterParamData(rapidjson::Document &doc, int dataIdx);
+    FilterConfig::Error DecodeFilterParamData(rapidjson::Document &doc, FilterConfigData &data);
 
 private:
-    std::atomic<int> m_dataIdx = 0;
-    FilterConfigData m_data[2];
+    std::shared_ptr<const FilterConfigData> m_spData; // 当前配置, 通过 std::atomic_load/atomic_store 读写
 
     std::mutex m_update_lock; // 更新锁
 };
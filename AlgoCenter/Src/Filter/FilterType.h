@@ -12,4 +12,7 @@ namespace Common
     // 过滤策略 - 下载过滤
     static const std::string FilterType_Download = "Download";
 
+    // 过滤策略 - 近期曝光过滤
+    static const std::string FilterType_Exposure = "Exposure";
+
 }
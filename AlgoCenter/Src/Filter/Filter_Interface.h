@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <functional>
 
 #include "AlgoCenter/Define.h"
 #include "AlgoCenter/Config.h"
@@ -12,15 +13,18 @@
 #include "FilterConfig.h"
 #include "FilterType.h"
 
+// 过滤谓词, 返回 true 表示过滤掉该物料
+using FilterPredicate = std::function<bool(const ItemInfo &item_info)>;
+
 class Filter_Interface
 {
 public:
-    // CallStrategy 调用过滤策略接口
+    // InitPredicate 构造过滤谓词, 由 Filter 统一对各列表单次遍历执行
     // [in] requestData 请求数据
     // [in] filterParams 过滤参数
-    // [in/out] responseData 返回数据
-    virtual int CallStrategy(
+    // [out] predicate 过滤谓词, 本次请求无需过滤时保持为空
+    virtual int InitPredicate(
         const RequestData &requestData,
         const FilterParam &filterParams,
-        ResponseData &responseData) = 0;
+        FilterPredicate &predicate) = 0;
 };
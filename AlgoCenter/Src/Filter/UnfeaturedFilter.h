@@ -8,11 +8,11 @@ class UnfeaturedFilter
       public Filter_Interface
 {
 public:
-    // CallStrategy 调用过滤策略接口
-    virtual int CallStrategy(
+    // InitPredicate 构造过滤谓词
+    virtual int InitPredicate(
         const RequestData &requestData,
         const FilterParam &filterParams,
-        ResponseData &responseData) override;
+        FilterPredicate &predicate) override;
 
 public:
     UnfeaturedFilter(token) {}
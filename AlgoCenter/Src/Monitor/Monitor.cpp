@@ -0,0 +1,358 @@
+#include "Monitor.h"
+#include <unordered_map>
+#include "glog/logging.h"
+#include "prometheus/exposer.h"
+#include "prometheus/registry.h"
+#include "prometheus/collectable.h"
+#include "prometheus/counter.h"
+#include "prometheus/histogram.h"
+#include "prometheus/family.h"
+
+// 耗时分桶(毫秒)
+static const prometheus::Histogram::BucketBoundaries s_LatencyBuckets = {
+    1, 2, 5, 10, 20, 30, 50, 75, 100, 150, 200, 300, 500, 1000};
+
+// 拉取型指标, 采集时调用回调取值
+class PullCollector : public prometheus::Collectable
+{
+public:
+    struct PullMetric
+    {
+        std::map<std::string, std::string> labels;
+        std::function<double()> callback;
+    };
+
+    struct PullFamily
+    {
+        std::string help;
+        Monitor::PullType type = Monitor::PullType::Gauge;
+        std::vector<PullMetric> vecMetric;
+        std::function<std::vector<Monitor::PullSample>()> familyCallback;
+    };
+
+    void Register(
+        const std::string &name,
+        const std::string &help,
+        const Monitor::PullType type,
+        const std::map<std::string, std::string> &labels,
+        std::function<double()> callback)
+    {
+        std::lock_guard<std::mutex> lg(m_Mutex);
+        auto iter = m_mapFamily.find(name);
+        if (iter == m_mapFamily.end())
+        {
+            iter = m_mapFamily.emplace(name, PullFamily()).first;
+            iter->second.help = help;
+            iter->second.type = type;
+        }
+        iter->second.vecMetric.push_back({labels, std::move(callback)});
+    }
+
+    void RegisterFamily(
+        const std::string &name,
+        const std::string &help,
+        const Monitor::PullType type,
+        std::function<std::vector<Monitor::PullSample>()> callback)
+    {
+        std::lock_guard<std::mutex> lg(m_Mutex);
+        auto &pullFamily = m_mapFamily[name];
+        pullFamily.help = help;
+        pullFamily.type = type;
+        pullFamily.familyCallback = std::move(callback);
+    }
+
+    std::vector<prometheus::MetricFamily> Collect() const override
+    {
+        std::lock_guard<std::mutex> lg(m_Mutex);
+
+        std::vector<prometheus::MetricFamily> vecFamily;
+        vecFamily.reserve(m_mapFamily.size());
+        for (const auto &name_family : m_mapFamily)
+        {
+            const auto &pullFamily = name_family.second;
+
+            auto &family = vecFamily.emplace_back();
+            family.name = name_family.first;
+            family.help = pullFamily.help;
+            family.type = (pullFamily.type == Monitor::PullType::Counter)
+                              ? prometheus::MetricType::Counter
+                              : prometheus::MetricType::Gauge;
+            family.metric.reserve(pullFamily.vecMetric.size());
+            for (const auto &pullMetric : pullFamily.vecMetric)
+            {
+                auto &metric = family.metric.emplace_back();
+                for (const auto &label : pullMetric.labels)
+                {
+                    metric.label.push_back({label.first, label.second});
+                }
+
+                SetValue(pullFamily.type, pullMetric.callback(), metric);
+            }
+
+            if (pullFamily.familyCallback)
+            {
+                for (const auto &sample : pullFamily.familyCallback())
+                {
+                    auto &metric = family.metric.emplace_back();
+                    for (const auto &label : sample.labels)
+                    {
+                        metric.label.push_back({label.first, label.second});
+                    }
+                    SetValue(pullFamily.type, sample.value, metric);
+                }
+            }
+        }
+        return vecFamily;
+    }
+
+private:
+    static void SetValue(Monitor::PullType type, double value, prometheus::ClientMetric &metric)
+    {
+        if (type == Monitor::PullType::Counter)
+        {
+            metric.counter.value = value;
+        }
+        else
+        {
+            metric.gauge.value = value;
+        }
+    }
+
+private:
+    mutable std::mutex m_Mutex;
+    std::map<std::string, PullFamily> m_mapFamily;
+};
+
+Monitor::Monitor(token)
+{
+}
+
+Monitor::~Monitor()
+{
+}
+
+bool Monitor::Init(const std::string &bind_addr)
+{
+    try
+    {
+        m_upExposer = std::make_unique<prometheus::Exposer>(bind_addr);
+    }
+    catch (const std::exception &e)
+    {
+        LOG(ERROR) << "Monitor::Init() create exposer failed"
+                   << ", bind_addr = " << bind_addr
+                   << ", err = " << e.what();
+        return false;
+    }
+
+    m_spRegistry = std::make_shared<prometheus::Registry>();
+    m_spPullCollector = std::make_shared<PullCollector>();
+    m_spStatisCollector = std::make_shared<PullCollector>();
+
+    m_pStageLatency = &prometheus::BuildHistogram()
+                           .Name("algocenter_stage_latency_ms")
+                           .Help("GetRecommendItem stage latency in milliseconds")
+                           .Register(*m_spRegistry);
+    m_pChannelLatency = &prometheus::BuildHistogram()
+                             .Name("algocenter_recall_channel_latency_ms")
+                             .Help("Recall channel latency in milliseconds")
+                             .Register(*m_spRegistry);
+    m_pChannelRequest = &prometheus::BuildCounter()
+                             .Name("algocenter_recall_channel_total")
+                             .Help("Recall channel calls by result")
+                             .Register(*m_spRegistry);
+    m_pChannelItems = &prometheus::BuildCounter()
+                           .Name("algocenter_recall_channel_items_total")
+                           .Help("Items returned by recall channel")
+                           .Register(*m_spRegistry);
+    m_pFilterDrop = &prometheus::BuildCounter()
+                         .Name("algocenter_filter_drop_items_total")
+                         .Help("Items dropped by filter strategy")
+                         .Register(*m_spRegistry);
+
+    m_upExposer->RegisterCollectable(m_spRegistry);
+    m_upExposer->RegisterCollectable(m_spPullCollector);
+    m_upExposer->RegisterCollectable(m_spStatisCollector, "/statis");
+    g_Init = true;
+
+    LOG(INFO) << "Monitor::Init() succ, bind_addr = " << bind_addr;
+    return true;
+}
+
+void Monitor::ShutDown()
+{
+    if (g_Init)
+    {
+        g_Init = false;
+        m_upExposer = nullptr;
+        LOG(INFO) << "Monitor::ShutDown() exposer stopped.";
+    }
+}
+
+// 指标句柄线程局部缓存, 按标签取值拼接的键查找, 只在首次出现时调用 Family::Add
+// 指标族内的指标不会删除, 句柄在进程内一直有效
+struct StageHandle
+{
+    std::vector<std::pair<std::string, prometheus::Histogram *>> vecStage; // 阶段名 -> 耗时直方图
+};
+
+struct ChannelHandle
+{
+    std::vector<std::pair<std::string, prometheus::Counter *>> vecResult; // 调用结果 -> 调用次数
+    prometheus::Histogram *pLatency = nullptr;
+    prometheus::Counter *pItems = nullptr;
+};
+
+static thread_local std::string t_HandleKey;
+static thread_local std::unordered_map<std::string, StageHandle> t_mapStageHandle;
+static thread_local std::unordered_map<std::string, ChannelHandle> t_mapChannelHandle;
+static thread_local std::unordered_map<std::string, prometheus::Counter *> t_mapFilterHandle;
+
+static inline void AppendLabel(std::string &key, const std::string &value)
+{
+    key.append(value);
+    key.push_back('\x1f');
+}
+
+template <typename T>
+static inline T *FindHandle(const std::vector<std::pair<std::string, T *>> &vecHandle, const std::string &name)
+{
+    for (const auto &name_handle : vecHandle)
+    {
+        if (name_handle.first == name)
+        {
+            return name_handle.second;
+        }
+    }
+    return nullptr;
+}
+
+void Monitor::ObserveStage(
+    const RequestLabel &label,
+    const std::vector<std::pair<std::string, double>> &vecStageCost)
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    auto &key = t_HandleKey;
+    key.clear();
+    AppendLabel(key, label.api);
+    AppendLabel(key, label.recall_exp);
+    AppendLabel(key, label.filter_exp);
+    AppendLabel(key, label.display_exp);
+    AppendLabel(key, label.user_group);
+
+    auto &handle = t_mapStageHandle[key];
+    for (const auto &stage_cost : vecStageCost)
+    {
+        auto pHistogram = FindHandle(handle.vecStage, stage_cost.first);
+        if (pHistogram == nullptr)
+        {
+            pHistogram = &m_pStageLatency->Add(
+                {
+                    {"api", label.api},
+                    {"recall_exp", label.recall_exp},
+                    {"filter_exp", label.filter_exp},
+                    {"display_exp", label.display_exp},
+                    {"user_group", label.user_group},
+                    {"stage", stage_cost.first},
+                },
+                s_LatencyBuckets);
+            handle.vecStage.emplace_back(stage_cost.first, pHistogram);
+        }
+        pHistogram->Observe(stage_cost.second);
+    }
+}
+
+void Monitor::ObserveRecallChannel(
+    const std::string &api,
+    const std::string &channel,
+    const std::string &result,
+    const long item_num,
+    const double cost_ms)
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    auto &key = t_HandleKey;
+    key.clear();
+    AppendLabel(key, api);
+    AppendLabel(key, channel);
+
+    auto &handle = t_mapChannelHandle[key];
+    auto pRequest = FindHandle(handle.vecResult, result);
+    if (pRequest == nullptr)
+    {
+        pRequest = &m_pChannelRequest->Add({{"api", api}, {"channel", channel}, {"result", result}});
+        handle.vecResult.emplace_back(result, pRequest);
+    }
+    pRequest->Increment();
+    if (result == "skip")
+    {
+        return;
+    }
+
+    if (handle.pLatency == nullptr)
+    {
+        handle.pLatency = &m_pChannelLatency->Add({{"api", api}, {"channel", channel}}, s_LatencyBuckets);
+        handle.pItems = &m_pChannelItems->Add({{"api", api}, {"channel", channel}});
+    }
+    handle.pLatency->Observe(cost_ms);
+    handle.pItems->Increment(item_num);
+}
+
+void Monitor::ObserveFilterDrop(
+    const std::string &api,
+    const std::string &filter_type,
+    const long drop_num)
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    auto &key = t_HandleKey;
+    key.clear();
+    AppendLabel(key, api);
+    AppendLabel(key, filter_type);
+
+    auto &pDrop = t_mapFilterHandle[key];
+    if (pDrop == nullptr)
+    {
+        pDrop = &m_pFilterDrop->Add({{"api", api}, {"filter_type", filter_type}});
+    }
+    pDrop->Increment(drop_num);
+}
+
+void Monitor::RegisterPull(
+    const std::string &name,
+    const std::string &help,
+    const PullType type,
+    const std::map<std::string, std::string> &labels,
+    std::function<double()> callback)
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    m_spPullCollector->Register(name, help, type, labels, std::move(callback));
+}
+
+void Monitor::RegisterStatisFamily(
+    const std::string &name,
+    const std::string &help,
+    const PullType type,
+    std::function<std::vector<PullSample>()> callback)
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    m_spStatisCollector->RegisterFamily(name, help, type, std::move(callback));
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <functional>
+#include "Common/Singleton.h"
+
+namespace prometheus
+{
+    class Exposer;
+    class Registry;
+    class Histogram;
+    class Counter;
+    template <typename T>
+    class Family;
+}
+
+class PullCollector;
+
+// Prometheus 指标, 通过本地 HTTP 端口 /metrics 暴露
+// 1. 推送型: 请求线程直接观测, 阶段耗时、召回渠道与过滤策略
+// 2. 拉取型: 采集时回调读取各模块的累计计数, 缓存命中等
+class Monitor : public Singleton<Monitor>
+{
+public:
+    // 请求维度标签
+    struct RequestLabel
+    {
+        std::string api;
+        std::string recall_exp;
+        std::string filter_exp;
+        std::string display_exp;
+        std::string user_group;
+    };
+
+    // 拉取型指标类型
+    enum class PullType
+    {
+        Counter = 0,
+        Gauge = 1,
+    };
+
+    // 拉取型指标样本, 标签集合在采集时生成
+    struct PullSample
+    {
+        std::map<std::string, std::string> labels;
+        double value = 0.0;
+    };
+
+public:
+    // 初始化
+    // [in] bind_addr 监听地址, 如 0.0.0.0:9464
+    bool Init(const std::string &bind_addr);
+
+    void ShutDown();
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 记录请求各阶段耗时(毫秒), stage 为阶段名
+    void ObserveStage(
+        const RequestLabel &label,
+        const std::vector<std::pair<std::string, double>> &vecStageCost);
+
+    // 记录单个召回渠道
+    // [in] result ok / fail / skip
+    void ObserveRecallChannel(
+        const std::string &api,
+        const std::string &channel,
+        const std::string &result,
+        const long item_num,
+        const double cost_ms);
+
+    // 记录单个过滤策略过滤掉的物料数
+    // [in] filter_type 过滤策略类型
+    void ObserveFilterDrop(
+        const std::string &api,
+        const std::string &filter_type,
+        const long drop_num);
+
+    // 注册拉取型指标, 同名指标的 help 与 type 以首次注册为准
+    void RegisterPull(
+        const std::string &name,
+        const std::string &help,
+        const PullType type,
+        const std::map<std::string, std::string> &labels,
+        std::function<double()> callback);
+
+    // 注册拉取型指标族, 采集时由回调生成全部样本, 通过 /statis 暴露, 不进入常规采集
+    void RegisterStatisFamily(
+        const std::string &name,
+        const std::string &help,
+        const PullType type,
+        std::function<std::vector<PullSample>()> callback);
+
+private:
+    std::atomic<bool> g_Init = false;
+
+    std::unique_ptr<prometheus::Exposer> m_upExposer;
+    std::shared_ptr<prometheus::Registry> m_spRegistry;
+    std::shared_ptr<PullCollector> m_spPullCollector;
+    std::shared_ptr<PullCollector> m_spStatisCollector;
+
+    prometheus::Family<prometheus::Histogram> *m_pStageLatency = nullptr;
+    prometheus::Family<prometheus::Histogram> *m_pChannelLatency = nullptr;
+    prometheus::Family<prometheus::Counter> *m_pChannelRequest = nullptr;
+    prometheus::Family<prometheus::Counter> *m_pChannelItems = nullptr;
+    prometheus::Family<prometheus::Counter> *m_pFilterDrop = nullptr;
+
+public:
+    Monitor(token);
+    ~Monitor();
+    Monitor(Monitor &) = delete;
+    Monitor &operator=(const Monitor &) = delete;
+};
@@ -1,6 +1,7 @@
 #include "AnnoyIndexCache.h"
 #include <future>
 #include <chrono>
+#include <algorithm>
 #include "Eigen/Dense"
 #include "glog/logging.h"
 #include "TDRedis/TDRedis.h"
@@ -8,6 +9,7 @@
 #include "Common/Function.h"
 #include "Protobuf/other/annoy_file_data.pb.h"
 #include "Protobuf/other/local_file.pb.h"
+#include "Trace/Tracer.h"
 
 #include "AlgoCenter/Define.h"
 #include "AlgoCenter/Config.h"
@@ -15,12 +17,14 @@
 bool AnnoyIndexCache::Init(
     const std::string &basic_path,
     const size_t emb_dimension,
-    const int search_node_num)
+    const int search_node_num,
+    const bool index_vector_switch)
 {
     m_BasicPath = basic_path;
     m_EmbDimension = emb_dimension;
     m_SearchNodeNum = search_node_num;
-    if (m_BasicPath.empty() || m_SearchNodeNum <= 0 || m_SearchNodeNum <= 0)
+    m_IndexVectorSwitch = index_vector_switch;
+    if (m_BasicPath.empty() || m_EmbDimension <= 0 || m_SearchNodeNum <= 0)
     {
         LOG(ERROR) << "Init() param error"
                    << ", basic_path = " << basic_path
@@ -73,6 +77,8 @@ int32_t AnnoyIndexCache::AnnoyRetrieval(
     std::vector<std::string> &vec_near_items,
     std::vector<float> &vec_distances) const
 {
+    TraceSpan annoySpan("AnnoyRetrieval", slice);
+
     AnnoyIndexData slice_data;
     if (!m_CacheDataPtr->GetDBufData(slice, slice_data))
     {
@@ -82,85 +88,156 @@ int32_t AnnoyIndexCache::AnnoyRetrieval(
 
     if (slice_data.spAnnoyIndex == nullptr ||
         slice_data.spItemDict == nullptr ||
-        slice_data.spItemVector == nullptr ||
+        (slice_data.spItemVector == nullptr && slice_data.spItemPos == nullptr) ||
         slice_data.spKeynameVector == nullptr)
     {
         LOG(ERROR) << "AnnoyRetrieval() slice data not init, slice = " << slice;
         return Common::Error::Recall_Annoy_NotInit;
     }
 
+    std::vector<float> query_vector;
+    if (!GetQueryVector(slice_data, item_key, vec_keynames, query_vector))
+    {
+        LOG(WARNING) << "AnnoyRetrieval() item vector not find, and keynames mean vector not generated.";
+        return Common::Error::OK;
+    }
+
     std::vector<int> vec_cache_dict;
     vec_cache_dict.reserve(top_k);
 
     std::vector<float> vec_cache_distances;
     vec_cache_distances.reserve(top_k);
 
-    auto item_iter = slice_data.spItemVector->find(item_key);
-    if (item_iter != slice_data.spItemVector->end())
+    slice_data.spAnnoyIndex->get_nns_by_vector(
+        query_vector.data(), top_k, slice_data.iSearchNodeNum, &vec_cache_dict, &vec_cache_distances);
+
+    vec_near_items.reserve(top_k);
+    vec_distances.reserve(top_k);
+    size_t result_num = std::min(vec_cache_dict.size(), vec_cache_distances.size());
+    for (size_t idx = 0; idx < result_num; idx++)
     {
-        if (item_iter->second.size() != slice_data.iEmbDimension)
+        int item_dict = vec_cache_dict[idx];
+        auto iter = slice_data.spItemDict->find(item_dict);
+        if (iter == slice_data.spItemDict->end())
         {
-            LOG(ERROR) << "AnnoyRetrieval() slice data not init, slice = " << slice;
-            return Common::Error::Recall_Annoy_NotInit;
+            LOG(WARNING) << "AnnoyRetrieval() annoy dict find error, item_dict = " << item_dict;
         }
+        else
+        {
+            vec_near_items.push_back(iter->second);
+            vec_distances.push_back(vec_cache_distances[idx]);
+        }
+    }
 
-        slice_data.spAnnoyIndex->get_nns_by_vector(
-            item_iter->second.data(), top_k, slice_data.iSearchNodeNum, &vec_cache_dict, &vec_cache_distances);
+    return Common::Error::OK;
+}
+
+bool AnnoyIndexCache::GetQueryVector(
+    const AnnoyIndexData &slice_data,
+    const std::string &item_key,
+    const std::vector<std::string> &vec_keynames,
+    std::vector<float> &query_vector) const
+{
+    // 1. 优先使用物料自身向量
+    if (slice_data.spItemPos != nullptr)
+    {
+        // 不保留浮点副本, 从 Annoy 索引中取原始向量
+        auto pos_iter = slice_data.spItemPos->find(item_key);
+        if (pos_iter != slice_data.spItemPos->end())
+        {
+            query_vector.resize(slice_data.iEmbDimension);
+            slice_data.spAnnoyIndex->get_item(pos_iter->second, query_vector.data());
+            m_QueryHitCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
     }
     else
     {
-        std::vector<std::vector<float>> vec_keynames_vector;
-        vec_keynames_vector.reserve(vec_keynames.size());
-        for (const auto &keyname : vec_keynames)
+        auto item_iter = slice_data.spItemVector->find(item_key);
+        if (item_iter != slice_data.spItemVector->end() &&
+            item_iter->second.size() == slice_data.iEmbDimension)
         {
-            auto keyname_iter = slice_data.spKeynameVector->find(keyname);
-            if (keyname_iter != slice_data.spItemVector->end())
-            {
-                if (keyname_iter->second.size() == slice_data.iEmbDimension)
-                {
-                    vec_keynames_vector.push_back(keyname_iter->second);
-                }
-            }
+            query_vector = item_iter->second;
+            m_QueryHitCount.fetch_add(1, std::memory_order_relaxed);
+            return true;
         }
+    }
 
-        size_t keynames_vector_size = vec_keynames_vector.size();
-        if (keynames_vector_size == 0)
+    // 2. 物料向量不存在时, 使用关键词向量均值
+    m_QueryMissCount.fetch_add(1, std::memory_order_relaxed);
+    std::vector<const std::vector<float> *> vec_keynames_vector;
+    vec_keynames_vector.reserve(vec_keynames.size());
+    for (const auto &keyname : vec_keynames)
+    {
+        auto keyname_iter = slice_data.spKeynameVector->find(keyname);
+        if (keyname_iter != slice_data.spKeynameVector->end())
         {
-            LOG(WARNING) << "AnnoyRetrieval() item vector not find, and keynames mean vector not generated.";
-            return Common::Error::OK;
+            if (keyname_iter->second.size() == slice_data.iEmbDimension)
+            {
+                vec_keynames_vector.push_back(&keyname_iter->second);
+            }
         }
+    }
 
-        Eigen::MatrixXf matrix_xf(keynames_vector_size, slice_data.iEmbDimension);
-        for (size_t idx = 0; idx < keynames_vector_size; idx++)
-        {
-            matrix_xf.row(idx) =
-                Eigen::Map<Eigen::RowVectorXf>(vec_keynames_vector[idx].data(), 1, vec_keynames_vector[idx].size());
-        }
+    size_t keynames_vector_size = vec_keynames_vector.size();
+    if (keynames_vector_size == 0)
+    {
+        return false;
+    }
 
-        Eigen::MatrixXf mean_vector = matrix_xf.colwise().mean();
-        slice_data.spAnnoyIndex->get_nns_by_vector(
-            mean_vector.data(), top_k, slice_data.iSearchNodeNum, &vec_cache_dict, &vec_cache_distances);
+    Eigen::MatrixXf matrix_xf(keynames_vector_size, slice_data.iEmbDimension);
+    for (size_t idx = 0; idx < keynames_vector_size; idx++)
+    {
+        matrix_xf.row(idx) =
+            Eigen::Map<const Eigen::RowVectorXf>(vec_keynames_vector[idx]->data(), 1, vec_keynames_vector[idx]->size());
     }
 
-    vec_near_items.reserve(top_k);
-    vec_distances.reserve(top_k);
-    size_t result_num = std::min(vec_cache_dict.size(), vec_cache_distances.size());
-    for (size_t idx = 0; idx < result_num; idx++)
+    Eigen::RowVectorXf mean_vector = matrix_xf.colwise().mean();
+    query_vector.assign(mean_vector.data(), mean_vector.data() + mean_vector.size());
+    return true;
+}
+
+bool AnnoyIndexCache::BuildItemPos(
+    const AnnoyIndexData &slice_data,
+    const RSP_LocalFileData::FileData &file_data,
+    std::unordered_map<std::string, int> &item_pos) const
+{
+    const size_t dimension = slice_data.iEmbDimension;
+    const int item_num = slice_data.spAnnoyIndex->get_n_items();
+    item_pos.reserve(file_data.protos_size());
+
+    for (const auto &proto_data : file_data.protos())
     {
-        int item_dict = vec_cache_dict[idx];
-        auto iter = slice_data.spItemDict->find(item_dict);
-        if (iter == slice_data.spItemDict->end())
+        RSP_AnnoyFileData::AnnoyItemVector aiv;
+        if (!aiv.ParseFromString(proto_data))
         {
-            LOG(WARNING) << "AnnoyRetrieval() annoy dict find error, item_dict = " << item_dict;
+            LOG(ERROR) << "BuildItemPos() AnnoyItemVector ParseFromString failed.";
+            continue;
         }
-        else
+
+        if (static_cast<size_t>(aiv.vector_data_size()) != dimension)
         {
-            vec_near_items.push_back(iter->second);
-            vec_distances.push_back(vec_cache_distances[idx]);
+            LOG(WARNING) << "BuildItemPos() emb dimension error"
+                         << ", aiv_vector_size = " << aiv.vector_data_size()
+                         << ", iEmbDimension = " << dimension;
+            continue;
         }
+
+        if (aiv.item_pos() < 0 || aiv.item_pos() >= item_num)
+        {
+            LOG(WARNING) << "BuildItemPos() item pos out of range"
+                         << ", item_pos = " << aiv.item_pos()
+                         << ", item_num = " << item_num;
+            continue;
+        }
+
+        std::string item_key = std::to_string(aiv.item_id()) + "_" + std::to_string(aiv.res_type());
+        auto &ItemDict = *slice_data.spItemDict.get();
+        ItemDict[aiv.item_pos()] = item_key;
+        item_pos[item_key] = aiv.item_pos();
     }
 
-    return Common::Error::OK;
+    return !item_pos.empty();
 }
 
 int32_t AnnoyIndexCache::Refresh()
@@ -242,7 +319,6 @@ int32_t AnnoyIndexCache::Refresh()
             }
 
             slice_data.spItemDict = std::make_shared<std::unordered_map<int, std::string>>();
-            slice_data.spItemVector = std::make_shared<std::unordered_map<std::string, std::vector<float>>>();
 
             RSP_LocalFileData::FileData file_data;
             if (!file_data.ParseFromString(item_vector_buffer))
@@ -251,43 +327,59 @@ int32_t AnnoyIndexCache::Refresh()
                 continue;
             }
 
-            const auto &file_data_protos = file_data.protos();
-            for (const auto &proto_data : file_data_protos)
+            if (m_IndexVectorSwitch)
             {
-                RSP_AnnoyFileData::AnnoyItemVector aiv;
-                if (!aiv.ParseFromString(proto_data))
+                // 只保留 item_key -> item_pos, 浮点向量从 Annoy 索引读取
+                slice_data.spItemPos = std::make_shared<std::unordered_map<std::string, int>>();
+                if (!BuildItemPos(slice_data, file_data, *slice_data.spItemPos.get()))
                 {
-                    LOG(ERROR) << "Refresh() AnnoyItemVector ParseFromString failed.";
+                    LOG(ERROR) << "Refresh() item pos is empty, item_vector_path = " << item_vector_path;
                     continue;
                 }
+            }
+            else
+            {
+                slice_data.spItemVector = std::make_shared<std::unordered_map<std::string, std::vector<float>>>();
 
-                const auto &aiv_vector_data = aiv.vector_data();
-                size_t aiv_vector_size = aiv_vector_data.size();
-                if (aiv_vector_size != slice_data.iEmbDimension)
-                {
-                    LOG(WARNING) << "Refresh() emb dimension error"
-                                 << ", item_vector_path = " << item_vector_path
-                                 << ", aiv_vector_size = " << aiv_vector_size
-                                 << ", iEmbDimension = " << slice_data.iEmbDimension;
-                    continue;
-                }
-
-                std::string item_key = std::to_string(aiv.item_id()) + "_" + std::to_string(aiv.res_type());
-
-                auto &ItemDict = *slice_data.spItemDict.get();
-                ItemDict[aiv.item_pos()] = item_key;
-
-                auto &ItemVector = *slice_data.spItemVector.get();
-                auto &vec_vector = ItemVector[item_key];
-
-                vec_vector.reserve(aiv_vector_size);
-                for (const auto &vector_data : aiv_vector_data)
+                const auto &file_data_protos = file_data.protos();
+                for (const auto &proto_data : file_data_protos)
                 {
-                    vec_vector.push_back(vector_data);
+                    RSP_AnnoyFileData::AnnoyItemVector aiv;
+                    if (!aiv.ParseFromString(proto_data))
+                    {
+                        LOG(ERROR) << "Refresh() AnnoyItemVector ParseFromString failed.";
+                        continue;
+                    }
+
+                    const auto &aiv_vector_data = aiv.vector_data();
+                    size_t aiv_vector_size = aiv_vector_data.size();
+                    if (aiv_vector_size != slice_data.iEmbDimension)
+                    {
+                        LOG(WARNING) << "Refresh() emb dimension error"
+                                     << ", item_vector_path = " << item_vector_path
+                                     << ", aiv_vector_size = " << aiv_vector_size
+                                     << ", iEmbDimension = " << slice_data.iEmbDimension;
+                        continue;
+                    }
+
+                    std::string item_key = std::to_string(aiv.item_id()) + "_" + std::to_string(aiv.res_type());
+
+                    auto &ItemDict = *slice_data.spItemDict.get();
+                    ItemDict[aiv.item_pos()] = item_key;
+
+                    auto &ItemVector = *slice_data.spItemVector.get();
+                    auto &vec_vector = ItemVector[item_key];
+
+                    vec_vector.reserve(aiv_vector_size);
+                    for (const auto &vector_data : aiv_vector_data)
+                    {
+                        vec_vector.push_back(vector_data);
+                    }
                 }
             }
 
-            if (slice_data.spItemDict->empty() || slice_data.spItemVector->empty())
+            if (slice_data.spItemDict->empty() ||
+                (slice_data.spItemVector != nullptr && slice_data.spItemVector->empty()))
             {
                 LOG(ERROR) << "Refresh() item vector is empty.";
                 continue;
@@ -350,6 +442,41 @@ int32_t AnnoyIndexCache::Refresh()
             }
         }
 
+        // 分片内存统计
+        {
+            size_t item_num = slice_data.spItemDict->size();
+            size_t item_vector_bytes = slice_data.spItemVector != nullptr
+                                           ? item_num * slice_data.iEmbDimension * sizeof(float)
+                                           : 0;
+            size_t keyname_vector_bytes = slice_data.spKeynameVector->size() * slice_data.iEmbDimension * sizeof(float);
+
+            // 物料位置表: 哈希节点(键值对 + next 指针 + 缓存的哈希值) + 桶数组 + 堆上分配的键字符串
+            size_t item_pos_bytes = 0;
+            if (slice_data.spItemPos != nullptr)
+            {
+                const auto &item_pos = *slice_data.spItemPos.get();
+                item_pos_bytes = item_pos.size() * (sizeof(std::pair<const std::string, int>) + sizeof(void *) + sizeof(size_t)) +
+                                 item_pos.bucket_count() * sizeof(void *);
+                for (const auto &key_pos : item_pos)
+                {
+                    const char *key_data = key_pos.first.data();
+                    const char *key_object = reinterpret_cast<const char *>(&key_pos.first);
+                    if (key_data < key_object || key_data >= key_object + sizeof(std::string))
+                    {
+                        item_pos_bytes += key_pos.first.capacity() + 1;
+                    }
+                }
+            }
+
+            LOG(INFO) << "Refresh() slice memory report"
+                      << ", slice = " << slice
+                      << ", item_num = " << item_num
+                      << ", index_vector = " << (slice_data.spItemPos != nullptr)
+                      << ", item_vector_bytes = " << item_vector_bytes
+                      << ", item_pos_bytes = " << item_pos_bytes
+                      << ", keyname_vector_bytes = " << keyname_vector_bytes;
+        }
+
         data[slice] = std::move(slice_data);
     }
 
@@ -11,6 +11,7 @@
 #include "Common/Singleton.h"
 
 #include "Protobuf/other/annoy_file_data.pb.h"
+#include "Protobuf/other/local_file.pb.h"
 
 using namespace Annoy;
 
@@ -20,6 +21,9 @@ class AnnoyIndexCache : public Singleton<AnnoyIndexCache>
     using ItemDictPtr = std::shared_ptr<std::unordered_map<int, std::string>>;
     using ItemVectorPtr = std::shared_ptr<std::unordered_map<std::string, std::vector<float>>>;
     using KeynameVectorPtr = std::shared_ptr<std::unordered_map<std::string, std::vector<float>>>;
+
+    using ItemPosPtr = std::shared_ptr<std::unordered_map<std::string, int>>;
+
     struct AnnoyIndexData
     {
         size_t iEmbDimension;
@@ -27,7 +31,8 @@ class AnnoyIndexCache : public Singleton<AnnoyIndexCache>
 
         AnnoyIndexPtr spAnnoyIndex;
         ItemDictPtr spItemDict;
-        ItemVectorPtr spItemVector;
+        ItemVectorPtr spItemVector; // 未开启 IndexVectorSwitch 时使用
+        ItemPosPtr spItemPos;       // 开启 IndexVectorSwitch 时使用, 替代 spItemVector, 向量从 Annoy 索引读取
         KeynameVectorPtr spKeynameVector;
     };
 
@@ -88,7 +93,8 @@ public:
     bool Init(
         const std::string &basic_path,
         const size_t emb_dimension,
-        const int search_node_num);
+        const int search_node_num,
+        const bool index_vector_switch);
 
     void ShutDown();
 
@@ -102,6 +108,21 @@ public:
 
     int32_t Refresh();
 
+    inline long GetQueryHitCount() const noexcept { return m_QueryHitCount.load(std::memory_order_relaxed); }
+    inline long GetQueryMissCount() const noexcept { return m_QueryMissCount.load(std::memory_order_relaxed); }
+
+private:
+    bool GetQueryVector(
+        const AnnoyIndexData &slice_data,
+        const std::string &item_key,
+        const std::vector<std::string> &vec_keynames,
+        std::vector<float> &query_vector) const;
+
+    bool BuildItemPos(
+        const AnnoyIndexData &slice_data,
+        const RSP_LocalFileData::FileData &file_data,
+        std::unordered_map<std::string, int> &item_pos) const;
+
 private:
     bool GetLatestVersion(
         const std::string &basic_path,
@@ -123,5 +144,11 @@ private:
     size_t m_EmbDimension = 0;
     int m_SearchNodeNum = 0;
 
+    bool m_IndexVectorSwitch = false; // 物料向量从 Annoy 索引读取, 不保留浮点副本
+
     std::shared_ptr<CacheData> m_CacheDataPtr;
+
+    // 查询向量命中统计: 命中为使用物料自身向量, 未命中为关键词均值或无向量
+    mutable std::atomic<long> m_QueryHitCount = 0;
+    mutable std::atomic<long> m_QueryMissCount = 0;
 };
@@ -0,0 +1,105 @@
+#pragma once
+#include <limits>
+#include <vector>
+#include <cstdint>
+
+// 物料ID去重集合, 开放寻址线性探测, 用于召回融合
+// 按预期数量一次性分配, 负载超过 1/2 时扩容
+class ItemIdSet
+{
+public:
+    explicit ItemIdSet(std::size_t expectNum = 0)
+    {
+        Reserve(expectNum);
+    }
+
+    // 预分配槽位, 容量为 2 的幂且不小于 2 * expectNum
+    void Reserve(std::size_t expectNum)
+    {
+        std::size_t capacity = 16;
+        while (capacity < expectNum * 2)
+        {
+            capacity <<= 1;
+        }
+        if (capacity <= vecSlot.size())
+        {
+            return;
+        }
+
+        std::vector<long> oldSlot = std::move(vecSlot);
+        vecSlot.assign(capacity, EmptySlot);
+        mask = capacity - 1;
+        num = 0;
+        for (const long item_id : oldSlot)
+        {
+            if (item_id != EmptySlot)
+            {
+                Insert(item_id);
+            }
+        }
+    }
+
+    // 插入, 新插入返回 true, 已存在返回 false
+    inline bool Insert(long item_id)
+    {
+        if ((num + 1) * 2 > vecSlot.size())
+        {
+            Reserve(vecSlot.size());
+        }
+
+        std::size_t pos = Hash(item_id) & mask;
+        while (true)
+        {
+            long slot = vecSlot[pos];
+            if (slot == item_id)
+            {
+                return false;
+            }
+            if (slot == EmptySlot)
+            {
+                vecSlot[pos] = item_id;
+                ++num;
+                return true;
+            }
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    inline bool Contains(long item_id) const
+    {
+        std::size_t pos = Hash(item_id) & mask;
+        while (true)
+        {
+            long slot = vecSlot[pos];
+            if (slot == item_id)
+            {
+                return true;
+            }
+            if (slot == EmptySlot)
+            {
+                return false;
+            }
+            pos = (pos + 1) & mask;
+        }
+    }
+
+    inline std::size_t size() const noexcept { return num; }
+
+private:
+    // 空槽标记, 物料ID不会取到该值
+    static constexpr long EmptySlot = std::numeric_limits<long>::min();
+
+    static inline std::size_t Hash(long item_id) noexcept
+    {
+        uint64_t h = static_cast<uint64_t>(item_id);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+
+private:
+    std::vector<long> vecSlot;
+    std::size_t mask = 0;
+    std::size_t num = 0;
+};
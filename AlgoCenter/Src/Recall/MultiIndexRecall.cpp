@@ -1,5 +1,6 @@
 #include "MultiIndexRecall.h"
 #include "glog/logging.h"
+#include "Replay/RequestRandom.h"
 
 int MultiIndexRecall::RecallItem(
     const RequestData &requestData,
@@ -134,7 +135,6 @@ int MultiIndexRecall::RecallItem(
         auto &item_info = resultRecallData[result_idx++];
         item_info.item_id = atol(item_key.substr(0, item_key.find_first_of("_")).c_str());
         item_info.res_type = atoi(item_key.substr(item_key.find_first_of("_") + 1).c_str());
-        item_info.recall_type = recallType;
         item_info.recall_type_id = recallTypeId;
 
         if (!recallInfo.str().empty())
@@ -144,9 +144,7 @@ int MultiIndexRecall::RecallItem(
         recallInfo << item_key;
     }
 
-    unsigned random_seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::shuffle(resultRecallData.begin(), resultRecallData.end(),
-                 std::default_random_engine(random_seed));
+    std::shuffle(resultRecallData.begin(), resultRecallData.end(), RequestRandom::Engine());
 
     double end_time = Common::get_ms_time();
     if (requestData.is_statis_log)
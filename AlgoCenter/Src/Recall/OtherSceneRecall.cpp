@@ -1,5 +1,6 @@
 #include "OtherSceneRecall.h"
 #include "glog/logging.h"
+#include "Replay/RequestRandom.h"
 
 #include "AnnoyRecall/AnnoyIndexCache.h"
 
@@ -77,7 +78,6 @@ int OtherSceneRecall::RecallItem(
         auto &item_info = resultRecallData[result_idx++];
         item_info.item_id = atol(item_key.substr(0, item_key.find_first_of("_")).c_str());
         item_info.res_type = atoi(item_key.substr(item_key.find_first_of("_") + 1).c_str());
-        item_info.recall_type = recallType;
         item_info.recall_type_id = recallTypeId;
 
         if (!recallInfo.str().empty())
@@ -87,9 +87,7 @@ int OtherSceneRecall::RecallItem(
         recallInfo << item_key;
     }
 
-    unsigned random_seed = std::chrono::system_clock::now().time_since_epoch().count();
-    std::shuffle(resultRecallData.begin(), resultRecallData.end(),
-                 std::default_random_engine(random_seed));
+    std::shuffle(resultRecallData.begin(), resultRecallData.end(), RequestRandom::Engine());
 
     double end_time = Common::get_ms_time();
     if (requestData.is_statis_log)
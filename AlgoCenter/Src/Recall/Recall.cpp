@@ -2,14 +2,8 @@
 #include "glog/logging.h"
 
 #include "RecallInstance.hpp"
-
-const RecallParamData *Recall::GetRecallParamData(
-    const RequestData &requestData,
-    ResponseData &responseData)
-{
-    return RecallConfig::GetInstance()->GetRecallParamData(
-        requestData.userGroupList, requestData.apiType, requestData.recallExpID);
-}
+#include "Monitor/Monitor.h"
+#include "Trace/Tracer.h"
 
 int Recall::CallRecall(
     const RecallParamData *pRecallParamData,
@@ -17,15 +11,36 @@ int Recall::CallRecall(
     ResponseData &responseData)
 {
     double start_time = Common::get_ms_time();
+    TraceSpan recallSpan("CallRecall");
+
+    auto monitor = Monitor::GetInstance();
+    const std::string api = std::to_string(static_cast<int>(requestData.apiType));
 
     // 1. 召回
+    // 召回预算只约束主召回列表; 备用与独立召回是降级与补量的兜底, 不受预算限制
+    std::string skip_recall_types;
     auto lambda_async_recall =
-        [&requestData](
+        [&requestData, &responseData, &monitor, &api, &skip_recall_types](
             const std::vector<RecallParam> &vecRecallParam,
-            std::unordered_map<std::string, std::vector<ItemInfo>> &recallTypeItemList) -> int
+            std::unordered_map<std::string, std::vector<ItemInfo>> &recallTypeItemList,
+            bool check_budget) -> int
     {
         for (const auto &recallParams : vecRecallParam)
         {
+            // 超出召回预算, 跳过剩余渠道, 请求结束时汇总输出
+            if (check_budget && requestData.recall_deadline_ms > 0 &&
+                Common::get_ms_time() > requestData.recall_deadline_ms)
+            {
+                responseData.degrade_flags |= Degrade_RecallSkip;
+                if (!skip_recall_types.empty())
+                {
+                    skip_recall_types.append(", ");
+                }
+                skip_recall_types.append(recallParams.GetRecallType());
+                monitor->ObserveRecallChannel(api, recallParams.GetRecallType(), "skip", 0, 0.0);
+                continue;
+            }
+
             std::string recallType = recallParams.GetRecallType();
             long recallTypeId = Common::GetRecallTypeID(recallType);
             if (recallTypeId == Common::RT_ID::RTI_None)
@@ -39,8 +54,14 @@ int Recall::CallRecall(
             auto &recallItemList = recallTypeItemList[recallType];
             recallItemList.clear();
 
+            double channel_start_time = Common::get_ms_time();
+            TraceSpan channelSpan("RecallChannel", recallType);
             auto recallInstance = Common::GetRecallInstance(recallTypeId);
             int err = recallInstance->RecallItem(requestData, recallParams, recallItemList);
+            channelSpan.End();
+            monitor->ObserveRecallChannel(
+                api, recallType, (Common::Error::OK == err) ? "ok" : "fail",
+                recallItemList.size(), Common::get_ms_time() - channel_start_time);
             if (Common::Error::OK != err)
             {
                 LOG(WARNING) << "Recall::CallRecall() Recall Calc Failed"
@@ -59,7 +80,7 @@ int Recall::CallRecall(
     // 1.1 遍历召回策略列表, 调用召回策略
     std::unordered_map<std::string, std::vector<ItemInfo>> recallTypeItemList;
     int recall_err = lambda_async_recall(
-        pRecallParamData->vecRecallParams, recallTypeItemList);
+        pRecallParamData->vecRecallParams, recallTypeItemList, true);
     if (recall_err != Common::Error::OK)
     {
         return recall_err;
@@ -68,7 +89,7 @@ int Recall::CallRecall(
     // 1.2 遍历备用召回策略列表, 调用召回策略
     std::unordered_map<std::string, std::vector<ItemInfo>> spareRecallTypeItemList;
     int spare_recall_err = lambda_async_recall(
-        pRecallParamData->vecSpareRecallParams, spareRecallTypeItemList);
+        pRecallParamData->vecSpareRecallParams, spareRecallTypeItemList, false);
     if (spare_recall_err != Common::Error::OK)
     {
         return spare_recall_err;
@@ -76,16 +97,25 @@ int Recall::CallRecall(
 
     // 1.3 遍历独立召回策略列表, 调用召回策略
     int exclusive_recall_err = lambda_async_recall(
-        pRecallParamData->vecExclusiveRecallParams, responseData.exclusive_items_list);
+        pRecallParamData->vecExclusiveRecallParams, responseData.exclusive_items_list, false);
     if (exclusive_recall_err != Common::Error::OK)
     {
         return exclusive_recall_err;
     }
 
+    if (!skip_recall_types.empty())
+    {
+        LOG(WARNING) << "Recall::CallRecall() Recall Budget Exhausted, Skip Channel"
+                     << ", apiType" << requestData.apiType
+                     << ", recallExpID = " << requestData.recallExpID
+                     << ", uuid = " << requestData.uuid
+                     << ", skip recallType = [" << skip_recall_types << "]";
+    }
+
     double recall_time = Common::get_ms_time();
 
     // 2. 融合
-    std::unordered_set<long> recallMergeSet;
+    ItemIdSet recallMergeSet(pRecallParamData->AllMergeNum + pRecallParamData->AllSpareMergeNum);
 
     // 2.1 召回融合
     int merge_err = ItemMerge(
@@ -108,27 +138,7 @@ int Recall::CallRecall(
     }
 
     // 2.3 独立召回去重
-    std::unordered_set<long> exclusiveRecallItemSet;
-    for (auto iter = responseData.exclusive_items_list.begin();
-         iter != responseData.exclusive_items_list.end(); iter++)
-    {
-        auto originalItemList = std::move(iter->second);
-
-        iter->second.clear();
-        iter->second.reserve(originalItemList.size());
-
-        for (auto &item_info : originalItemList)
-        {
-            if (exclusiveRecallItemSet.find(item_info.item_id) == exclusiveRecallItemSet.end())
-            {
-                iter->second.emplace_back(std::move(item_info));
-            }
-            else
-            {
-                exclusiveRecallItemSet.insert(item_info.item_id);
-            }
-        }
-    }
+    ExclusiveDedupe(responseData.exclusive_items_list);
 
     StatisLogData::OutStatisLog(requestData, responseData, "After Merge", {0}, true, true);
     double end_time = Common::get_ms_time();
@@ -154,84 +164,103 @@ int Recall::CallRecall(
 int Recall::ItemMerge(
     const int allMergeNum,
     const std::vector<RecallParam> &vecRecallParams,
-    const std::unordered_map<std::string, std::vector<ItemInfo>> &recallTypeItemList,
-    std::unordered_set<long> &recallMergeSet,
+    std::unordered_map<std::string, std::vector<ItemInfo>> &recallTypeItemList,
+    ItemIdSet &recallMergeSet,
     std::vector<ItemInfo> &resultItemList)
 {
     // 融合所有渠道的最大房间数量
     std::size_t useAllMergeNum = static_cast<std::size_t>(allMergeNum);
 
-    // 召回类型已融合数量
-    std::unordered_map<std::string, std::size_t> recallTypeMergeNum;
-
-    for (const auto &mergeParams : vecRecallParams)
+    // 按渠道位置记录: 召回列表, 已遍历位置, 已融合数量
+    std::size_t channelNum = vecRecallParams.size();
+    std::vector<std::vector<ItemInfo> *> vecChannelList(channelNum, nullptr);
+    std::vector<std::size_t> vecChannelPos(channelNum, 0);
+    std::vector<std::size_t> vecChannelMergeNum(channelNum, 0);
+    for (std::size_t idx = 0; idx < channelNum; idx++)
     {
-        auto recallType = mergeParams.GetRecallType();
-        auto iter = recallTypeItemList.find(recallType);
-        if (iter == recallTypeItemList.end())
+        auto iter = recallTypeItemList.find(vecRecallParams[idx].GetRecallType());
+        if (iter != recallTypeItemList.end())
         {
-            continue;
+            vecChannelList[idx] = &iter->second;
         }
+    }
 
-        std::size_t mergeMinNum = mergeParams.GetMergeMinNum();
-        for (auto &item_info : iter->second)
-        {
-            // 达到总融合最大数量, 直接返回(一般不会出现)
-            if (recallMergeSet.size() >= useAllMergeNum)
-            {
-                LOG(WARNING) << "Recall::ItemMerge() More than allMergeNum!!!";
-                return Common::Error::OK;
-            }
+    resultItemList.reserve(resultItemList.size() + useAllMergeNum);
 
-            // 达到渠道最小融合数量, 则不再继续添加
-            if (recallTypeMergeNum[recallType] >= mergeMinNum)
+    // 第一轮按渠道最小融合数量, 第二轮按最大融合数量, 第二轮从第一轮停止处继续
+    for (int round = 0; round < 2; round++)
+    {
+        for (std::size_t idx = 0; idx < channelNum; idx++)
+        {
+            auto pChannelList = vecChannelList[idx];
+            if (pChannelList == nullptr)
             {
-                break;
+                continue;
             }
 
-            if (recallMergeSet.find(item_info.item_id) == recallMergeSet.end())
+            std::size_t mergeLimitNum = (round == 0)
+                                            ? vecRecallParams[idx].GetMergeMinNum()
+                                            : vecRecallParams[idx].GetMergeMaxNum();
+            auto &channelPos = vecChannelPos[idx];
+            auto &channelMergeNum = vecChannelMergeNum[idx];
+            for (; channelPos < pChannelList->size(); channelPos++)
             {
-                recallMergeSet.insert(item_info.item_id);
-
-                resultItemList.emplace_back(item_info);
-                ++recallTypeMergeNum[item_info.recall_type];
+                // 达到总融合最大数量, 直接返回
+                if (recallMergeSet.size() >= useAllMergeNum)
+                {
+                    if (round == 0)
+                    {
+                        LOG(WARNING) << "Recall::ItemMerge() More than allMergeNum!!!";
+                    }
+                    return Common::Error::OK;
+                }
+
+                // 达到渠道融合数量, 则不再继续添加
+                if (channelMergeNum >= mergeLimitNum)
+                {
+                    break;
+                }
+
+                auto &item_info = (*pChannelList)[channelPos];
+                if (recallMergeSet.Insert(item_info.item_id))
+                {
+                    resultItemList.emplace_back(std::move(item_info));
+                    ++channelMergeNum;
+                }
             }
         }
     }
 
-    for (const auto &mergeParams : vecRecallParams)
+    return Common::Error::OK;
+}
+
+void Recall::ExclusiveDedupe(
+    std::unordered_map<std::string, std::vector<ItemInfo>> &exclusiveItemList)
+{
+    std::size_t totalNum = 0;
+    for (const auto &type_items : exclusiveItemList)
     {
-        auto recallType = mergeParams.GetRecallType();
-        auto iter = recallTypeItemList.find(recallType);
-        if (iter == recallTypeItemList.end())
-        {
-            continue;
-        }
+        totalNum += type_items.second.size();
+    }
 
-        std::size_t mergeMaxNum = mergeParams.GetMergeMaxNum();
-        for (auto &item_info : iter->second)
+    ItemIdSet exclusiveRecallItemSet(totalNum);
+    for (auto iter = exclusiveItemList.begin(); iter != exclusiveItemList.end(); iter++)
+    {
+        auto &vecItemList = iter->second;
+        std::size_t keep_idx = 0;
+        for (std::size_t idx = 0; idx < vecItemList.size(); idx++)
         {
-            // 达到总融合最大数量, 直接返回
-            if (recallMergeSet.size() >= useAllMergeNum)
+            if (!exclusiveRecallItemSet.Insert(vecItemList[idx].item_id))
             {
-                return Common::Error::OK;
+                continue;
             }
 
-            // 达到渠道最大融合数量, 则不再继续添加
-            if (recallTypeMergeNum[recallType] >= mergeMaxNum)
+            if (keep_idx != idx)
             {
-                break;
-            }
-
-            if (recallMergeSet.find(item_info.item_id) == recallMergeSet.end())
-            {
-                recallMergeSet.insert(item_info.item_id);
-
-                resultItemList.emplace_back(item_info);
-                ++recallTypeMergeNum[item_info.recall_type];
+                vecItemList[keep_idx] = std::move(vecItemList[idx]);
             }
+            keep_idx++;
         }
+        vecItemList.erase(vecItemList.begin() + keep_idx, vecItemList.end());
     }
-
-    return Common::Error::OK;
 }
@@ -5,6 +5,7 @@
 #include "Common/Singleton.h"
 
 #include "RecallConfig.h"
+#include "ItemIdSet.h"
 
 class RequestData;
 
@@ -16,23 +17,28 @@ class Recall_Interface;
 class Recall : public Singleton<Recall>
 {
 public:
-    const RecallParamData *GetRecallParamData(
-        const RequestData &requestData,
-        ResponseData &responseData);
-
     int CallRecall(
         const RecallParamData *pRecallParamData,
         const RequestData &requestData,
         ResponseData &responseData);
 
-protected:
-    int ItemMerge(
+    // ItemMerge 按渠道顺序融合召回结果, 已融合物料从召回列表中移出
+    // [in] allMergeNum 融合输出数量
+    // [in] vecRecallParams 召回/融合参数
+    // [in/out] recallTypeItemList 各渠道召回结果
+    // [in/out] recallMergeSet 已融合物料ID
+    // [out] resultItemList 融合结果
+    static int ItemMerge(
         const int allMergeNum,
         const std::vector<RecallParam> &vecRecallParams,
-        const std::unordered_map<std::string, std::vector<ItemInfo>> &recallTypeItemList,
-        std::unordered_set<long> &recallMergeSet,
+        std::unordered_map<std::string, std::vector<ItemInfo>> &recallTypeItemList,
+        ItemIdSet &recallMergeSet,
         std::vector<ItemInfo> &resultItemList);
 
+    // ExclusiveDedupe 独立召回列表间去重, 保留先出现的物料
+    static void ExclusiveDedupe(
+        std::unordered_map<std::string, std::vector<ItemInfo>> &exclusiveItemList);
+
 public:
     Recall(token) {}
     ~Recall() {}
@@ -9,6 +9,7 @@
 
 #include "glog/logging.h"
 #include "Common/Function.h"
+#include "Replay/RequestRandom.h"
 
 class RecallCalc
 {
@@ -200,7 +201,7 @@ public:
             int begin_pos = use_sample_size - use_sampling_num;
             for (int idx = begin_pos < 0 ? 0 : begin_pos; idx < use_sample_size; idx++)
             {
-                int pos = rand() % (idx + 1);
+                int pos = RequestRandom::Next() % (idx + 1);
                 const auto &sample_info = vecSample[pos];
                 std::string item_key = std::to_string(sample_info.id) + "_" + std::to_string(sample_info.res_type);
                 if (resultData.find(item_key) != resultData.end())
@@ -279,7 +280,7 @@ public:
                     break;
                 }
 
-                int random_num = rand() % total_calc_weight;
+                int random_num = RequestRandom::Next() % total_calc_weight;
                 for (auto iter = use_item_calc_weight.begin(); iter != use_item_calc_weight.end(); iter++)
                 {
                     if (random_num < iter->second)
@@ -152,10 +152,10 @@ public:
 public:
     bool UpdateJson(const std::string &jsonData);
 
-    const int MatchRecallExpID(const Common::APIType apiType, const std::vector<int> &vecExpIDList) const;
-    const RecallParamData *GetRecallParamData(const std::unordered_set<std::string> &userGroupList, Common::APIType apiType, int exp_id) const;
+    // 当前配置, 请求开始时经 ConfigSnapshot 取一次, 之后只读
+    inline std::shared_ptr<const RecallConfigData> GetConfigData() const { return std::atomic_load(&m_spData); }
 
-    RecallConfig(token) { m_dataIdx = 0; }
+    RecallConfig(token) : m_spData(std::make_shared<RecallConfigData>()) {}
     ~RecallConfig() {}
     RecallConfig(RecallConfig &) = delete;
     RecallConfig &operator=(const RecallConfig &) = delete;
@@ -163,11 +163,10 @@ public:
 protected:
     RecallConfig::Error DecodeJsonData(const std::string &jsonData);
 
-    RecallConfig::Error DecodeRecallParamData(rapidjson::Document &doc, int dataIdx);
+    RecallConfig::Error DecodeRecallParamData(rapidjson::Document &doc, RecallConfigData &data);
 
 private:
-    std::atomic<int> m_dataIdx = 0;
-    RecallConfigData m_data[2];
+    std::shared_ptr<const RecallConfigData> m_spData; // 当前配置, 通过 std::atomic_load/atomic_store 读写
 
     std::mutex m_update_lock; // 更新锁
 };
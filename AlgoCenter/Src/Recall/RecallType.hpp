@@ -1,6 +1,7 @@
 #pragma once
 #include <ostream>
 #include <string>
+#include <vector>
 #include <unordered_map>
 
 namespace Common
@@ -24,9 +25,10 @@ namespace Common
         RTI_ClickOccur = 30,    // 物料点击共现
         RTI_DownloadOccur = 31, // 物料下载共现
 
+        RTI_Limit = 64, // 召回类型ID上限, 新增类型需小于该值
     } RT_ID;
 
-    inline int GetRecallTypeID(const std::string &recallType) noexcept
+    inline const std::unordered_map<std::string, int> &GetRecallTypeIDConf() noexcept
     {
         static const std::unordered_map<std::string, int> s_RecallTypeIDConf = {
             {"ResType_Hot", RT_ID::RTI_ResType_Hot},
@@ -43,12 +45,38 @@ namespace Common
             {"ClickOccur", RT_ID::RTI_ClickOccur},
             {"DownloadOccur", RT_ID::RTI_DownloadOccur},
         };
+        return s_RecallTypeIDConf;
+    }
 
-        auto iter = s_RecallTypeIDConf.find(recallType);
-        if (iter != s_RecallTypeIDConf.end())
+    inline int GetRecallTypeID(const std::string &recallType) noexcept
+    {
+        const auto &recallTypeIDConf = GetRecallTypeIDConf();
+        auto iter = recallTypeIDConf.find(recallType);
+        if (iter != recallTypeIDConf.end())
         {
             return iter->second;
         }
         return 0;
     }
+
+    // 召回类型名称表, 以召回类型ID为下标, 用于日志输出
+    inline const std::string &GetRecallTypeName(long recallTypeId) noexcept
+    {
+        static const std::vector<std::string> s_RecallTypeNameList = []()
+        {
+            std::vector<std::string> nameList(RT_ID::RTI_Limit);
+            for (const auto &name_id : GetRecallTypeIDConf())
+            {
+                nameList[name_id.second] = name_id.first;
+            }
+            return nameList;
+        }();
+
+        static const std::string s_EmptyName = "";
+        if (recallTypeId <= 0 || recallTypeId >= RT_ID::RTI_Limit)
+        {
+            return s_EmptyName;
+        }
+        return s_RecallTypeNameList[recallTypeId];
+    }
 }
@@ -7,6 +7,11 @@
 #include <unordered_set>
 #include "RedisProtoData_Def.h"
 
+namespace google::protobuf
+{
+    class Arena;
+}
+
 class RedisProtoData
 {
 public:
@@ -29,12 +34,22 @@ public:
     // 停止缓存任务
     static void ShutDownCache();
 
+    // 缓存命中统计
+    struct CacheStatis
+    {
+        long hit_count = 0;
+        long miss_count = 0;
+    };
+    static CacheStatis GetItemFeatureCacheStatis() noexcept;
+    static CacheStatis GetSingleInvertIndexCacheStatis() noexcept;
+
 public:
-    // 获取用户特征Proto
+    // 获取用户特征Proto, 指定 spArena 时 Proto 分配在请求级 Arena 上
     static int GetUserFeatureProto(
         const long user_id,
         const std::vector<RPD_Common::RPD_Type> &vec_type,
-        RPDType2SPProto &type_proto) noexcept;
+        RPDType2SPProto &type_proto,
+        const std::shared_ptr<google::protobuf::Arena> &spArena = nullptr) noexcept;
 
 public:
     // 获取物料特征Proto
@@ -1,6 +1,7 @@
 #pragma once
 #include "include/RedisProtoData_Def.h"
 #include "MurmurHash3/MurmurHash3.h"
+#include "google/protobuf/arena.h"
 
 #include "Protobuf/redis/user_feature_data.pb.h"
 #include "Protobuf/redis/user_live_feature_data.pb.h"
@@ -97,49 +98,60 @@ namespace RPD_Common
         return empty;
     }
 
+    // 创建Proto, 指定 Arena 时在 Arena 上分配, 返回的指针持有 Arena 的引用
+    template <typename ProtoType>
+    inline SharedPtrProto NewSPProto(const std::shared_ptr<google::protobuf::Arena> &spArena)
+    {
+        if (spArena == nullptr)
+        {
+            return std::make_shared<ProtoType>();
+        }
+        return SharedPtrProto(spArena, google::protobuf::Arena::CreateMessage<ProtoType>(spArena.get()));
+    }
+
     // 特征对应Protobuf
-    inline SharedPtrProto GetSPProto(const int type)
+    inline SharedPtrProto GetSPProto(const int type, const std::shared_ptr<google::protobuf::Arena> &spArena = nullptr)
     {
         SharedPtrProto spProto = nullptr;
         switch (type)
         {
         // 用户特征
         case RPD_Common::RPD_Type::RPD_UserFeatureBasic:
-            spProto = std::make_shared<RSP_UserFeatureData::UserFeatureBasic>();
+            spProto = NewSPProto<RSP_UserFeatureData::UserFeatureBasic>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_UserFeatureClick:
-            spProto = std::make_shared<RSP_UserFeatureData::UserFeatureClick>();
+            spProto = NewSPProto<RSP_UserFeatureData::UserFeatureClick>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_UserFeatureSearch:
-            spProto = std::make_shared<RSP_UserFeatureData::UserFeatureSearch>();
+            spProto = NewSPProto<RSP_UserFeatureData::UserFeatureSearch>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_UserFeatureDownload:
-            spProto = std::make_shared<RSP_UserFeatureData::UserFeatureDownload>();
+            spProto = NewSPProto<RSP_UserFeatureData::UserFeatureDownload>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_UserFeatureIndex:
-            spProto = std::make_shared<RSP_UserFeatureData::UserFeatureIndex>();
+            spProto = NewSPProto<RSP_UserFeatureData::UserFeatureIndex>(spArena);
             break;
 
         // 用户实时特征
         case RPD_Common::RPD_Type::RPD_UserLiveFeatureClick:
-            spProto = std::make_shared<RSP_UserLiveFeatureData::UserLiveFeatureClick>();
+            spProto = NewSPProto<RSP_UserLiveFeatureData::UserLiveFeatureClick>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_UserLiveFeatureSearch:
-            spProto = std::make_shared<RSP_UserLiveFeatureData::UserLiveFeatureSearch>();
+            spProto = NewSPProto<RSP_UserLiveFeatureData::UserLiveFeatureSearch>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_UserLiveFeatureDownload:
-            spProto = std::make_shared<RSP_UserLiveFeatureData::UserLiveFeatureDownload>();
+            spProto = NewSPProto<RSP_UserLiveFeatureData::UserLiveFeatureDownload>(spArena);
             break;
 
         // 物料特征
         case RPD_Common::RPD_Type::RPD_ItemFeatureBasic:
-            spProto = std::make_shared<RSP_ItemFeatureData::ItemFeatureBasic>();
+            spProto = NewSPProto<RSP_ItemFeatureData::ItemFeatureBasic>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_ItemFeatureStatis:
-            spProto = std::make_shared<RSP_ItemFeatureData::ItemFeatureStatis>();
+            spProto = NewSPProto<RSP_ItemFeatureData::ItemFeatureStatis>(spArena);
             break;
         case RPD_Common::RPD_Type::RPD_ItemFeatureIndex:
-            spProto = std::make_shared<RSP_ItemFeatureData::ItemFeatureIndex>();
+            spProto = NewSPProto<RSP_ItemFeatureData::ItemFeatureIndex>(spArena);
             break;
 
         default:
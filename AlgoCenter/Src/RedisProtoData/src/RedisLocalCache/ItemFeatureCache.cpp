@@ -2,6 +2,8 @@
 #include "glog/logging.h"
 #include "TDRedis/TDRedis.h"
 #include "TDRedis/TDRedisConnPool.h"
+#include "Trace/Tracer.h"
+#include "Replay/Recorder.h"
 
 static const std::vector<RPD_Common::RPD_Type> VecItemBucketCacheType = {
     RPD_Common::RPD_Type::RPD_ItemFeatureBasic,
@@ -53,10 +55,40 @@ int ItemFeatureCache::ShutDown()
 }
 
 // 批量获取接口
+// 录制请求读取到的物料特征, 缓存命中的 Proto 重新序列化, 按 Redis 中的 key/field 记录
+static void RecordItemFeature(
+    const std::vector<std::string> &vecItemKeys,
+    const std::unordered_map<std::string, RPDType2SPProto> &featureProtoData)
+{
+    for (const auto &item_key : vecItemKeys)
+    {
+        auto iter = featureProtoData.find(item_key);
+        if (iter == featureProtoData.end())
+        {
+            continue;
+        }
+
+        long item_id = atol(item_key.substr(0, item_key.find_first_of("_")).c_str());
+        std::string res_type = item_key.substr(item_key.find_first_of("_") + 1);
+        for (const auto &type_proto : iter->second)
+        {
+            if (type_proto.second != nullptr)
+            {
+                Recorder::RecordRedisHash(
+                    RPD_Common::GetItemKey(type_proto.first, item_id),
+                    RPD_Common::GetItemField(type_proto.first, item_id, res_type),
+                    type_proto.second->SerializeAsString());
+            }
+        }
+    }
+}
+
 int ItemFeatureCache::GetCacheProtoData(
     const std::vector<Key> &vecItemKeys,
     std::unordered_map<Key, Value> &featureProtoData) const
 {
+    TraceSpan cacheSpan("GetCacheProtoData");
+
     if (m_bucketCachePtr.size() != RPD_Common::s_ItemFeatureBucketNum)
     {
         LOG(ERROR) << "GetCacheProtoData() Cache Not Init!!!";
@@ -83,9 +115,16 @@ int ItemFeatureCache::GetCacheProtoData(
         }
     }
 
+    m_HitCount.fetch_add(vecItemKeys.size() - missItemKeys.size(), std::memory_order_relaxed);
+    m_MissCount.fetch_add(missItemKeys.size(), std::memory_order_relaxed);
+
     // 没有缓存不命中的情况, 返回OK
     if (missItemKeys.empty())
     {
+        if (Recorder::IsActive())
+        {
+            RecordItemFeature(vecItemKeys, featureProtoData);
+        }
         return Common::Error::OK;
     }
 
@@ -121,6 +160,7 @@ int ItemFeatureCache::GetCacheProtoData(
             continue;
         }
 
+        TraceSpan sendSpan("ItemFeaturePipeSend", (long)bucket);
         for (const auto type : VecItemBucketCacheType)
         {
             std::vector<std::string> vec_fields(bucket_items_size);
@@ -155,6 +195,7 @@ int ItemFeatureCache::GetCacheProtoData(
         }
 
         // Pipe 获取返回值
+        TraceSpan recvSpan("ItemFeaturePipeRecv", (long)bucket);
         std::unordered_map<Key, Value> bucketSPProto;
         for (const auto type : VecItemBucketCacheType)
         {
@@ -217,6 +258,10 @@ int ItemFeatureCache::GetCacheProtoData(
         cache->AddRWBufCacheData(bucketSPProto);
     }
 
+    if (Recorder::IsActive())
+    {
+        RecordItemFeature(vecItemKeys, featureProtoData);
+    }
     return Common::Error::OK;
 }
 
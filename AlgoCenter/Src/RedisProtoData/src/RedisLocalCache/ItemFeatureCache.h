@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include "Common/CommonCache.h"
 #include "Common/Singleton.h"
 #include "../RPD_Common.hpp"
@@ -28,10 +29,17 @@ public:
         const std::vector<Key> &vecItemKeys,
         std::unordered_map<Key, Value> &featureProtoData) const;
 
+    // 缓存命中统计, 按物料计数
+    inline long GetHitCount() const noexcept { return m_HitCount.load(std::memory_order_relaxed); }
+    inline long GetMissCount() const noexcept { return m_MissCount.load(std::memory_order_relaxed); }
+
 protected:
     int GetBucketItemKeys(int bucket, std::unordered_set<Key> &setItemKeys);
     int RefreshBucket(int bucket, std::unordered_set<Key> &setItemKeys);
 
 private:
     std::vector<ItemFeatureCacheData *> m_bucketCachePtr;
+
+    mutable std::atomic<long> m_HitCount = 0;
+    mutable std::atomic<long> m_MissCount = 0;
 };
@@ -4,6 +4,7 @@
 #include "glog/logging.h"
 #include "TDRedis/TDRedis.h"
 #include "TDRedis/TDRedisConnPool.h"
+#include "Replay/Recorder.h"
 
 static const std::vector<RPD_Common::RPD_Type> VecSingleInvertIndexCacheType = {
     RPD_Common::RPD_Type::RPD_ResTypeHotInvertIndex,
@@ -193,8 +194,17 @@ int SingleInvertIndexCache::GetSingleInvertIndexCache(
     std::string data_key = RPD_Common::GetBasicKey(type) + slice;
     if (!pCacheData->GetCacheData(data_key, protoData))
     {
+        m_MissCount.fetch_add(1, std::memory_order_relaxed);
         protoData.clear();
     }
+    else
+    {
+        m_HitCount.fetch_add(1, std::memory_order_relaxed);
+        if (Recorder::IsActive())
+        {
+            Recorder::RecordRedisString(data_key, protoData);
+        }
+    }
 
     return Common::Error::OK;
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include "Common/CommonCache.h"
 #include "Common/Singleton.h"
 #include "../RPD_Common.hpp"
@@ -30,10 +31,17 @@ public:
         const Key &slice,
         Value &protoData) const;
 
+    // 缓存命中统计
+    inline long GetHitCount() const noexcept { return m_HitCount.load(std::memory_order_relaxed); }
+    inline long GetMissCount() const noexcept { return m_MissCount.load(std::memory_order_relaxed); }
+
 protected:
     // 更新数据函数
     int RefreshSingleInvertIndexData(RPD_Common::RPD_Type type);
 
 protected:
     std::unordered_map<RPD_Common::RPD_Type, SingleInvertIndexCacheData *> m_typeCachePtr;
+
+    mutable std::atomic<long> m_HitCount = 0;
+    mutable std::atomic<long> m_MissCount = 0;
 };
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include "TDRedis/TDRedis.h"
 #include "TDRedis/TDRedisConnPool.h"
+#include "Replay/Recorder.h"
 
 #include "RedisLocalCache/RedisLocalCache.h"
 #include "RedisLocalCache/ItemFeatureCache.h"
@@ -43,10 +44,23 @@ void RedisProtoData::ShutDownCache()
     LOG(INFO) << "RedisLocalCache::ShutDown() finish.";
 }
 
+RedisProtoData::CacheStatis RedisProtoData::GetItemFeatureCacheStatis() noexcept
+{
+    auto cache = ItemFeatureCache::GetInstance();
+    return {cache->GetHitCount(), cache->GetMissCount()};
+}
+
+RedisProtoData::CacheStatis RedisProtoData::GetSingleInvertIndexCacheStatis() noexcept
+{
+    auto cache = SingleInvertIndexCache::GetInstance();
+    return {cache->GetHitCount(), cache->GetMissCount()};
+}
+
 int RedisProtoData::GetUserFeatureProto(
     const long user_id,
     const std::vector<RPD_Common::RPD_Type> &vec_type,
-    RPDType2SPProto &type_proto) noexcept
+    RPDType2SPProto &type_proto,
+    const std::shared_ptr<google::protobuf::Arena> &spArena) noexcept
 {
     const std::string &RedisName = RPD_Common::g_UserFeatureData;
     auto tdRedisPtr = TDRedisConnPool::GetInstance()->GetConnect(RedisName);
@@ -88,10 +102,18 @@ int RedisProtoData::GetUserFeatureProto(
             return Common::Error::RPD_RequestFailed;
         }
 
+        if (Recorder::IsActive() && !protoData.empty())
+        {
+            Recorder::RecordRedisHash(
+                RPD_Common::GetUserKey(type, user_id),
+                RPD_Common::GetUserField(type, user_id),
+                protoData);
+        }
+
         if (!protoData.empty())
         {
             // 解析Proto数据
-            auto spProto = RPD_Common::GetSPProto(type);
+            auto spProto = RPD_Common::GetSPProto(type, spArena);
             if (spProto == nullptr)
             {
                 LOG(ERROR) << "GetUserFeatureProto() GetSPProto is nullptr"
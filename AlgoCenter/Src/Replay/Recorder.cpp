@@ -0,0 +1,244 @@
+#include "Recorder.h"
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include "glog/logging.h"
+
+// 单次请求录制数据上限, 超出后整条丢弃
+static const std::size_t s_MaxRequestBytes = 64UL * 1024 * 1024;
+
+// 待写入请求上限, 写文件跟不上时丢弃
+static const std::size_t s_MaxQueueNum = 256;
+
+thread_local bool Recorder::t_Active = false;
+thread_local std::vector<Replay::ReplayRecord> Recorder::t_vecRecord;
+thread_local std::size_t Recorder::t_RecordBytes = 0;
+
+static uint64_t RedisRecordHash(const Replay::ReplayRecord &record) noexcept
+{
+    std::hash<std::string_view> hasher;
+    uint64_t hash = record.type;
+    for (const std::string *str : {&record.key, &record.field, &record.value})
+    {
+        hash ^= hasher(*str) + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+bool Recorder::Init(const std::string &file_path, int sample_rate, int max_file_mb)
+{
+    if (g_Init)
+    {
+        return true;
+    }
+
+    if (file_path.empty() || sample_rate <= 0 || sample_rate > 10000 || max_file_mb <= 0)
+    {
+        LOG(ERROR) << "Recorder::Init() params error"
+                   << ", file_path = " << file_path
+                   << ", sample_rate = " << sample_rate
+                   << ", max_file_mb = " << max_file_mb;
+        return false;
+    }
+
+    m_SampleRate = sample_rate;
+    m_MaxFileBytes = max_file_mb * 1024L * 1024L;
+
+    std::error_code ec;
+    auto parent_path = std::filesystem::path(file_path).parent_path();
+    if (!parent_path.empty() && !std::filesystem::exists(parent_path, ec))
+    {
+        std::filesystem::create_directories(parent_path, ec);
+        if (ec)
+        {
+            LOG(ERROR) << "Recorder::Init() create directory failed"
+                       << ", path = " << parent_path
+                       << ", err = " << ec.message();
+            return false;
+        }
+    }
+
+    if (!m_Writer.Open(file_path))
+    {
+        return false;
+    }
+
+    m_Full = false;
+    g_Init = true;
+    g_WorkThreadPtr = std::thread(&Recorder::WriteThread, this);
+
+    LOG(INFO) << "Recorder::Init() succ"
+              << ", file_path = " << file_path
+              << ", sample_rate = " << sample_rate
+              << ", max_file_mb = " << max_file_mb;
+    return true;
+}
+
+void Recorder::ShutDown()
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(m_Mutex);
+        g_Init = false;
+    }
+    m_Cond.notify_all();
+
+    if (g_WorkThreadPtr.joinable())
+    {
+        g_WorkThreadPtr.join();
+    }
+    m_Writer.Close();
+
+    LOG(INFO) << "Recorder::ShutDown()"
+              << ", record = " << GetRecordCount()
+              << ", drop = " << GetDropCount()
+              << ", file_bytes = " << m_Writer.GetFileBytes();
+}
+
+bool Recorder::IsSampled(const std::string &uuid) const noexcept
+{
+    if (!g_Init || m_Full.load(std::memory_order_relaxed) || uuid.empty())
+    {
+        return false;
+    }
+    return static_cast<int>(std::hash<std::string>{}(uuid) % 10000) < m_SampleRate;
+}
+
+void Recorder::Begin(int cmd, const std::string &request)
+{
+    if (!g_Init || t_Active)
+    {
+        return;
+    }
+
+    t_Active = true;
+    t_vecRecord.clear();
+    t_vecRecord.reserve(64);
+
+    auto &record = t_vecRecord.emplace_back();
+    record.type = Replay::Record_Request;
+    record.cmd = cmd;
+    record.value = request;
+    t_RecordBytes = request.size();
+}
+
+void Recorder::End()
+{
+    if (!t_Active)
+    {
+        return;
+    }
+    t_Active = false;
+
+    {
+        std::lock_guard<std::mutex> lg(m_Mutex);
+        if (!g_Init || m_Full || t_RecordBytes > s_MaxRequestBytes || m_Queue.size() >= s_MaxQueueNum)
+        {
+            m_DropCount.fetch_add(1, std::memory_order_relaxed);
+            t_vecRecord.clear();
+            return;
+        }
+        m_Queue.emplace_back(std::move(t_vecRecord));
+    }
+    m_Cond.notify_one();
+    t_vecRecord = std::vector<Replay::ReplayRecord>();
+}
+
+void Recorder::RecordRedisString(const std::string &key, const std::string &value)
+{
+    if (!t_Active || t_RecordBytes > s_MaxRequestBytes)
+    {
+        return;
+    }
+
+    auto &record = t_vecRecord.emplace_back();
+    record.type = Replay::Record_RedisString;
+    record.key = key;
+    record.value = value;
+    t_RecordBytes += key.size() + value.size();
+}
+
+void Recorder::RecordRedisHash(const std::string &key, const std::string &field, const std::string &value)
+{
+    if (!t_Active || t_RecordBytes > s_MaxRequestBytes)
+    {
+        return;
+    }
+
+    auto &record = t_vecRecord.emplace_back();
+    record.type = Replay::Record_RedisHash;
+    record.key = key;
+    record.field = field;
+    record.value = value;
+    t_RecordBytes += key.size() + field.size() + value.size();
+}
+
+void Recorder::WriteThread()
+{
+    std::deque<std::vector<Replay::ReplayRecord>> localQueue;
+    std::string buffer;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> ul(m_Mutex);
+            m_Cond.wait(ul, [this]()
+                        { return !g_Init || !m_Queue.empty(); });
+            if (m_Queue.empty())
+            {
+                break; // 已停止且队列写完
+            }
+            localQueue.swap(m_Queue);
+        }
+
+        for (const auto &vecRecord : localQueue)
+        {
+            WriteRequest(vecRecord, buffer);
+        }
+        localQueue.clear();
+    }
+}
+
+// 回放时请求与 Redis 记录分别加载, 记录先后顺序无关
+// 同一 key/field 内容变化时会重复写入, 快照以最后一次为准
+void Recorder::WriteRequest(const std::vector<Replay::ReplayRecord> &vecRecord, std::string &buffer)
+{
+    if (m_Full)
+    {
+        m_DropCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.clear();
+    for (const auto &record : vecRecord)
+    {
+        if (record.type != Replay::Record_Request && !m_setRedisHash.insert(RedisRecordHash(record)).second)
+        {
+            continue;
+        }
+        Replay::EncodeRecord(record, buffer);
+    }
+
+    // 整条请求写入或整条放弃, 文件写满后停止录制, 不再需要去重集合
+    if (m_Writer.GetFileBytes() + (long)buffer.size() > m_MaxFileBytes)
+    {
+        m_Full = true;
+        m_DropCount.fetch_add(1, std::memory_order_relaxed);
+        LOG(WARNING) << "Recorder::WriteRequest() file is full, stop recording"
+                     << ", file_bytes = " << m_Writer.GetFileBytes()
+                     << ", record = " << GetRecordCount();
+        return;
+    }
+
+    if (!m_Writer.WriteEncoded(buffer))
+    {
+        m_Full = true;
+        m_DropCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_RecordCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <unordered_set>
+#include <condition_variable>
+#include "Common/Singleton.h"
+#include "ReplayFile.h"
+
+// 线上流量录制, 输出回放文件(ReplayFile.h), 供 AlgoCenterBench 离线回放
+// 1. 按 uuid 采样, 采样请求在请求线程上开启录制, 未采样时埋点只有一次判断
+// 2. 记录原始请求与该请求读取到的 Redis 数据(用户特征、物料特征、倒排索引)
+// 3. 请求结束后交给后台线程写文件, Redis 记录按内容去重, 文件达到上限后停止录制
+class Recorder : public Singleton<Recorder>
+{
+public:
+    // 初始化
+    // [in] file_path 录制文件路径, 已存在时覆盖
+    // [in] sample_rate 采样率, 万分比
+    // [in] max_file_mb 文件大小上限(MB)
+    bool Init(const std::string &file_path, int sample_rate, int max_file_mb);
+
+    void ShutDown();
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 按 uuid 采样, 同一 uuid 结果固定
+    bool IsSampled(const std::string &uuid) const noexcept;
+
+    // 当前线程开启录制, 首条记录为请求
+    void Begin(int cmd, const std::string &request);
+
+    // 当前线程结束录制, 提交给后台线程写文件
+    void End();
+
+    // 当前线程是否在录制中
+    static inline bool IsActive() noexcept { return t_Active; }
+
+    // 记录 Redis 数据
+    static void RecordRedisString(const std::string &key, const std::string &value);
+    static void RecordRedisHash(const std::string &key, const std::string &field, const std::string &value);
+
+    inline long GetRecordCount() const noexcept { return m_RecordCount.load(std::memory_order_relaxed); }
+    inline long GetDropCount() const noexcept { return m_DropCount.load(std::memory_order_relaxed); }
+
+private:
+    // 后台写文件线程
+    void WriteThread();
+
+    // 写入一次请求的全部记录
+    void WriteRequest(const std::vector<Replay::ReplayRecord> &vecRecord, std::string &buffer);
+
+private:
+    static thread_local bool t_Active;
+    static thread_local std::vector<Replay::ReplayRecord> t_vecRecord;
+    static thread_local std::size_t t_RecordBytes;
+
+    std::atomic<bool> g_Init = false;
+    std::atomic<bool> m_Full = false;
+    int m_SampleRate = 0;
+    long m_MaxFileBytes = 0;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+    std::deque<std::vector<Replay::ReplayRecord>> m_Queue;
+    std::thread g_WorkThreadPtr;
+
+    // 以下仅后台线程访问
+    Replay::ReplayWriter m_Writer;
+    std::unordered_set<uint64_t> m_setRedisHash; // 已写入的 Redis 记录内容哈希
+
+    std::atomic<long> m_RecordCount = 0;
+    std::atomic<long> m_DropCount = 0;
+
+public:
+    Recorder(token) {}
+    ~Recorder() { ShutDown(); }
+    Recorder(Recorder &) = delete;
+    Recorder &operator=(const Recorder &) = delete;
+};
+
+// 请求录制守卫, 采样命中时在当前线程开启录制, 析构时提交
+class RecordScope
+{
+public:
+    RecordScope(const std::string &uuid, int cmd, const std::string &request)
+    {
+        auto recorder = Recorder::GetInstance();
+        if (recorder->IsInit() && !Recorder::IsActive() && recorder->IsSampled(uuid))
+        {
+            recorder->Begin(cmd, request);
+            m_Hold = true;
+        }
+    }
+
+    ~RecordScope()
+    {
+        if (m_Hold)
+        {
+            Recorder::GetInstance()->End();
+        }
+    }
+
+    RecordScope(const RecordScope &) = delete;
+    RecordScope &operator=(const RecordScope &) = delete;
+
+private:
+    bool m_Hold = false;
+};
@@ -0,0 +1,220 @@
+#include "ReplayFile.h"
+#include <cstring>
+#include "glog/logging.h"
+
+namespace Replay
+{
+    static const char s_Magic[4] = {'A', 'C', 'R', 'P'};
+    static const uint8_t s_Version = 1;
+
+    // 单个字段长度上限, 超出视为文件损坏
+    static const uint64_t s_MaxFieldBytes = 512UL * 1024 * 1024;
+
+    static void AppendVarint(uint64_t value, std::string &out)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    static void AppendString(const std::string &value, std::string &out)
+    {
+        AppendVarint(value.size(), out);
+        out.append(value);
+    }
+
+    void EncodeRecord(const ReplayRecord &record, std::string &out)
+    {
+        out.push_back(static_cast<char>(record.type));
+        switch (record.type)
+        {
+        case Record_Request:
+            AppendVarint(static_cast<uint32_t>(record.cmd), out);
+            AppendString(record.value, out);
+            break;
+        case Record_RedisString:
+            AppendString(record.key, out);
+            AppendString(record.value, out);
+            break;
+        case Record_RedisHash:
+            AppendString(record.key, out);
+            AppendString(record.field, out);
+            AppendString(record.value, out);
+            break;
+        }
+    }
+
+    bool ReplayWriter::Open(const std::string &file_path)
+    {
+        Close();
+
+        m_pFile = fopen(file_path.c_str(), "wb");
+        if (m_pFile == nullptr)
+        {
+            LOG(ERROR) << "ReplayWriter::Open() open failed, file_path = " << file_path;
+            return false;
+        }
+
+        fwrite(s_Magic, 1, sizeof(s_Magic), m_pFile);
+        fputc(s_Version, m_pFile);
+        m_FileBytes = sizeof(s_Magic) + 1;
+        return true;
+    }
+
+    void ReplayWriter::Close()
+    {
+        if (m_pFile != nullptr)
+        {
+            fclose(m_pFile);
+            m_pFile = nullptr;
+        }
+    }
+
+    bool ReplayWriter::Write(const ReplayRecord &record)
+    {
+        std::string data;
+        EncodeRecord(record, data);
+        return WriteEncoded(data);
+    }
+
+    bool ReplayWriter::WriteEncoded(const std::string &data)
+    {
+        if (m_pFile == nullptr)
+        {
+            return false;
+        }
+
+        if (fwrite(data.data(), 1, data.size(), m_pFile) != data.size())
+        {
+            LOG(ERROR) << "ReplayWriter::WriteEncoded() fwrite failed, size = " << data.size();
+            return false;
+        }
+        m_FileBytes += data.size();
+        return true;
+    }
+
+    bool ReplayReader::Open(const std::string &file_path)
+    {
+        Close();
+        m_Error = false;
+
+        m_pFile = fopen(file_path.c_str(), "rb");
+        if (m_pFile == nullptr)
+        {
+            LOG(ERROR) << "ReplayReader::Open() open failed, file_path = " << file_path;
+            return false;
+        }
+
+        char header[sizeof(s_Magic) + 1] = {0};
+        if (fread(header, 1, sizeof(header), m_pFile) != sizeof(header) ||
+            memcmp(header, s_Magic, sizeof(s_Magic)) != 0 ||
+            static_cast<uint8_t>(header[sizeof(s_Magic)]) != s_Version)
+        {
+            LOG(ERROR) << "ReplayReader::Open() header error, file_path = " << file_path;
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void ReplayReader::Close()
+    {
+        if (m_pFile != nullptr)
+        {
+            fclose(m_pFile);
+            m_pFile = nullptr;
+        }
+    }
+
+    bool ReplayReader::Next(ReplayRecord &record)
+    {
+        if (m_pFile == nullptr || m_Error)
+        {
+            return false;
+        }
+
+        int type = fgetc(m_pFile);
+        if (type == EOF)
+        {
+            return false;
+        }
+
+        bool succ = false;
+        record.type = static_cast<RecordType>(type);
+        record.cmd = 0;
+        record.key.clear();
+        record.field.clear();
+        record.value.clear();
+        switch (record.type)
+        {
+        case Record_Request:
+        {
+            uint64_t cmd = 0;
+            succ = ReadVarint(cmd) && ReadString(record.value);
+            record.cmd = static_cast<int>(cmd);
+            break;
+        }
+        case Record_RedisString:
+            succ = ReadString(record.key) && ReadString(record.value);
+            break;
+        case Record_RedisHash:
+            succ = ReadString(record.key) && ReadString(record.field) && ReadString(record.value);
+            break;
+        default:
+            LOG(ERROR) << "ReplayReader::Next() unknown record type = " << type;
+            break;
+        }
+
+        if (!succ)
+        {
+            m_Error = true;
+        }
+        return succ;
+    }
+
+    bool ReplayReader::ReadVarint(uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            int ch = fgetc(m_pFile);
+            if (ch == EOF)
+            {
+                LOG(ERROR) << "ReplayReader::ReadVarint() unexpected eof";
+                return false;
+            }
+            value |= static_cast<uint64_t>(ch & 0x7F) << shift;
+            if ((ch & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        LOG(ERROR) << "ReplayReader::ReadVarint() varint too long";
+        return false;
+    }
+
+    bool ReplayReader::ReadString(std::string &value)
+    {
+        uint64_t size = 0;
+        if (!ReadVarint(size))
+        {
+            return false;
+        }
+        if (size > s_MaxFieldBytes)
+        {
+            LOG(ERROR) << "ReplayReader::ReadString() field too large, size = " << size;
+            return false;
+        }
+
+        value.resize(size);
+        if (size > 0 && fread(&value[0], 1, size, m_pFile) != size)
+        {
+            LOG(ERROR) << "ReplayReader::ReadString() unexpected eof, size = " << size;
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <cstdint>
+
+// 回放文件: 记录线上请求与 Redis 数据, 供离线压测与问题复现
+// 格式: 文件头 "ACRP" + 版本号(1 字节), 之后为连续记录
+//       记录 = 类型(1 字节) + 字段, 整数为 varint, 字符串为 varint 长度 + 内容
+//       Record_Request     : cmd, request
+//       Record_RedisString : key, value
+//       Record_RedisHash   : key, field, value
+namespace Replay
+{
+    enum RecordType : uint8_t
+    {
+        Record_Request = 1,
+        Record_RedisString = 2,
+        Record_RedisHash = 3,
+    };
+
+    struct ReplayRecord
+    {
+        RecordType type = Record_Request;
+        int cmd = 0;
+        std::string key;
+        std::string field;
+        std::string value; // Record_Request 时为序列化后的请求
+    };
+
+    // 记录编码, 追加到 out
+    void EncodeRecord(const ReplayRecord &record, std::string &out);
+
+    // 顺序写
+    class ReplayWriter
+    {
+    public:
+        ReplayWriter() = default;
+        ~ReplayWriter() { Close(); }
+        ReplayWriter(const ReplayWriter &) = delete;
+        ReplayWriter &operator=(const ReplayWriter &) = delete;
+
+        // 新建文件并写入文件头
+        bool Open(const std::string &file_path);
+        void Close();
+
+        bool Write(const ReplayRecord &record);
+
+        // 写入已编码的记录
+        bool WriteEncoded(const std::string &data);
+
+        inline long GetFileBytes() const noexcept { return m_FileBytes; }
+
+    private:
+        FILE *m_pFile = nullptr;
+        long m_FileBytes = 0;
+    };
+
+    // 顺序读
+    class ReplayReader
+    {
+    public:
+        ReplayReader() = default;
+        ~ReplayReader() { Close(); }
+        ReplayReader(const ReplayReader &) = delete;
+        ReplayReader &operator=(const ReplayReader &) = delete;
+
+        // 打开文件并校验文件头
+        bool Open(const std::string &file_path);
+        void Close();
+
+        // 读取下一条记录, 文件结束或格式错误时返回 false, 通过 IsError() 区分
+        bool Next(ReplayRecord &record);
+
+        inline bool IsError() const noexcept { return m_Error; }
+
+    private:
+        bool ReadVarint(uint64_t &value);
+        bool ReadString(std::string &value);
+
+    private:
+        FILE *m_pFile = nullptr;
+        bool m_Error = false;
+    };
+}
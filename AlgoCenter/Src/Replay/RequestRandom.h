@@ -0,0 +1,36 @@
+#pragma once
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <functional>
+
+// 请求级随机数, 召回打乱、抽样与过滤打乱都从这里取随机数
+// 1. 线程局部引擎以 random_device 初始化, 线上请求沿用各线程的随机序列
+// 2. 录制或回放的请求在开始时以 uuid 设定种子, 同一请求在线上与回放中结果一致
+class RequestRandom
+{
+public:
+    // 回放模式, 所有请求按 uuid 设定种子, 由 AlgoCenterBench 在启动时开启
+    static inline void SetReplayMode(bool replay_mode) noexcept { s_ReplayMode.store(replay_mode, std::memory_order_relaxed); }
+
+    static inline bool IsReplayMode() noexcept { return s_ReplayMode.load(std::memory_order_relaxed); }
+
+    // uuid 为空时按时间设定种子
+    static inline void Seed(const std::string &uuid) noexcept
+    {
+        uint64_t seed = uuid.empty()
+                            ? static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+                            : static_cast<uint64_t>(std::hash<std::string>{}(uuid));
+        t_Engine.seed(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32)));
+    }
+
+    static inline std::mt19937 &Engine() noexcept { return t_Engine; }
+
+    static inline uint32_t Next() noexcept { return t_Engine(); }
+
+private:
+    static inline std::atomic<bool> s_ReplayMode{false};
+    static inline thread_local std::mt19937 t_Engine{std::random_device{}()};
+};
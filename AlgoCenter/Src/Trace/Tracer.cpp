@@ -0,0 +1,348 @@
+#include "Tracer.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <unistd.h>
+#include <sys/syscall.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "glog/logging.h"
+
+// 单次请求最大埋点数, 超出后丢弃
+static const std::size_t s_MaxSpanNum = 4096;
+
+// 待写入请求上限, 写文件跟不上时丢弃
+static const std::size_t s_MaxQueueNum = 1024;
+
+thread_local bool Tracer::t_Active = false;
+thread_local Tracer::TraceData Tracer::t_TraceData;
+
+static uint64_t SteadyNs() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+static void AppendJsonString(const std::string &str, std::string &out)
+{
+    out.push_back('"');
+    for (char ch : str)
+    {
+        switch (ch)
+        {
+        case '"':
+            out.append("\\\"");
+            break;
+        case '\\':
+            out.append("\\\\");
+            break;
+        case '\n':
+            out.append("\\n");
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                out.append(buf);
+            }
+            else
+            {
+                out.push_back(ch);
+            }
+            break;
+        }
+    }
+    out.push_back('"');
+}
+
+bool Tracer::Init(const std::string &file_path, int max_file_mb, int max_file_num)
+{
+    if (g_Init)
+    {
+        return true;
+    }
+
+    if (file_path.empty() || max_file_mb <= 0 || max_file_num < 0)
+    {
+        LOG(ERROR) << "Tracer::Init() params error"
+                   << ", file_path = " << file_path
+                   << ", max_file_mb = " << max_file_mb
+                   << ", max_file_num = " << max_file_num;
+        return false;
+    }
+
+    m_FilePath = file_path;
+    m_MaxFileBytes = max_file_mb * 1024L * 1024L;
+    m_MaxFileNum = max_file_num;
+    m_Pid = getpid();
+
+    std::error_code ec;
+    auto parent_path = std::filesystem::path(m_FilePath).parent_path();
+    if (!parent_path.empty() && !std::filesystem::exists(parent_path, ec))
+    {
+        std::filesystem::create_directories(parent_path, ec);
+        if (ec)
+        {
+            LOG(ERROR) << "Tracer::Init() create directory failed"
+                       << ", path = " << parent_path
+                       << ", err = " << ec.message();
+            return false;
+        }
+    }
+
+    // 上次运行留下的文件滚动保留
+    RotateFile();
+    if (m_pFile == nullptr)
+    {
+        return false;
+    }
+
+    Calibrate();
+
+    g_Init = true;
+    g_WorkThreadPtr = std::thread(&Tracer::WriteThread, this);
+
+    LOG(INFO) << "Tracer::Init() succ"
+              << ", file_path = " << file_path
+              << ", max_file_mb = " << max_file_mb
+              << ", max_file_num = " << max_file_num
+              << ", ns_per_tick = " << m_NsPerTick;
+    return true;
+}
+
+void Tracer::ShutDown()
+{
+    if (!g_Init)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(m_Mutex);
+        g_Init = false;
+    }
+    m_Cond.notify_all();
+
+    if (g_WorkThreadPtr.joinable())
+    {
+        g_WorkThreadPtr.join();
+    }
+
+    if (m_pFile != nullptr)
+    {
+        fclose(m_pFile);
+        m_pFile = nullptr;
+    }
+
+    LOG(INFO) << "Tracer::ShutDown()"
+              << ", trace = " << GetTraceCount()
+              << ", drop = " << GetDropCount();
+}
+
+void Tracer::Begin(const std::string &uuid)
+{
+    if (!g_Init || t_Active)
+    {
+        return;
+    }
+
+    static thread_local long tid = syscall(SYS_gettid);
+
+    t_Active = true;
+    t_TraceData.uuid = uuid;
+    t_TraceData.tid = tid;
+    t_TraceData.vecSpan.clear();
+    t_TraceData.vecSpan.reserve(256);
+}
+
+void Tracer::End()
+{
+    if (!t_Active)
+    {
+        return;
+    }
+    t_Active = false;
+
+    {
+        std::lock_guard<std::mutex> lg(m_Mutex);
+        if (!g_Init || m_Queue.size() >= s_MaxQueueNum)
+        {
+            m_DropCount.fetch_add(1, std::memory_order_relaxed);
+            t_TraceData.vecSpan.clear();
+            return;
+        }
+        m_Queue.emplace_back(std::move(t_TraceData));
+    }
+    m_Cond.notify_one();
+
+    m_TraceCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Tracer::AddSpan(const char *name, std::string &&arg, uint64_t start_tick, uint64_t end_tick)
+{
+    if (!t_Active || t_TraceData.vecSpan.size() >= s_MaxSpanNum)
+    {
+        return;
+    }
+
+    auto &span = t_TraceData.vecSpan.emplace_back();
+    span.name = name;
+    span.arg = std::move(arg);
+    span.start_tick = start_tick;
+    span.end_tick = end_tick;
+}
+
+uint64_t Tracer::NowTick() noexcept
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return SteadyNs();
+#endif
+}
+
+void Tracer::Calibrate()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t start_ns = SteadyNs();
+    uint64_t start_tick = NowTick();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    uint64_t end_ns = SteadyNs();
+    uint64_t end_tick = NowTick();
+
+    m_BaseNs = start_ns;
+    m_BaseTick = start_tick;
+    m_NsPerTick = (end_tick > start_tick)
+                      ? static_cast<double>(end_ns - start_ns) / (end_tick - start_tick)
+                      : 1.0;
+#else
+    m_BaseNs = 0;
+    m_BaseTick = 0;
+    m_NsPerTick = 1.0;
+#endif
+}
+
+void Tracer::WriteThread()
+{
+    std::deque<TraceData> localQueue;
+    std::string buffer;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> ul(m_Mutex);
+            m_Cond.wait(ul, [this]()
+                        { return !g_Init || !m_Queue.empty(); });
+            if (m_Queue.empty())
+            {
+                break; // 已停止且队列写完
+            }
+            localQueue.swap(m_Queue);
+        }
+
+        // 按请求写入, 滚动时同一请求不会跨文件
+        for (const auto &traceData : localQueue)
+        {
+            buffer.clear();
+            EncodeTrace(traceData, buffer);
+            WriteFile(buffer);
+        }
+        localQueue.clear();
+
+        if (m_pFile != nullptr)
+        {
+            fflush(m_pFile);
+        }
+    }
+}
+
+// JSON Array 格式, 每个事件一行并以逗号结尾, 未闭合的数组可被 Chrome 直接加载
+void Tracer::EncodeTrace(const TraceData &traceData, std::string &out) const
+{
+    char buf[128];
+    for (const auto &span : traceData.vecSpan)
+    {
+        uint64_t start_ns = TickToNs(span.start_tick);
+        uint64_t end_ns = TickToNs(span.end_tick);
+        uint64_t dur_ns = (end_ns > start_ns) ? end_ns - start_ns : 0;
+
+        out.append("{\"name\":");
+        AppendJsonString(span.name, out);
+        snprintf(buf, sizeof(buf),
+                 ",\"cat\":\"algocenter\",\"ph\":\"X\",\"pid\":%d,\"tid\":%ld,\"ts\":%lu.%03lu,\"dur\":%lu.%03lu",
+                 m_Pid, traceData.tid,
+                 (unsigned long)(start_ns / 1000), (unsigned long)(start_ns % 1000),
+                 (unsigned long)(dur_ns / 1000), (unsigned long)(dur_ns % 1000));
+        out.append(buf);
+        out.append(",\"args\":{\"uuid\":");
+        AppendJsonString(traceData.uuid, out);
+        if (!span.arg.empty())
+        {
+            out.append(",\"arg\":");
+            AppendJsonString(span.arg, out);
+        }
+        out.append("}},\n");
+    }
+}
+
+void Tracer::WriteFile(const std::string &data)
+{
+    if (m_pFile == nullptr || data.empty())
+    {
+        return;
+    }
+
+    if (m_FileBytes + (long)data.size() > m_MaxFileBytes)
+    {
+        RotateFile();
+        if (m_pFile == nullptr)
+        {
+            return;
+        }
+    }
+
+    fwrite(data.data(), 1, data.size(), m_pFile);
+    m_FileBytes += data.size();
+}
+
+bool Tracer::OpenFile()
+{
+    m_pFile = fopen(m_FilePath.c_str(), "w");
+    if (m_pFile == nullptr)
+    {
+        LOG(ERROR) << "Tracer::OpenFile() open failed, file_path = " << m_FilePath;
+        return false;
+    }
+
+    fputs("[\n", m_pFile);
+    m_FileBytes = 2;
+    return true;
+}
+
+// file -> file.1 -> file.2 ... 超出 m_MaxFileNum 的最旧文件被覆盖
+void Tracer::RotateFile()
+{
+    if (m_pFile != nullptr)
+    {
+        fclose(m_pFile);
+        m_pFile = nullptr;
+    }
+
+    std::error_code ec;
+    if (m_MaxFileNum > 0 && std::filesystem::exists(m_FilePath, ec))
+    {
+        for (int idx = m_MaxFileNum - 1; idx > 0; idx--)
+        {
+            std::string from = m_FilePath + "." + std::to_string(idx);
+            if (std::filesystem::exists(from, ec))
+            {
+                std::filesystem::rename(from, m_FilePath + "." + std::to_string(idx + 1), ec);
+            }
+        }
+        std::filesystem::rename(m_FilePath, m_FilePath + ".1", ec);
+    }
+
+    OpenFile();
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <condition_variable>
+#include "Common/Singleton.h"
+
+// 请求链路追踪
+// 1. 采样请求在请求线程上开启追踪, 埋点写入线程局部缓冲, 未采样时埋点只有一次判断
+// 2. 时间戳使用 TSC 计数, 初始化时按 steady_clock 校准为纳秒
+// 3. 请求结束后整条链路交给后台线程, 以 Chrome trace-event JSON 写入本地滚动文件
+//    可直接用 chrome://tracing 或 Perfetto 打开
+class Tracer : public Singleton<Tracer>
+{
+public:
+    // 单个埋点, name 必须是字符串字面量
+    struct SpanEvent
+    {
+        const char *name = nullptr;
+        std::string arg;
+        uint64_t start_tick = 0;
+        uint64_t end_tick = 0;
+    };
+
+    // 一次请求的全部埋点
+    struct TraceData
+    {
+        std::string uuid;
+        long tid = 0;
+        std::vector<SpanEvent> vecSpan;
+    };
+
+public:
+    // 初始化
+    // [in] file_path 追踪文件路径, 滚动文件追加 .1 .2 ... 后缀
+    // [in] max_file_mb 单个文件大小上限(MB)
+    // [in] max_file_num 保留的滚动文件个数
+    bool Init(const std::string &file_path, int max_file_mb, int max_file_num);
+
+    void ShutDown();
+
+    inline bool IsInit() const noexcept { return g_Init.load(); }
+
+    // 当前线程开启追踪, 未初始化时忽略
+    void Begin(const std::string &uuid);
+
+    // 当前线程结束追踪, 提交给后台线程写文件
+    void End();
+
+    // 当前线程是否在追踪中
+    static inline bool IsActive() noexcept { return t_Active; }
+
+    // 记录埋点
+    static void AddSpan(const char *name, std::string &&arg, uint64_t start_tick, uint64_t end_tick);
+
+    // 当前 TSC 计数
+    static uint64_t NowTick() noexcept;
+
+    inline long GetTraceCount() const noexcept { return m_TraceCount.load(std::memory_order_relaxed); }
+    inline long GetDropCount() const noexcept { return m_DropCount.load(std::memory_order_relaxed); }
+
+private:
+    // 校准 TSC 频率
+    void Calibrate();
+
+    // 计数转换为纳秒
+    inline uint64_t TickToNs(uint64_t tick) const noexcept
+    {
+        return static_cast<uint64_t>(static_cast<int64_t>(tick - m_BaseTick) * m_NsPerTick + m_BaseNs);
+    }
+
+    // 后台写文件线程
+    void WriteThread();
+
+    // 将一次请求编码为 trace-event 追加到 out
+    void EncodeTrace(const TraceData &traceData, std::string &out) const;
+
+    // 写入文件, 超出大小时滚动
+    void WriteFile(const std::string &data);
+    bool OpenFile();
+    void RotateFile();
+
+private:
+    static thread_local bool t_Active;
+    static thread_local TraceData t_TraceData;
+
+    std::atomic<bool> g_Init = false;
+    std::string m_FilePath;
+    long m_MaxFileBytes = 0;
+    int m_MaxFileNum = 0;
+
+    // TSC 校准: ns = (tick - m_BaseTick) * m_NsPerTick + m_BaseNs
+    uint64_t m_BaseTick = 0;
+    uint64_t m_BaseNs = 0;
+    double m_NsPerTick = 1.0;
+    int m_Pid = 0;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+    std::deque<TraceData> m_Queue;
+    std::thread g_WorkThreadPtr;
+
+    FILE *m_pFile = nullptr;
+    long m_FileBytes = 0;
+
+    std::atomic<long> m_TraceCount = 0;
+    std::atomic<long> m_DropCount = 0;
+
+public:
+    Tracer(token) {}
+    ~Tracer() { ShutDown(); }
+    Tracer(Tracer &) = delete;
+    Tracer &operator=(const Tracer &) = delete;
+};
+
+// 埋点守卫, 构造时记录开始, 析构或 End() 时记录结束
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name) noexcept
+        : m_Name(name), m_Active(Tracer::IsActive())
+    {
+        if (m_Active)
+        {
+            m_StartTick = Tracer::NowTick();
+        }
+    }
+
+    TraceSpan(const char *name, const std::string &arg)
+        : m_Name(name), m_Active(Tracer::IsActive())
+    {
+        if (m_Active)
+        {
+            m_Arg = arg;
+            m_StartTick = Tracer::NowTick();
+        }
+    }
+
+    TraceSpan(const char *name, long arg)
+        : m_Name(name), m_Active(Tracer::IsActive())
+    {
+        if (m_Active)
+        {
+            m_Arg = std::to_string(arg);
+            m_StartTick = Tracer::NowTick();
+        }
+    }
+
+    ~TraceSpan() { End(); }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    inline void End()
+    {
+        if (m_Active)
+        {
+            m_Active = false;
+            Tracer::AddSpan(m_Name, std::move(m_Arg), m_StartTick, Tracer::NowTick());
+        }
+    }
+
+private:
+    const char *m_Name = nullptr;
+    bool m_Active = false;
+    uint64_t m_StartTick = 0;
+    std::string m_Arg;
+};
+
+// 请求追踪守卫, sampled 为 true 时在当前线程开启追踪, 析构时提交
+class TraceScope
+{
+public:
+    TraceScope(bool sampled, const std::string &uuid)
+    {
+        auto tracer = Tracer::GetInstance();
+        if (sampled && tracer->IsInit() && !Tracer::IsActive())
+        {
+            tracer->Begin(uuid);
+            m_Hold = true;
+        }
+    }
+
+    ~TraceScope()
+    {
+        if (m_Hold)
+        {
+            Tracer::GetInstance()->End();
+        }
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    bool m_Hold = false;
+};
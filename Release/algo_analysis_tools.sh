@@ -64,7 +64,8 @@ for pm in "$@"; do
         echo "Long options:"
         echo "    --log_dt=YYYYMMDD_HH      使用指定日期时，默认当前日期时，例子：--log_dt=20230605_20"
         echo "    --top_n                   设置 top n，默认top 3，例子：--top_n=10"
-        echo "    --recall_type             召回漏斗分析，例子：--recall_type=ResType_User_CF"
+        echo "    --recall_type             召回漏斗分析，依赖 AppConf Statis.LegacyLog(默认开启)，例子：--recall_type=ResType_User_CF"
+        echo "                              未开启时可查询聚合结果：curl http://127.0.0.1:9464/statis"
         echo "    --exp_id                  内部实验id，例子：--exp_id=10"
         echo "    --api_type                指定api类型，例子：--api_type=908001"
         echo "    --user_id                     指定用户user_id，例子：--user_id=177321497"